@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2017 Light's Hope <https://lightshope.org>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_BENCHMARKS_H
+#define MANGOS_BENCHMARKS_H
+
+#include "Common.h"
+#include <chrono>
+
+/*
+ * Benchmarks comparing the server containers with the ones they replaced.
+ * They used to be .debug commands, but a benchmark run in mangosd stalls the
+ * world thread for the whole realm: they are built in their own executable.
+ *
+ * Every benchmark gets the arguments following its name, and returns the
+ * process exit code.
+ */
+typedef int (*BenchmarkMain)(int argc, char** argv);
+
+int EventProcessorBenchmark(int argc, char** argv);
+int ObjectLookupBenchmark(int argc, char** argv);
+int ThreatStreamBenchmark(int argc, char** argv);
+
+// Reads argv[index] in 'value' when present. Returns false if it is not a number in [minValue, maxValue].
+bool ReadBenchmarkArgument(int argc, char** argv, int index, uint32 minValue, uint32 maxValue, uint32& value);
+
+inline uint64 ElapsedMicroseconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+#endif
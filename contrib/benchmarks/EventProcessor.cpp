@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2017 Light's Hope <https://lightshope.org>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Benchmarks.h"
+#include "Utilities/EventProcessor.h"
+#include <cstdio>
+#include <map>
+
+// Former EventProcessor storage: one multimap node per scheduled event
+class MultimapEventProcessor
+{
+    public:
+        MultimapEventProcessor() : m_time(0) {}
+
+        void AddEvent(BasicEvent* event, uint64 e_time) { m_events.insert(std::pair<uint64, BasicEvent*>(e_time, event)); }
+        uint64 CalculateTime(uint64 t_offset) const { return m_time + t_offset; }
+        bool HasScheduledEvent() const { return !m_events.empty(); }
+
+        void Update(uint32 p_time)
+        {
+            m_time += p_time;
+            std::multimap<uint64, BasicEvent*>::iterator i;
+            while ((i = m_events.begin()) != m_events.end() && i->first <= m_time)
+            {
+                BasicEvent* event = i->second;
+                m_events.erase(i);
+                if (event->Execute(m_time, p_time))
+                    delete event;
+            }
+        }
+
+    private:
+        uint64 m_time;
+        std::multimap<uint64, BasicEvent*> m_events;
+};
+
+class BenchmarkEvent : public BasicEvent
+{
+    public:
+        explicit BenchmarkEvent(uint32& executed) : m_executed(executed) {}
+        bool Execute(uint64 /*e_time*/, uint32 /*p_time*/) override { ++m_executed; return true; }
+
+    private:
+        uint32& m_executed;
+};
+
+// Schedules 'timers' events over the next minute, then updates every 50ms until they all expired.
+// Returns the time spent in AddEvent and Update, in us.
+template <class Processor>
+static void BenchmarkEventProcessor(uint32 timers, uint64& addTime, uint64& updateTime, uint32& executed)
+{
+    Processor processor;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32 i = 0; i < timers; ++i)
+        processor.AddEvent(new BenchmarkEvent(executed), processor.CalculateTime((i * 7919) % 60000));
+    addTime = ElapsedMicroseconds(start);
+
+    start = std::chrono::steady_clock::now();
+    while (processor.HasScheduledEvent())
+        processor.Update(50);
+    updateTime = ElapsedMicroseconds(start);
+}
+
+// Compares the timing wheel EventProcessor with the former multimap storage
+int EventProcessorBenchmark(int argc, char** argv)
+{
+    uint32 timers = 100000;
+    if (!ReadBenchmarkArgument(argc, argv, 0, 1, 10000000, timers))
+    {
+        printf("timers must be in [1, 10000000]\n");
+        return 1;
+    }
+
+    uint64 addTime, updateTime;
+    uint32 executed = 0;
+    BenchmarkEventProcessor<MultimapEventProcessor>(timers, addTime, updateTime, executed);
+    printf("%u timers over 60s, 50ms updates:\n", timers);
+    printf("Multimap     : add " UI64FMTD " us, update " UI64FMTD " us\n", addTime, updateTime);
+    BenchmarkEventProcessor<EventProcessor>(timers, addTime, updateTime, executed);
+    printf("Timing wheel : add " UI64FMTD " us, update " UI64FMTD " us\n", addTime, updateTime);
+    if (executed != 2 * timers)
+    {
+        printf("Execution mismatch: %u executed\n", executed);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2017 Light's Hope <https://lightshope.org>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Benchmarks.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+struct BenchmarkEntry
+{
+    char const* name;
+    char const* usage;
+    BenchmarkMain run;
+};
+
+static BenchmarkEntry const benchmarks[] =
+{
+    { "eventprocessor", "[timers]",            &EventProcessorBenchmark },
+    { "objectlookup",   "[threads] [lookups]", &ObjectLookupBenchmark },
+    { "threatstream",   "[events]",            &ThreatStreamBenchmark },
+};
+
+bool ReadBenchmarkArgument(int argc, char** argv, int index, uint32 minValue, uint32 maxValue, uint32& value)
+{
+    if (index >= argc)
+        return true;
+
+    char* end;
+    unsigned long arg = strtoul(argv[index], &end, 10);
+    if (*end || end == argv[index] || arg < minValue || arg > maxValue)
+        return false;
+
+    value = uint32(arg);
+    return true;
+}
+
+static void Usage(char const* prog)
+{
+    printf("Usage: %s <benchmark> [arguments]\n", prog);
+    for (BenchmarkEntry const& benchmark : benchmarks)
+        printf("    %s %s\n", benchmark.name, benchmark.usage);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        Usage(argv[0]);
+        return 1;
+    }
+
+    for (BenchmarkEntry const& benchmark : benchmarks)
+        if (!strcmp(argv[1], benchmark.name))
+            return benchmark.run(argc - 2, argv + 2);
+
+    Usage(argv[0]);
+    return 1;
+}
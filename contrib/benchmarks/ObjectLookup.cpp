@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2017 Light's Hope <https://lightshope.org>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Benchmarks.h"
+#include "ShardedObjectMap.h"
+#include <ace/RW_Thread_Mutex.h>
+#include <ace/Guard_T.h>
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+// Former HashMapHolder layout: a single reader/writer lock over the whole container
+class LockedObjectLookupMap
+{
+    public:
+        void Insert(uint64 guid, uint32* obj)
+        {
+            ACE_Write_Guard<ACE_RW_Thread_Mutex> guard(m_lock);
+            m_objects[guid] = obj;
+        }
+
+        uint32* Find(uint64 guid) const
+        {
+            ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(m_lock);
+            UNORDERED_MAP<uint64, uint32*>::const_iterator itr = m_objects.find(guid);
+            return itr != m_objects.end() ? itr->second : nullptr;
+        }
+
+    private:
+        mutable ACE_RW_Thread_Mutex m_lock;
+        UNORDERED_MAP<uint64, uint32*> m_objects;
+};
+
+// Every thread looks up 'lookups' guids spread over the registered ones, returns the wall time in us
+template <class MapType>
+static uint64 BenchmarkObjectLookup(MapType const& map, uint32 objects, uint32 threads, uint32 lookups, uint64& found)
+{
+    std::atomic<uint64> hits(0);
+    std::vector<std::thread> workers;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32 t = 0; t < threads; ++t)
+        workers.emplace_back([&map, &hits, objects, lookups, t]()
+        {
+            uint64 threadHits = 0;
+            for (uint32 i = 0; i < lookups; ++i)
+                if (map.Find((i * 7919 + t * 104729) % objects + 1))
+                    ++threadHits;
+            hits += threadHits;
+        });
+    for (std::thread& worker : workers)
+        worker.join();
+    found += hits;
+    return ElapsedMicroseconds(start);
+}
+
+// Compares guid lookups from concurrent threads in a single lock map and in the sharded object registry
+int ObjectLookupBenchmark(int argc, char** argv)
+{
+    uint32 threads = 4;
+    uint32 lookups = 1000000;
+    if (!ReadBenchmarkArgument(argc, argv, 0, 1, 256, threads) ||
+            !ReadBenchmarkArgument(argc, argv, 1, 1, 100000000, lookups))
+    {
+        printf("threads must be in [1, 256], lookups in [1, 100000000]\n");
+        return 1;
+    }
+
+    uint32 const objects = 5000;
+    std::vector<uint32> values(objects);
+    LockedObjectLookupMap locked;
+    ShardedObjectMap<uint64, uint32> sharded;
+    for (uint32 i = 0; i < objects; ++i)
+    {
+        locked.Insert(i + 1, &values[i]);
+        sharded.Insert(i + 1, &values[i]);
+    }
+
+    uint64 found = 0;
+    uint64 lockedTime = BenchmarkObjectLookup(locked, objects, threads, lookups, found);
+    uint64 shardedTime = BenchmarkObjectLookup(sharded, objects, threads, lookups, found);
+    uint64 total = uint64(threads) * lookups;
+
+    printf("%u objects, %u threads x %u lookups:\n", objects, threads, lookups);
+    printf("Single lock : " UI64FMTD " us, %.1f M lookups/s\n", lockedTime, lockedTime ? double(total) / lockedTime : 0.0);
+    printf("Sharded     : " UI64FMTD " us, %.1f M lookups/s\n", shardedTime, shardedTime ? double(total) / shardedTime : 0.0);
+    if (found != 2 * total)
+    {
+        printf("Lookup mismatch: " UI64FMTD " found\n", found);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2017 Light's Hope <https://lightshope.org>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Benchmarks.h"
+#include <cstdio>
+#include <list>
+#include <set>
+#include <vector>
+
+struct ThreatStreamRef;
+
+struct ThreatStreamOrder
+{
+    bool operator()(ThreatStreamRef const* lhs, ThreatStreamRef const* rhs) const;
+};
+
+typedef std::multiset<ThreatStreamRef*, ThreatStreamOrder> ThreatStreamIndex;
+
+struct ThreatStreamRef
+{
+    uint64 guid;
+    float threat;
+    float sortedThreat;
+    bool pending;
+    std::list<ThreatStreamRef*>::iterator listPosition;
+    ThreatStreamIndex::iterator indexPosition;
+};
+
+bool ThreatStreamOrder::operator()(ThreatStreamRef const* lhs, ThreatStreamRef const* rhs) const
+{
+    return lhs->sortedThreat > rhs->sortedThreat;
+}
+
+// Former ThreatContainer: linear lookup, whole list sorted at update when the order might have changed
+class SortedListThreatStream
+{
+    public:
+        SortedListThreatStream() : m_dirty(false) {}
+
+        void Add(ThreatStreamRef* ref) { m_refs.push_back(ref); }
+        void AddThreat(uint64 guid, float threat)
+        {
+            for (std::list<ThreatStreamRef*>::iterator itr = m_refs.begin(); itr != m_refs.end(); ++itr)
+            {
+                if ((*itr)->guid != guid)
+                    continue;
+                (*itr)->threat += threat;
+                if ((m_refs.front() == *itr) != (threat > 0.0f))
+                    m_dirty = true;
+                return;
+            }
+        }
+        ThreatStreamRef* Update()
+        {
+            if (m_dirty)
+                m_refs.sort([](ThreatStreamRef const* lhs, ThreatStreamRef const* rhs) { return lhs->threat > rhs->threat; });
+            m_dirty = false;
+            return m_refs.front();
+        }
+
+    private:
+        std::list<ThreatStreamRef*> m_refs;
+        bool m_dirty;
+};
+
+// Same storage as ThreatContainer: lookup by guid, changed references moved through the threat index at update
+class IndexedThreatStream
+{
+    public:
+        void Add(ThreatStreamRef* ref)
+        {
+            ref->sortedThreat = ref->threat;
+            ref->pending = false;
+            m_byGuid[ref->guid] = ref;
+            Place(ref, true);
+        }
+        void AddThreat(uint64 guid, float threat)
+        {
+            UNORDERED_MAP<uint64, ThreatStreamRef*>::const_iterator itr = m_byGuid.find(guid);
+            if (itr == m_byGuid.end())
+                return;
+            itr->second->threat += threat;
+            if (!itr->second->pending)
+            {
+                itr->second->pending = true;
+                m_queue.push_back(itr->second);
+            }
+        }
+        ThreatStreamRef* Update()
+        {
+            for (ThreatStreamRef* ref : m_queue)
+            {
+                ref->pending = false;
+                if (ref->sortedThreat == ref->threat)
+                    continue;
+                m_index.erase(ref->indexPosition);
+                ref->sortedThreat = ref->threat;
+                Place(ref, false);
+            }
+            m_queue.clear();
+            return m_list.front();
+        }
+
+    private:
+        void Place(ThreatStreamRef* ref, bool newNode)
+        {
+            ref->indexPosition = m_index.insert(ref);
+            ThreatStreamIndex::iterator position = ref->indexPosition;
+            ++position;
+            std::list<ThreatStreamRef*>::iterator next = position == m_index.end() ? m_list.end() : (*position)->listPosition;
+            if (newNode)
+                ref->listPosition = m_list.insert(next, ref);
+            else if (next != ref->listPosition)
+                m_list.splice(next, m_list, ref->listPosition);
+        }
+
+        std::list<ThreatStreamRef*> m_list;
+        ThreatStreamIndex m_index;
+        UNORDERED_MAP<uint64, ThreatStreamRef*> m_byGuid;
+        std::vector<ThreatStreamRef*> m_queue;
+};
+
+// Replays a raid threat stream on a boss: 40 players and 10 pets, the tank generating most of the threat,
+// healers threat spread on everyone, and a threat check every 'eventsPerUpdate' events.
+// Returns the time spent in us, and a checksum of the selected victims threat.
+template <class Container>
+static uint64 BenchmarkThreatStream(uint32 events, uint32 eventsPerUpdate, uint64& checksum)
+{
+    uint32 const attackers = 50;
+    std::vector<ThreatStreamRef> refs(attackers);
+    Container container;
+    for (uint32 i = 0; i < attackers; ++i)
+    {
+        refs[i].guid = i + 1;
+        refs[i].threat = 0.0f;
+        container.Add(&refs[i]);
+    }
+
+    checksum = 0;
+    uint32 seed = 1;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32 i = 0; i < events; ++i)
+    {
+        seed = seed * 1103515245 + 12345;
+        uint32 roll = (seed >> 8) % 1000;
+        uint32 target = roll < 300 ? 0 : roll % attackers;
+        float threat = roll < 300 ? 800.0f : float(roll % 400);
+        if (roll == 999)
+            threat = -0.5f * refs[target].threat;       // threat drop ability
+        container.AddThreat(refs[target].guid, threat);
+        if ((i + 1) % eventsPerUpdate == 0)
+            checksum = checksum * 31 + uint64(container.Update()->threat);
+    }
+    return ElapsedMicroseconds(start);
+}
+
+// Compares the indexed threat container storage with the former sorted list
+int ThreatStreamBenchmark(int argc, char** argv)
+{
+    uint32 events = 1000000;
+    if (!ReadBenchmarkArgument(argc, argv, 0, 1, 100000000, events))
+    {
+        printf("events must be in [1, 100000000]\n");
+        return 1;
+    }
+
+    uint32 const eventsPerUpdate = 20;
+    uint64 listChecksum, indexChecksum;
+    uint64 listTime = BenchmarkThreatStream<SortedListThreatStream>(events, eventsPerUpdate, listChecksum);
+    uint64 indexTime = BenchmarkThreatStream<IndexedThreatStream>(events, eventsPerUpdate, indexChecksum);
+    printf("%u threat events on 50 attackers, victim selected every %u events:\n", events, eventsPerUpdate);
+    printf("Sorted list : " UI64FMTD " us\n", listTime);
+    printf("Indexed     : " UI64FMTD " us\n", indexTime);
+    if (listChecksum != indexChecksum)
+    {
+        printf("Victim selection differs\n");
+        return 1;
+    }
+    return 0;
+}
@@ -19,9 +19,11 @@
 #endif /* ACE_LACKS_PRAGMA_ONCE */
 
 #include "Common.h"
+#include "WorldPacket.h"
+#include <deque>
+#include <vector>
 
 class ACE_Message_Block;
-class WorldPacket;
 class WorldSession;
 
 
@@ -104,8 +106,27 @@ class MangosSocket : protected WorldHandler
         typedef ACE_Thread_Mutex LockType;
         typedef ACE_Guard<LockType> GuardType;
 
-        /// Queue for storing packets for which there is no space.
-        typedef ACE_Unbounded_Queue<WorldPacket*> PacketQueueT;
+        /// Data sent after m_OutBuffer: a shared packet (sent from its own
+        /// buffer), then the bytes written behind it.
+        struct QueuedData
+        {
+            QueuedData() : sent(0) {}
+            explicit QueuedData(const SharedWorldPacket& pct) : packet(pct), sent(0) {}
+
+            SharedWorldPacket packet;
+            std::vector<char> bytes;
+            size_t sent;                                    // of the packet data, then of bytes
+        };
+
+        /// Queue of the data for which there is no space, or that is shared.
+        typedef std::deque<QueuedData> PacketQueueT;
+
+        /// Broadcasts at least this big are queued by reference on every socket,
+        /// smaller ones are cheaper to copy.
+        static const size_t SharedPacketMinSize = 512;
+
+        /// Max number of buffers given to a single send call.
+        static const int MaxSendBuffers = 64;
 
         /// Check if socket is closed.
         bool IsClosed() const { return closing_; }
@@ -118,8 +139,12 @@ class MangosSocket : protected WorldHandler
 
         /// Send A packet on the socket, this function is reentrant.
         /// @param pct packet to send
+        /// @param shared for a packet sent to many sockets: a big packet is
+        /// copied once in it (on first need), then queued by reference on every
+        /// socket instead of copied in each output buffer. Pass the same one
+        /// for every socket receiving the packet.
         /// @return -1 of failure
-        int SendPacket (const WorldPacket& pct);
+        int SendPacket (const WorldPacket& pct, SharedWorldPacket* shared = nullptr);
 
         /// Add reference to this object.
         long AddReference() { return static_cast<long>(add_reference()); }
@@ -172,15 +197,18 @@ class MangosSocket : protected WorldHandler
         int cancel_wakeup_output (GuardType& g);
         int schedule_wakeup_output (GuardType& g);
 
-        /// Try to write WorldPacket to m_OutBuffer ,return -1 if no space
+        /// Build, encrypt and write the header of the packet
+        /// Need to be called with m_OutBufferLock lock held
+        void iSendHeader (const WorldPacket& pct);
+
+        /// Write data after the pending output: in m_OutBuffer while
+        /// nothing is queued, in m_PacketQueue otherwise
         /// Need to be called with m_OutBufferLock lock held
-        int iSendPacket (const WorldPacket& pct);
+        void iWrite (const char* data, size_t size);
 
-        /// Flush m_PacketQueue if there are packets in it
+        /// Forget the first bytes of the pending output, once sent
         /// Need to be called with m_OutBufferLock lock held
-        /// @return true if it wrote to the buffer ( AKA you need
-        /// to mark the socket for output ).
-        bool iFlushPacketQueue ();
+        void iConsumeOutput (size_t size);
 
         /// Time in which the last ping was received
         ACE_Time_Value m_LastPingTime;
@@ -222,6 +250,7 @@ class MangosSocket : protected WorldHandler
 
         /// Here are stored packets for which there was no space on m_OutBuffer,
         /// this allows not-to kick player if its buffer is overflowed.
+        /// Shared packets are also sent from here, after their header.
         PacketQueueT m_PacketQueue;
 
         /// True if the socket is registered with the reactor for output
@@ -1,6 +1,8 @@
 #include <ace/Message_Block.h>
 #include <ace/OS_NS_string.h>
 #include <ace/OS_NS_unistd.h>
+#include <ace/OS_NS_sys_socket.h>
+#include <ace/os_include/sys/os_uio.h>
 #include <ace/os_include/arpa/os_inet.h>
 #include <ace/os_include/netinet/os_tcp.h>
 #include <ace/os_include/sys/os_types.h>
@@ -54,9 +56,7 @@ MangosSocket<SessionType, SocketName, Crypt>::~MangosSocket(void)
 
     peer().close();
 
-    WorldPacket* pct;
-    while (m_PacketQueue.dequeue_head(pct) == 0)
-        delete pct;
+    m_PacketQueue.clear();
 }
 
 template <typename SessionType, typename SocketName, typename Crypt>
@@ -80,28 +80,26 @@ void MangosSocket<SessionType, SocketName, Crypt>::CloseSocket(void)
 }
 
 template <typename SessionType, typename SocketName, typename Crypt>
-int MangosSocket<SessionType, SocketName, Crypt>::SendPacket(const WorldPacket& pct)
+int MangosSocket<SessionType, SocketName, Crypt>::SendPacket(const WorldPacket& pct, SharedWorldPacket* shared)
 {
     ACE_GUARD_RETURN(LockType, Guard, m_OutBufferLock, -1);
 
     if (closing_)
         return -1;
 
-    if (((SocketName*)this)->iSendPacket(pct) == -1)
-    {
-        WorldPacket* npct;
-
-        ACE_NEW_RETURN(npct, WorldPacket(pct), -1);
+    // The header is encrypted here, so everything is sent in the order it is written
+    ((SocketName*)this)->iSendHeader(pct);
 
-        // NOTE maybe check of the size of the queue can be good ?
-        // to make it bounded instead of unbounded
-        if (m_PacketQueue.enqueue_tail(npct) == -1)
-        {
-            delete npct;
-            sLog.outError("MangosSocket<SessionType, SocketName, Crypt>::SendPacket: m_PacketQueue.enqueue_tail failed");
-            return -1;
-        }
+    // NOTE maybe check of the size of the queue can be good ?
+    // to make it bounded instead of unbounded
+    if (shared && pct.size() >= SharedPacketMinSize)
+    {
+        if (!*shared)
+            *shared = std::make_shared<WorldPacket const>(pct);
+        m_PacketQueue.push_back(QueuedData(*shared));
     }
+    else if (!pct.empty())
+        iWrite((const char*) pct.contents(), pct.size());
 
     return 0;
 }
@@ -210,15 +208,53 @@ int MangosSocket<SessionType, SocketName, Crypt>::handle_output(ACE_HANDLE)
     if (closing_)
         return -1;
 
-    const size_t send_len = m_OutBuffer->length();
+    // Gather the output buffer and the queued data, shared packets are sent from their own buffer
+    iovec iov[MaxSendBuffers];
+    int iovcnt = 0;
+    size_t send_len = 0;
+
+    if (m_OutBuffer->length())
+    {
+        iov[iovcnt].iov_base = m_OutBuffer->rd_ptr();
+        iov[iovcnt].iov_len = m_OutBuffer->length();
+        send_len += iov[iovcnt++].iov_len;
+    }
+
+    for (typename PacketQueueT::iterator itr = m_PacketQueue.begin(); itr != m_PacketQueue.end() && iovcnt + 2 <= MaxSendBuffers; ++itr)
+    {
+        size_t skip = itr->sent;
+        const size_t packet_len = itr->packet ? itr->packet->size() : 0;
+
+        if (skip < packet_len)
+        {
+            iov[iovcnt].iov_base = (char*) itr->packet->contents() + skip;
+            iov[iovcnt].iov_len = packet_len - skip;
+            send_len += iov[iovcnt++].iov_len;
+            skip = 0;
+        }
+        else
+            skip -= packet_len;
+
+        if (skip < itr->bytes.size())
+        {
+            iov[iovcnt].iov_base = &itr->bytes[skip];
+            iov[iovcnt].iov_len = itr->bytes.size() - skip;
+            send_len += iov[iovcnt++].iov_len;
+        }
+    }
 
     if (send_len == 0)
         return cancel_wakeup_output(Guard);
 
 #ifdef MSG_NOSIGNAL
-    ssize_t n = peer().send(m_OutBuffer->rd_ptr(), send_len, MSG_NOSIGNAL);
+    msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = iov;
+    msg.msg_iovlen = iovcnt;
+
+    ssize_t n = ACE_OS::sendmsg(get_handle(), &msg, MSG_NOSIGNAL);
 #else
-    ssize_t n = peer().send(m_OutBuffer->rd_ptr(), send_len);
+    ssize_t n = peer().sendv(iov, iovcnt);
 #endif // MSG_NOSIGNAL
 
     if (n == 0)
@@ -230,26 +266,13 @@ int MangosSocket<SessionType, SocketName, Crypt>::handle_output(ACE_HANDLE)
 
         return -1;
     }
-    else if (n < (ssize_t)send_len) //now n > 0
-    {
-        m_OutBuffer->rd_ptr(static_cast<size_t>(n));
 
-        // move the data to the base of the buffer
-        m_OutBuffer->crunch();
+    iConsumeOutput(static_cast<size_t>(n));
 
+    if (m_OutBuffer->length() == 0 && m_PacketQueue.empty())
+        return cancel_wakeup_output(Guard);
+    else
         return schedule_wakeup_output(Guard);
-    }
-    else //now n == send_len
-    {
-        m_OutBuffer->reset();
-
-        if (!iFlushPacketQueue())
-            return cancel_wakeup_output(Guard);
-        else
-            return schedule_wakeup_output(Guard);
-    }
-
-    ACE_NOTREACHED(return 0);
 }
 
 template <typename SessionType, typename SocketName, typename Crypt>
@@ -282,9 +305,16 @@ int MangosSocket<SessionType, SocketName, Crypt>::Update(void)
     if (closing_)
         return -1;
 
-    if (m_OutActive || m_OutBuffer->length() == 0)
+    if (m_OutActive)
         return 0;
 
+    {
+        ACE_GUARD_RETURN(LockType, Guard, m_OutBufferLock, -1);
+
+        if (m_OutBuffer->length() == 0 && m_PacketQueue.empty())
+            return 0;
+    }
+
     return handle_output(get_handle());
 }
 
@@ -482,14 +512,8 @@ int MangosSocket<SessionType, SocketName, Crypt>::schedule_wakeup_output(GuardTy
 }
 
 template <typename SessionType, typename SocketName, typename Crypt>
-int MangosSocket<SessionType, SocketName, Crypt>::iSendPacket(const WorldPacket& pct)
+void MangosSocket<SessionType, SocketName, Crypt>::iSendHeader(const WorldPacket& pct)
 {
-    if (m_OutBuffer->space() < pct.size() + sizeof(ServerPktHeader))
-    {
-        errno = ENOBUFS;
-        return -1;
-    }
-
     ServerPktHeader header;
 
     header.cmd = pct.GetOpcode();
@@ -501,41 +525,65 @@ int MangosSocket<SessionType, SocketName, Crypt>::iSendPacket(const WorldPacket&
 
     m_Crypt.EncryptSend((uint8*) & header, sizeof(header));
 
-    if (m_OutBuffer->copy((char*) & header, sizeof(header)) == -1)
-        ACE_ASSERT(false);
+    iWrite((const char*) & header, sizeof(header));
+}
 
-    if (!pct.empty())
-        if (m_OutBuffer->copy((char*) pct.contents(), pct.size()) == -1)
+template <typename SessionType, typename SocketName, typename Crypt>
+void MangosSocket<SessionType, SocketName, Crypt>::iWrite(const char* data, size_t size)
+{
+    // Nothing can pass the queued data
+    if (m_PacketQueue.empty())
+    {
+        const size_t copied = size < m_OutBuffer->space() ? size : m_OutBuffer->space();
+
+        if (copied && m_OutBuffer->copy(data, copied) == -1)
             ACE_ASSERT(false);
 
-    return 0;
+        if (copied == size)
+            return;
+
+        data += copied;
+        size -= copied;
+    }
+
+    // Bytes are added behind the last queued data until it starts being sent,
+    // so that the memory of what is sent gets released
+    if (m_PacketQueue.empty() || m_PacketQueue.back().sent || m_PacketQueue.back().bytes.size() >= m_OutBufferSize)
+        m_PacketQueue.push_back(QueuedData());
+
+    std::vector<char>& bytes = m_PacketQueue.back().bytes;
+    bytes.insert(bytes.end(), data, data + size);
 }
 
 template <typename SessionType, typename SocketName, typename Crypt>
-bool MangosSocket<SessionType, SocketName, Crypt>::iFlushPacketQueue()
+void MangosSocket<SessionType, SocketName, Crypt>::iConsumeOutput(size_t size)
 {
-    WorldPacket *pct;
-    bool haveone = false;
+    const size_t buffer_len = m_OutBuffer->length();
 
-    while (m_PacketQueue.dequeue_head(pct) == 0)
+    if (size < buffer_len)
     {
-        if (((SocketName*)this)->iSendPacket(*pct) == -1)
-        {
-            if (m_PacketQueue.enqueue_head(pct) == -1)
-            {
-                delete pct;
-                sLog.outError("MangosSocket<SessionType, SocketName, Crypt>::iFlushPacketQueue m_PacketQueue->enqueue_head");
-                return false;
-            }
+        m_OutBuffer->rd_ptr(size);
 
-            break;
-        }
-        else
+        // move the data to the base of the buffer
+        m_OutBuffer->crunch();
+        return;
+    }
+
+    m_OutBuffer->reset();
+    size -= buffer_len;
+
+    while (size)
+    {
+        QueuedData& data = m_PacketQueue.front();
+        const size_t left = (data.packet ? data.packet->size() : 0) + data.bytes.size() - data.sent;
+
+        if (size < left)
         {
-            haveone = true;
-            delete pct;
+            data.sent += size;
+            return;
         }
-    }
 
-    return haveone;
+        size -= left;
+        m_PacketQueue.pop_front();
+    }
 }
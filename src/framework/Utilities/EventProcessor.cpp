@@ -20,6 +20,7 @@
 
 #include "EventProcessor.h"
 #include "Log.h" // Zerix: For MANGOS_ASSERT. No idea.
+#include <algorithm>
 
 void BasicEvent::ScheduleAbort()
 {
@@ -35,23 +36,62 @@ void BasicEvent::SetAborted()
     m_abortState = AbortState::STATE_ABORTED;
 }
 
+DEFINE_POOLED_ALLOCATOR(EventNode);
+DEFINE_POOLED_ALLOCATOR(EventWheel);
+
+static inline uint32 LowestBit(uint64 bits)
+{
+#if defined(__GNUC__)
+    return __builtin_ctzll(bits);
+#else
+    uint32 index = 0;
+    while (!(bits & 1))
+    {
+        bits >>= 1;
+        ++index;
+    }
+    return index;
+#endif
+}
+
+EventWheel::EventWheel()
+{
+    for (uint32 level = 0; level < LEVELS; ++level)
+    {
+        for (uint32 slot = 0; slot < SLOTS; ++slot)
+            slots[level][slot] = nullptr;
+        usedSlots[level] = 0;
+    }
+}
+
+EventProcessor::EventProcessor() : m_time(0), m_wheel(nullptr), m_wheelTime(0),
+    m_wheelCount(0), m_eventsCount(0), m_dueHead(nullptr), m_dueTail(nullptr)
+{
+}
+
 EventProcessor::~EventProcessor()
 {
     KillAllEvents(true);
+    delete m_wheel;
 }
 
 void EventProcessor::Update(uint32 p_time)
 {
     // update time
     m_time += p_time;
+    Advance(m_time);
 
     // main event loop
-    EventList::iterator i;
-    while (((i = m_events.begin()) != m_events.end()) && i->first <= m_time)
+    // Events may be added or killed by Execute, the due list is read again each time
+    while (EventNode* node = m_dueHead)
     {
         // get and remove event from queue
-        BasicEvent* event = i->second;
-        m_events.erase(i);
+        m_dueHead = node->next;
+        if (!m_dueHead)
+            m_dueTail = nullptr;
+        --m_eventsCount;
+        BasicEvent* event = node->event;
+        delete node;
 
         if (event->IsRunning())
         {
@@ -80,37 +120,63 @@ void EventProcessor::Update(uint32 p_time)
         // the next update tick
         AddEvent(event, CalculateTime(1), false);
     }
+
+    // Idle units do not keep a wheel
+    if (m_wheel && !m_wheelCount)
+    {
+        delete m_wheel;
+        m_wheel = nullptr;
+    }
 }
 
 void EventProcessor::KillAllEvents(bool force)
 {
-    for (auto itr = m_events.begin(); itr != m_events.end();)
+    // Detach every event first, Abort may schedule new ones
+    EventNode* events = m_dueHead;
+    EventNode* last = m_dueTail;
+    m_dueHead = m_dueTail = nullptr;
+    if (m_wheel)
+    {
+        for (uint32 level = 0; level < EventWheel::LEVELS; ++level)
+        {
+            while (uint64 used = m_wheel->usedSlots[level])
+            {
+                EventNode* head = TakeSlot(level, LowestBit(used));
+                if (last)
+                    last->next = head;
+                else
+                    events = head;
+                for (last = head; last->next; last = last->next) {}
+            }
+        }
+    }
+    m_wheelCount = 0;
+    m_eventsCount = 0;
+
+    while (EventNode* node = events)
     {
+        events = node->next;
+        BasicEvent* event = node->event;
+
         // Abort events which weren't aborted already
-        if (!itr->second->IsAborted())
+        if (!event->IsAborted())
         {
-            itr->second->SetAborted();
-            itr->second->Abort(m_time);
+            event->SetAborted();
+            event->Abort(m_time);
         }
 
         // Skip non-deletable events when we are
         // not forcing the event cancellation.
-        if (!force && !itr->second->IsDeletable())
+        if (!force && !event->IsDeletable())
         {
-            ++itr;
+            ++m_eventsCount;
+            Schedule(node);
             continue;
         }
 
-        delete itr->second;
-
-        if (force)
-            ++itr; // Clear the whole container when forcing
-        else
-            itr = m_events.erase(itr);
+        delete event;
+        delete node;
     }
-
-    if (force)
-        m_events.clear();
 }
 
 void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime)
@@ -118,10 +184,201 @@ void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime
     if (set_addtime)
         Event->m_addTime = m_time;
     Event->m_execTime = e_time;
-    m_events.insert(std::pair<uint64, BasicEvent*>(e_time, Event));
+
+    EventNode* node = new EventNode;
+    node->event = Event;
+    ++m_eventsCount;
+    Schedule(node);
 }
 
 uint64 EventProcessor::CalculateTime(uint64 t_offset) const
 {
     return(m_time + t_offset);
-}
\ No newline at end of file
+}
+
+void EventProcessor::GetEvents(std::vector<BasicEvent*>& events) const
+{
+    events.reserve(events.size() + m_eventsCount);
+    for (EventNode* node = m_dueHead; node; node = node->next)
+        events.push_back(node->event);
+
+    if (!m_wheel)
+        return;
+
+    for (uint32 level = 0; level < EventWheel::LEVELS; ++level)
+    {
+        for (uint32 slot = 0; slot < EventWheel::SLOTS; ++slot)
+        {
+            EventNode* tail = m_wheel->slots[level][slot];
+            if (!tail)
+                continue;
+            EventNode* node = tail;
+            do
+            {
+                node = node->next;
+                events.push_back(node->event);
+            } while (node != tail);
+        }
+    }
+}
+
+void EventProcessor::Schedule(EventNode* node)
+{
+    uint64 execTime = node->event->m_execTime;
+    if (execTime < m_wheelTime)
+    {
+        QueueDue(node);
+        return;
+    }
+
+    // Finest level holding the event, the slot is given by the bits of its level
+    uint64 delta = execTime - m_wheelTime;
+    uint32 level = 0;
+    while (level < EventWheel::LEVELS - 1 && delta >> ((level + 1) * EventWheel::SLOT_BITS))
+        ++level;
+    if (delta >> (EventWheel::LEVELS * EventWheel::SLOT_BITS))
+        execTime = m_wheelTime + (uint64(1) << (EventWheel::LEVELS * EventWheel::SLOT_BITS)) - 1;
+    uint32 slot = (execTime >> (level * EventWheel::SLOT_BITS)) & (EventWheel::SLOTS - 1);
+
+    if (!m_wheel)
+        m_wheel = new EventWheel;
+
+    EventNode*& tail = m_wheel->slots[level][slot];
+    if (tail)
+    {
+        node->next = tail->next;
+        tail->next = node;
+    }
+    else
+        node->next = node;
+    tail = node;
+    m_wheel->usedSlots[level] |= uint64(1) << slot;
+    ++m_wheelCount;
+}
+
+void EventProcessor::QueueDue(EventNode* node)
+{
+    uint64 execTime = node->event->m_execTime;
+    if (!m_dueTail || m_dueTail->event->m_execTime <= execTime)
+    {
+        node->next = nullptr;
+        if (m_dueTail)
+            m_dueTail->next = node;
+        else
+            m_dueHead = node;
+        m_dueTail = node;
+        return;
+    }
+
+    // Added in the past while other events are due: keep the execution order
+    EventNode** itr = &m_dueHead;
+    while ((*itr)->event->m_execTime <= execTime)
+        itr = &(*itr)->next;
+    node->next = *itr;
+    *itr = node;
+}
+
+// Moves every event of the wheel due at 'time' or before in the due list
+void EventProcessor::Advance(uint64 time)
+{
+    while (m_wheelTime <= time)
+    {
+        if (!m_wheelCount)
+        {
+            m_wheelTime = time + 1;
+            return;
+        }
+
+        uint32 slot = m_wheelTime & (EventWheel::SLOTS - 1);
+        if (!slot)
+        {
+            // Next period of a level starts, spread its slot in the finer levels
+            for (uint32 level = 1; level < EventWheel::LEVELS; ++level)
+            {
+                uint32 levelSlot = (m_wheelTime >> (level * EventWheel::SLOT_BITS)) & (EventWheel::SLOTS - 1);
+                Cascade(level, levelSlot);
+                if (levelSlot)
+                    break;
+            }
+        }
+
+        // Jump to the next used slot of level 0, or to the start of its next period
+        uint64 periodStart = m_wheelTime - slot;
+        uint64 used = m_wheel->usedSlots[0] & (~uint64(0) << slot);
+        if (!used)
+        {
+            m_wheelTime = std::min(NextCascadeTime(), time + 1);
+            continue;
+        }
+
+        uint64 next = periodStart + LowestBit(used);
+        if (next > time)
+        {
+            m_wheelTime = time + 1;
+            return;
+        }
+        m_wheelTime = next + 1;
+
+        EventNode* head = TakeSlot(0, next - periodStart);
+        if (m_dueTail)
+            m_dueTail->next = head;
+        else
+            m_dueHead = head;
+        for (EventNode* node = head; node; node = node->next)
+        {
+            m_dueTail = node;
+            --m_wheelCount;
+        }
+    }
+}
+
+// Start of the next period of a level with events to spread. Nothing happens
+// in the wheel before, level 0 having no event left in the current period.
+uint64 EventProcessor::NextCascadeTime() const
+{
+    uint64 next = ((m_wheelTime >> EventWheel::SLOT_BITS) + 1) << EventWheel::SLOT_BITS;
+    if (m_wheel->usedSlots[0])
+        return next;
+
+    next = ~uint64(0);
+    for (uint32 level = 1; level < EventWheel::LEVELS; ++level)
+    {
+        uint64 used = m_wheel->usedSlots[level];
+        if (!used)
+            continue;
+
+        // First used slot after the current one (the current one after a full turn)
+        uint32 shift = level * EventWheel::SLOT_BITS;
+        uint32 start = ((m_wheelTime >> shift) + 1) & (EventWheel::SLOTS - 1);
+        uint64 rotated = start ? (used >> start) | (used << (EventWheel::SLOTS - start)) : used;
+        uint64 distance = LowestBit(rotated) + 1;
+        next = std::min(next, ((m_wheelTime >> shift) + distance) << shift);
+    }
+    return next;
+}
+
+void EventProcessor::Cascade(uint32 level, uint32 slot)
+{
+    EventNode* node = TakeSlot(level, slot);
+    while (node)
+    {
+        EventNode* next = node->next;
+        --m_wheelCount;
+        Schedule(node);
+        node = next;
+    }
+}
+
+// Detaches the events of a slot, as a null terminated list
+EventNode* EventProcessor::TakeSlot(uint32 level, uint32 slot)
+{
+    EventNode*& tail = m_wheel->slots[level][slot];
+    if (!tail)
+        return nullptr;
+
+    EventNode* head = tail->next;
+    tail->next = nullptr;
+    tail = nullptr;
+    m_wheel->usedSlots[level] &= ~(uint64(1) << slot);
+    return head;
+}
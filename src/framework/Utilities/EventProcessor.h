@@ -22,7 +22,8 @@
 #define __EVENTPROCESSOR_H
 
 #include "Platform/Define.h"
-#include <map>
+#include "Utilities/ObjectPool.h"
+#include <vector>
 
 class EventProcessor;
 
@@ -70,12 +71,44 @@ class BasicEvent
         uint64 m_execTime;                                  // planned time of next execution, filled by event handler
 };
 
-typedef std::multimap<uint64, BasicEvent*> EventList;
+// Wheel entry of a scheduled event
+struct EventNode
+{
+    BasicEvent* event;
+    EventNode* next;
+
+    DECLARE_POOLED_ALLOCATOR(EventNode);
+};
+
+// Timing wheel storage, allocated while the processor has events in the future
+struct EventWheel
+{
+    static uint32 const LEVELS = 5;
+    static uint32 const SLOT_BITS = 6;
+    static uint32 const SLOTS = 1 << SLOT_BITS;
+
+    EventWheel();
+
+    // Circular lists, each slot points to its last node
+    EventNode* slots[LEVELS][SLOTS];
+    uint64 usedSlots[LEVELS];                               // one bit per non empty slot
 
+    DECLARE_POOLED_ALLOCATOR(EventWheel);
+};
+
+/*
+ * Events are kept in a hierarchical timing wheel: level 0 has one slot per
+ * millisecond for the next 64ms, each next level has 64 slots 64 times
+ * coarser (up to ~12 days, farther events wait in the last slot). Adding or
+ * expiring an event is O(1) whatever the number of events. When the wheel
+ * reaches a coarse slot, its events are spread in the finer levels.
+ * Due events are executed by execution time, and in the order they were
+ * scheduled for a same time unless they come from different levels.
+ */
 class EventProcessor
 {
     public:
-        EventProcessor() : m_time(0) { }
+        EventProcessor();
         ~EventProcessor();
 
         void Update(uint32 p_time);
@@ -84,12 +117,27 @@ class EventProcessor
         uint64 CalculateTime(uint64 t_offset) const;
 
         // Zerix: Nostalrius compatibility. Figure a better way to handle this.
-        bool HasScheduledEvent() const { return m_events.empty() ? false : true; }
-        EventList const& GetEvents() const { return m_events; }
+        bool HasScheduledEvent() const { return m_eventsCount != 0; }
+        // Scheduled events, in no particular order
+        void GetEvents(std::vector<BasicEvent*>& events) const;
 
     protected:
         uint64 m_time;
-        EventList m_events;
+
+    private:
+        void Schedule(EventNode* node);
+        void QueueDue(EventNode* node);
+        void Advance(uint64 time);
+        void Cascade(uint32 level, uint32 slot);
+        uint64 NextCascadeTime() const;
+        EventNode* TakeSlot(uint32 level, uint32 slot);
+
+        EventWheel* m_wheel;
+        uint64 m_wheelTime;                                 // next tick of the wheel, events due before are in m_due
+        uint32 m_wheelCount;                                // events in the wheel
+        uint32 m_eventsCount;                               // events in the wheel and due
+        EventNode* m_dueHead;                               // sorted by execution time
+        EventNode* m_dueTail;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2017 Light's Hope <https://lightshope.org>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ObjectPool.h"
+
+namespace
+{
+    // Pools are created on first use of their type, from any thread
+    std::mutex& GetRegistryLock()
+    {
+        static std::mutex lock;
+        return lock;
+    }
+
+    std::vector<ObjectPoolBase*>& GetRegistry()
+    {
+        static std::vector<ObjectPoolBase*> pools;
+        return pools;
+    }
+}
+
+ObjectPoolBase::ObjectPoolBase(char const* name) : m_name(name)
+{
+    std::lock_guard<std::mutex> guard(GetRegistryLock());
+    GetRegistry().push_back(this);
+}
+
+void ObjectPoolBase::GetAllStats(std::vector<ObjectPoolStats>& stats)
+{
+    std::lock_guard<std::mutex> guard(GetRegistryLock());
+    for (ObjectPoolBase const* pool : GetRegistry())
+    {
+        ObjectPoolStats poolStats;
+        pool->GetStats(poolStats);
+        stats.push_back(poolStats);
+    }
+}
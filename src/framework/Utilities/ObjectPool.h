@@ -0,0 +1,247 @@
+/*
+ * Copyright (C) 2017 Light's Hope <https://lightshope.org>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_OBJECTPOOL_H
+#define MANGOS_OBJECTPOOL_H
+
+#include "Platform/Define.h"
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <vector>
+
+struct ObjectPoolStats
+{
+    char const* name;
+    uint32 objectSize;
+    uint32 slabs;
+    uint32 capacity;                                        // objects fitting in all the slabs
+    int64  inUse;
+    uint32 sharedFree;                                      // free objects not cached by a thread
+    uint64 allocations;
+    uint64 fallbacks;                                       // derived classes, allocated with global new
+};
+
+/*
+ * Type erased part of ObjectPool: registry of every pool for the stats command.
+ */
+class ObjectPoolBase
+{
+    public:
+        virtual void GetStats(ObjectPoolStats& stats) const = 0;
+
+        static void GetAllStats(std::vector<ObjectPoolStats>& stats);
+
+    protected:
+        explicit ObjectPoolBase(char const* name);
+        ~ObjectPoolBase() {}
+
+        char const* m_name;
+};
+
+/*
+ * Slab allocator for the hot world object types (Creature, Spell, Aura ...),
+ * used by the class specific operator new/delete declared with
+ * DECLARE_POOLED_ALLOCATOR.
+ *
+ * Objects are carved in slabs of SLAB_OBJECTS, and freed objects are kept in
+ * a free list instead of going back to the system allocator: grid load/unload
+ * and combat churn reuse the same memory instead of fragmenting the heap, RSS
+ * stays at the peak usage.
+ * Each thread keeps its own free list, so map threads allocate and free
+ * without any lock. Objects often die in another thread than the one which
+ * created them (teleports, spells finished by the world thread ...), so the
+ * thread caches are balanced through a shared list, BATCH objects at a time,
+ * under a mutex.
+ *
+ * Only objects of exactly sizeof(T) are pooled, derived classes (Pet, Totem,
+ * AreaAura ...) fall back to the global allocator.
+ * Slabs are never released, pooled objects may still be deleted by static
+ * destructors at exit.
+ */
+template <class T>
+class ObjectPool : public ObjectPoolBase
+{
+    public:
+        explicit ObjectPool(char const* name) : ObjectPoolBase(name),
+            m_sharedFree(nullptr), m_sharedFreeCount(0), m_inUse(0), m_allocations(0), m_fallbacks(0) {}
+
+        void* Allocate(size_t size)
+        {
+            if (size != sizeof(T))
+            {
+                ++m_fallbacks;
+                return ::operator new(size);
+            }
+
+            ThreadCache& cache = GetThreadCache();
+            if (!cache.head)
+                Refill(cache);
+
+            FreeNode* node = cache.head;
+            cache.head = node->next;
+            --cache.count;
+            ++m_inUse;
+            ++m_allocations;
+            return node;
+        }
+
+        void Deallocate(void* ptr, size_t size)
+        {
+            if (!ptr)
+                return;
+
+            if (size != sizeof(T))
+            {
+                ::operator delete(ptr);
+                return;
+            }
+
+            --m_inUse;
+            FreeNode* node = static_cast<FreeNode*>(ptr);
+            ThreadCache& cache = GetThreadCache();
+            if (cache.exited)
+            {
+                // Thread cache already destroyed (static destructors at exit)
+                std::lock_guard<std::mutex> guard(m_lock);
+                node->next = m_sharedFree;
+                m_sharedFree = node;
+                ++m_sharedFreeCount;
+                return;
+            }
+
+            node->next = cache.head;
+            cache.head = node;
+            if (++cache.count >= 2 * BATCH)
+                Release(cache, BATCH);
+        }
+
+        void GetStats(ObjectPoolStats& stats) const override
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            stats.name = m_name;
+            stats.objectSize = sizeof(T);
+            stats.slabs = m_slabs.size();
+            stats.capacity = m_slabs.size() * SLAB_OBJECTS;
+            stats.inUse = m_inUse;
+            stats.sharedFree = m_sharedFreeCount;
+            stats.allocations = m_allocations;
+            stats.fallbacks = m_fallbacks;
+        }
+
+    private:
+        static uint32 const SLAB_OBJECTS = 64;
+        static uint32 const BATCH = 32;                     // objects moved between a thread and the shared list at once
+
+        union FreeNode
+        {
+            FreeNode* next;
+            alignas(T) char storage[sizeof(T)];
+        };
+
+        struct ThreadCache
+        {
+            ThreadCache() : pool(nullptr), head(nullptr), count(0), exited(false) {}
+            ~ThreadCache()
+            {
+                if (pool && count)
+                    pool->Release(*this, count);
+                exited = true;
+            }
+
+            ObjectPool* pool;
+            FreeNode* head;
+            uint32 count;
+            bool exited;
+        };
+
+        ThreadCache& GetThreadCache()
+        {
+            static thread_local ThreadCache cache;
+            cache.pool = this;
+            return cache;
+        }
+
+        // Takes a batch from the shared list, or a new slab when it is empty
+        void Refill(ThreadCache& cache)
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            if (m_sharedFree)
+            {
+                for (uint32 i = 0; i < BATCH && m_sharedFree; ++i)
+                {
+                    FreeNode* node = m_sharedFree;
+                    m_sharedFree = node->next;
+                    --m_sharedFreeCount;
+                    node->next = cache.head;
+                    cache.head = node;
+                    ++cache.count;
+                }
+                return;
+            }
+
+            FreeNode* slab = static_cast<FreeNode*>(::operator new(SLAB_OBJECTS * sizeof(FreeNode)));
+            m_slabs.push_back(slab);
+            for (uint32 i = 0; i < SLAB_OBJECTS; ++i)
+            {
+                slab[i].next = cache.head;
+                cache.head = &slab[i];
+            }
+            cache.count += SLAB_OBJECTS;
+        }
+
+        void Release(ThreadCache& cache, uint32 count)
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            for (uint32 i = 0; i < count && cache.head; ++i)
+            {
+                FreeNode* node = cache.head;
+                cache.head = node->next;
+                --cache.count;
+                node->next = m_sharedFree;
+                m_sharedFree = node;
+                ++m_sharedFreeCount;
+            }
+        }
+
+        mutable std::mutex m_lock;
+        std::vector<FreeNode*> m_slabs;
+        FreeNode* m_sharedFree;
+        uint32 m_sharedFreeCount;
+
+        std::atomic<int64> m_inUse;                         // allocated and freed from different threads
+        std::atomic<uint64> m_allocations;
+        std::atomic<uint64> m_fallbacks;
+};
+
+// In the class declaration
+#define DECLARE_POOLED_ALLOCATOR(T) \
+    static void* operator new(size_t size); \
+    static void operator delete(void* ptr, size_t size)
+
+// In the class translation unit
+#define DEFINE_POOLED_ALLOCATOR(T) \
+    static ObjectPool<T>& Get##T##Pool() \
+    { \
+        static ObjectPool<T>* pool = new ObjectPool<T>(#T); \
+        return *pool; \
+    } \
+    void* T::operator new(size_t size) { return Get##T##Pool().Allocate(size); } \
+    void T::operator delete(void* ptr, size_t size) { Get##T##Pool().Deallocate(ptr, size); }
+
+#endif
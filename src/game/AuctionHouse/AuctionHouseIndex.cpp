@@ -0,0 +1,214 @@
+/*
+ * Copyright (C) 2017 Light's Hope <https://lightshope.org>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "AuctionHouseIndex.h"
+#include "AuctionHouseMgr.h"
+#include "ObjectMgr.h"
+#include "Util.h"
+
+void AuctionHouseIndex::Add(AuctionEntry* auction, ItemPrototype const* proto)
+{
+    AuctionIndexEntry entry;
+    entry.auctionId = auction->Id;
+    entry.itemEntry = proto->ItemId;
+    entry.auction = auction;
+    entry.itemClass = proto->Class;
+    entry.subClass = proto->SubClass;
+    entry.inventoryType = proto->InventoryType;
+    entry.quality = proto->Quality;
+    entry.requiredLevel = proto->RequiredLevel;
+
+    EntryList& byClass = m_byClass[entry.itemClass];
+    EntryList& bySubClass = m_bySubClass[SubClassKey(entry.itemClass, entry.subClass)];
+
+    ListPositions& positions = m_positions[entry.auctionId];
+    positions.pos[LIST_ALL] = m_all.size();
+    positions.pos[LIST_CLASS] = byClass.size();
+    positions.pos[LIST_SUBCLASS] = bySubClass.size();
+
+    m_all.push_back(entry);
+    byClass.push_back(entry);
+    bySubClass.push_back(entry);
+    AddItem(proto);
+}
+
+void AuctionHouseIndex::Remove(uint32 auctionId)
+{
+    UNORDERED_MAP<uint32, ListPositions>::iterator itr = m_positions.find(auctionId);
+    if (itr == m_positions.end())
+        return;
+
+    // The auction may already be deleted, only the packed entry is used
+    ListPositions positions = itr->second;
+    m_positions.erase(itr);
+    AuctionIndexEntry entry = m_all[positions.pos[LIST_ALL]];
+
+    Erase(m_all, positions.pos[LIST_ALL], LIST_ALL);
+
+    CategoryMap::iterator category = m_byClass.find(entry.itemClass);
+    if (category != m_byClass.end())
+    {
+        Erase(category->second, positions.pos[LIST_CLASS], LIST_CLASS);
+        if (category->second.empty())
+            m_byClass.erase(category);
+    }
+
+    category = m_bySubClass.find(SubClassKey(entry.itemClass, entry.subClass));
+    if (category != m_bySubClass.end())
+    {
+        Erase(category->second, positions.pos[LIST_SUBCLASS], LIST_SUBCLASS);
+        if (category->second.empty())
+            m_bySubClass.erase(category);
+    }
+
+    RemoveItem(entry.itemEntry);
+}
+
+AuctionHouseIndex::EntryList const* AuctionHouseIndex::GetCategory(uint32 itemClass, uint32 subClass) const
+{
+    if (itemClass == AUCTION_SEARCH_ANY)
+        return &m_all;
+
+    if (subClass == AUCTION_SEARCH_ANY)
+    {
+        CategoryMap::const_iterator itr = m_byClass.find(itemClass);
+        return itr != m_byClass.end() ? &itr->second : NULL;
+    }
+
+    CategoryMap::const_iterator itr = m_bySubClass.find(SubClassKey(itemClass, subClass));
+    return itr != m_bySubClass.end() ? &itr->second : NULL;
+}
+
+bool AuctionHouseIndex::IsCategoryOnly(AuctionSearchFilter const& filter)
+{
+    return filter.inventoryType == AUCTION_SEARCH_ANY && filter.quality == AUCTION_SEARCH_ANY &&
+           !filter.levelMin && filter.name.empty();
+}
+
+void AuctionHouseIndex::FindItemsByName(std::wstring const& name, int localeIdx, std::vector<uint32>& items) const
+{
+    // Candidates: items of the rarest trigram of the searched name, or every item for short names
+    std::vector<uint32> const* candidates = NULL;
+    for (size_t pos = 0; pos + 3 <= name.size(); ++pos)
+    {
+        TrigramMap::const_iterator itr = m_trigrams.find(MakeTrigram(name, pos));
+        if (itr == m_trigrams.end())
+            return;
+        if (!candidates || itr->second.size() < candidates->size())
+            candidates = &itr->second;
+    }
+
+    size_t nameIdx = localeIdx >= 0 ? localeIdx + 1 : 0;
+    auto check = [&](uint32 itemEntry, IndexedItem const& item)
+    {
+        // No default name, not listed whatever the locale
+        if (item.names[0].empty())
+            return;
+        std::wstring const& itemName = nameIdx < item.names.size() && !item.names[nameIdx].empty() ? item.names[nameIdx] : item.names[0];
+        if (itemName.find(name) != std::wstring::npos)
+            items.push_back(itemEntry);
+    };
+
+    if (candidates)
+    {
+        for (uint32 itemEntry : *candidates)
+            check(itemEntry, m_items.find(itemEntry)->second);
+        return;
+    }
+
+    for (UNORDERED_MAP<uint32, IndexedItem>::const_iterator itr = m_items.begin(); itr != m_items.end(); ++itr)
+        check(itr->first, itr->second);
+    std::sort(items.begin(), items.end());
+}
+
+uint64 AuctionHouseIndex::MakeTrigram(std::wstring const& str, size_t pos)
+{
+    // Unicode code points fit in 21 bits
+    return (uint64(str[pos] & 0x1FFFFF) << 42) | (uint64(str[pos + 1] & 0x1FFFFF) << 21) | uint64(str[pos + 2] & 0x1FFFFF);
+}
+
+// Constant time: the last auction of the list takes the place of the removed one
+void AuctionHouseIndex::Erase(EntryList& list, uint32 pos, uint32 listIdx)
+{
+    if (pos + 1 < list.size())
+    {
+        list[pos] = list.back();
+        m_positions[list[pos].auctionId].pos[listIdx] = pos;
+    }
+    list.pop_back();
+}
+
+void AuctionHouseIndex::AddItem(ItemPrototype const* proto)
+{
+    IndexedItem& item = m_items[proto->ItemId];
+    if (item.auctions++)
+        return;
+
+    item.names.resize(1);
+    Utf8toWStr(proto->Name1, item.names[0]);
+    wstrToLower(item.names[0]);
+    if (ItemLocale const* locale = sObjectMgr.GetItemLocale(proto->ItemId))
+    {
+        item.names.resize(locale->Name.size() + 1);
+        for (size_t i = 0; i < locale->Name.size(); ++i)
+        {
+            Utf8toWStr(locale->Name[i], item.names[i + 1]);
+            wstrToLower(item.names[i + 1]);
+        }
+    }
+
+    std::vector<uint64> trigrams;
+    GetTrigrams(item, trigrams);
+    for (uint64 trigram : trigrams)
+    {
+        std::vector<uint32>& items = m_trigrams[trigram];
+        items.insert(std::lower_bound(items.begin(), items.end(), proto->ItemId), proto->ItemId);
+    }
+}
+
+void AuctionHouseIndex::RemoveItem(uint32 itemEntry)
+{
+    UNORDERED_MAP<uint32, IndexedItem>::iterator itemItr = m_items.find(itemEntry);
+    if (itemItr == m_items.end() || --itemItr->second.auctions)
+        return;
+
+    std::vector<uint64> trigrams;
+    GetTrigrams(itemItr->second, trigrams);
+    for (uint64 trigram : trigrams)
+    {
+        TrigramMap::iterator itr = m_trigrams.find(trigram);
+        if (itr == m_trigrams.end())
+            continue;
+        std::vector<uint32>::iterator pos = std::lower_bound(itr->second.begin(), itr->second.end(), itemEntry);
+        if (pos != itr->second.end() && *pos == itemEntry)
+            itr->second.erase(pos);
+        if (itr->second.empty())
+            m_trigrams.erase(itr);
+    }
+    m_items.erase(itemItr);
+}
+
+// Distinct trigrams of every name of the item
+void AuctionHouseIndex::GetTrigrams(IndexedItem const& item, std::vector<uint64>& trigrams) const
+{
+    for (std::wstring const& name : item.names)
+        for (size_t pos = 0; pos + 3 <= name.size(); ++pos)
+            trigrams.push_back(MakeTrigram(name, pos));
+    std::sort(trigrams.begin(), trigrams.end());
+    trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+}
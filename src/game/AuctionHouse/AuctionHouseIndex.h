@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2017 Light's Hope <https://lightshope.org>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _AUCTION_HOUSE_INDEX_H
+#define _AUCTION_HOUSE_INDEX_H
+
+#include "Common.h"
+#include "ItemPrototype.h"
+#include "Utilities/UnorderedMapSet.h"
+#include <string>
+#include <vector>
+
+struct AuctionEntry;
+
+#define AUCTION_SEARCH_ANY 0xffffffff
+
+// Item filters of an auction house search (CMSG_AUCTION_LIST_ITEMS)
+struct AuctionSearchFilter
+{
+    AuctionSearchFilter() : itemClass(AUCTION_SEARCH_ANY), subClass(AUCTION_SEARCH_ANY),
+        inventoryType(AUCTION_SEARCH_ANY), quality(AUCTION_SEARCH_ANY), levelMin(0), levelMax(0), localeIdx(-1) {}
+
+    uint32 itemClass;
+    uint32 subClass;
+    uint32 inventoryType;
+    uint32 quality;                                         // minimum quality
+    uint8 levelMin;                                         // 0: any
+    uint8 levelMax;                                         // 0: any
+    std::wstring name;                                      // lower case, empty: any
+    int localeIdx;                                          // DB locale index of the name
+};
+
+// Searchable fields of an auction, packed so that searches do not touch the items
+struct AuctionIndexEntry
+{
+    uint32 auctionId;
+    uint32 itemEntry;
+    AuctionEntry* auction;
+    uint8 itemClass;
+    uint8 subClass;
+    uint8 inventoryType;
+    uint8 quality;
+    uint8 requiredLevel;
+};
+
+/*
+ * Secondary indexes of the auctions of one auction house, maintained when
+ * auctions are added or removed (world thread), and read concurrently by the
+ * async search tasks.
+ *
+ * Auctions are kept in a flat list, and in one list per item class and per
+ * item class and subclass (the auction house categories), so that a search
+ * only walks its category and pages by position. Slot, quality and level
+ * filters are checked on the packed entries.
+ * Lists are not sorted: the position of every auction in its lists is kept,
+ * and a removed auction is replaced by the last one of the list.
+ * Names are indexed per item entry: every trigram of the lower case name in
+ * any locale points to the items whose names contain it. A name search only
+ * checks the items of its rarest trigram, in the locale of the player.
+ */
+class AuctionHouseIndex
+{
+    public:
+        typedef std::vector<AuctionIndexEntry> EntryList;
+
+        void Add(AuctionEntry* auction, ItemPrototype const* proto);
+        void Remove(uint32 auctionId);
+
+        uint32 GetCount() const { return m_all.size(); }
+        EntryList const& GetAll() const { return m_all; }
+
+        // Smallest list holding every auction of the category, NULL if there is none
+        EntryList const* GetCategory(uint32 itemClass, uint32 subClass) const;
+
+        // The auctions of the list are all matching, no other filter is set
+        static bool IsCategoryOnly(AuctionSearchFilter const& filter);
+
+        // Calls visit(AuctionIndexEntry const&) for every auction matching the filter, in list order
+        template <class Visitor>
+        void Search(AuctionSearchFilter const& filter, Visitor&& visit) const
+        {
+            EntryList const* list = GetCategory(filter.itemClass, filter.subClass);
+            if (!list)
+                return;
+
+            std::vector<uint32> items;
+            if (!filter.name.empty())
+            {
+                FindItemsByName(filter.name, filter.localeIdx, items);
+                if (items.empty())
+                    return;
+            }
+
+            for (EntryList::const_iterator itr = list->begin(); itr != list->end(); ++itr)
+                if (Matches(*itr, filter) && (items.empty() || std::binary_search(items.begin(), items.end(), itr->itemEntry)))
+                    visit(*itr);
+        }
+
+        // Item entries with auctions whose name contains 'name' in the locale, sorted
+        void FindItemsByName(std::wstring const& name, int localeIdx, std::vector<uint32>& items) const;
+
+    private:
+        struct IndexedItem
+        {
+            uint32 auctions;
+            std::vector<std::wstring> names;                // default name first, then by locale index (empty: default)
+        };
+
+        enum
+        {
+            LIST_ALL,
+            LIST_CLASS,
+            LIST_SUBCLASS,
+            MAX_LISTS
+        };
+
+        struct ListPositions
+        {
+            uint32 pos[MAX_LISTS];
+        };
+
+        typedef UNORDERED_MAP<uint32, EntryList> CategoryMap;
+        typedef UNORDERED_MAP<uint64, std::vector<uint32>> TrigramMap;
+
+        // Same filters as the former full scan, the item class is given by the list
+        static bool Matches(AuctionIndexEntry const& entry, AuctionSearchFilter const& filter)
+        {
+            if (filter.subClass != AUCTION_SEARCH_ANY && entry.subClass != filter.subClass)
+                return false;
+
+            if (filter.inventoryType != AUCTION_SEARCH_ANY && entry.inventoryType != filter.inventoryType &&
+                    (filter.inventoryType != INVTYPE_CHEST || entry.inventoryType != INVTYPE_ROBE))
+                return false;
+
+            if (filter.quality != AUCTION_SEARCH_ANY && entry.quality < filter.quality)
+                return false;
+
+            if (filter.levelMin && (entry.requiredLevel < filter.levelMin || (filter.levelMax && entry.requiredLevel > filter.levelMax)))
+                return false;
+
+            return true;
+        }
+        static uint64 MakeTrigram(std::wstring const& str, size_t pos);
+        static uint32 SubClassKey(uint32 itemClass, uint32 subClass) { return (itemClass << 8) | subClass; }
+        void Erase(EntryList& list, uint32 pos, uint32 listIdx);
+
+        void AddItem(ItemPrototype const* proto);
+        void RemoveItem(uint32 itemEntry);
+        void GetTrigrams(IndexedItem const& item, std::vector<uint64>& trigrams) const;
+
+        EntryList m_all;
+        CategoryMap m_byClass;                              // key: item class
+        CategoryMap m_bySubClass;                           // key: item class << 8 | subclass
+        UNORDERED_MAP<uint32, ListPositions> m_positions;   // key: auction id
+        UNORDERED_MAP<uint32, IndexedItem> m_items;         // item entries with auctions
+        TrigramMap m_trigrams;                              // sorted item entries per name trigram
+};
+
+#endif
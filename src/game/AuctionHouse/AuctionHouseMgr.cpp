@@ -41,10 +41,20 @@
 
 INSTANTIATE_SINGLETON_1(AuctionHouseMgr);
 
+void AuctionHouseObject::AddAuction(AuctionEntry *ah)
+{
+    MANGOS_ASSERT( ah );
+    AuctionsMap[ah->Id] = ah;
+    if (ItemPrototype const* proto = sObjectMgr.GetItemPrototype(ah->itemTemplate))
+        m_index.Add(ah, proto);
+}
+
+// The auction may already be deleted
 bool AuctionHouseObject::RemoveAuction(uint32 id)
 {
     if (AuctionsMap.erase(id))
     {
+        m_index.Remove(id);
         sObjectMgr.FreeAuctionID(id);
         return true;
     }
@@ -680,99 +690,63 @@ void AuctionHouseObject::BuildListAuctionItems(WorldPacket& data, Player* player
         uint32& count, uint32& totalcount)
 {
     std::string const& clientIp = player->GetSession()->GetRemoteAddress();
-    // Happening often, and easy to deal with
-    if (query.auctionMainCategory == 0xffffffff && query.auctionSubCategory == 0xffffffff && query.auctionSlotID == 0xffffffff &&
-        query.quality == 0xffffffff && query.levelmin == 0x00 && query.levelmax == 0x00 && query.usable == 0x00 && query.wsearchedname.empty())
+
+    AuctionSearchFilter filter;
+    filter.itemClass = query.auctionMainCategory;
+    filter.subClass = query.auctionSubCategory;
+    filter.inventoryType = query.auctionSlotID;
+    filter.quality = query.quality;
+    filter.levelMin = query.levelmin;
+    filter.levelMax = query.levelmax;
+    filter.name = query.wsearchedname;
+    filter.localeIdx = player->GetSession()->GetSessionDbLocaleIndex();
+
+    // Happening often (full scans, category browsing), and easy to deal with: page by position
+    if (!query.usable && AuctionHouseIndex::IsCategoryOnly(filter))
     {
-        totalcount = AuctionsMap.size();
-        if (query.listfrom < totalcount)
+        AuctionHouseIndex::EntryList const* auctions = m_index.GetCategory(filter.itemClass, filter.subClass);
+        if (!auctions)
+            return;
+
+        totalcount = auctions->size();
+        for (uint32 i = query.listfrom; i < auctions->size() && count < 50; ++i)
         {
-            AuctionEntryMap::iterator itr = AuctionsMap.begin();
-            std::advance(itr, query.listfrom);
-            for (; itr != AuctionsMap.end(); ++itr)
-            {
-                if (!itr->second->IsAvailableFor(clientIp))
-                    continue;
+            AuctionEntry* auction = (*auctions)[i].auction;
+            if (!auction->IsAvailableFor(clientIp))
+                continue;
 
-                itr->second->BuildAuctionInfo(data);
-                if ((++count) >= 50)
-                    break;
-            }
+            if (auction->BuildAuctionInfo(data))
+                ++count;
         }
         return;
     }
 
-    time_t currTime = sWorld.GetGameTime();
-    int loc_idx = player->GetSession()->GetSessionDbLocaleIndex();
-
-    for (AuctionEntryMap::const_iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end(); ++itr)
+    m_index.Search(filter, [&](AuctionIndexEntry const& entry)
     {
-        AuctionEntry *Aentry = itr->second;
-        Item *item = sAuctionMgr.GetAItem(Aentry->itemGuidLow);
-        if (!item)
-            continue;
-
+        AuctionEntry* auction = entry.auction;
+        if (query.usable)
         {
-            ItemPrototype const *proto = item->GetProto();
-
-            if (query.auctionMainCategory != 0xffffffff && proto->Class != query.auctionMainCategory)
-                continue;
-
-            if (query.auctionSubCategory != 0xffffffff && proto->SubClass != query.auctionSubCategory)
-                continue;
-
-            if (query.auctionSlotID != 0xffffffff && proto->InventoryType != query.auctionSlotID &&
-                    (query.auctionSlotID != INVTYPE_CHEST ||  query.auctionSlotID == INVTYPE_CHEST && proto->InventoryType != INVTYPE_ROBE))
-                continue;
-
-            if (query.quality != 0xffffffff && proto->Quality < query.quality)
-                continue;
-
-            if (query.levelmin != 0x00 && (proto->RequiredLevel < query.levelmin || (query.levelmax != 0x00 && proto->RequiredLevel > query.levelmax)))
-                continue;
+            Item* item = sAuctionMgr.GetAItem(auction->itemGuidLow);
+            if (!item || player->CanUseItem(item) != EQUIP_ERR_OK)
+                return;
 
-            if (query.usable != 0x00 && player->CanUseItem(item) != EQUIP_ERR_OK)
-                continue;
-
-            if (query.usable != 0x00 && proto->Class == ITEM_CLASS_RECIPE)
+            ItemPrototype const* proto = item->GetProto();
+            if (proto->Class == ITEM_CLASS_RECIPE)
                 if (SpellEntry const* spell = sSpellMgr.GetSpellEntry(proto->Spells[0].SpellId))
                     if (player->HasSpell(spell->EffectTriggerSpell[EFFECT_INDEX_0]))
-                        continue;
-
-            // IP locked auction
-            if (!Aentry->IsAvailableFor(clientIp))
-                continue;
-
-            if (!query.wsearchedname.empty())
-            {
-                std::string name = proto->Name1;
-                if (name.empty())
-                    continue;
-
-                // local name
-                if (loc_idx >= 0)
-                {
-                    ItemLocale const *il = sObjectMgr.GetItemLocale(proto->ItemId);
-                    if (il)
-                    {
-                        if (il->Name.size() > size_t(loc_idx) && !il->Name[loc_idx].empty())
-                            name = il->Name[loc_idx];
-                    }
-                }
+                        return;
+        }
 
-                if (!Utf8FitTo(name, query.wsearchedname))
-                    continue;
-            }
+        // IP locked auction
+        if (!auction->IsAvailableFor(clientIp))
+            return;
 
-            if (count < 50 && totalcount >= query.listfrom)
-            {
+        if (count < 50 && totalcount >= query.listfrom)
+            if (auction->BuildAuctionInfo(data))
                 ++count;
-                Aentry->BuildAuctionInfo(data);
-            }
-        }
 
         ++totalcount;
-    }
+    });
 }
 
 // this function inserts to WorldPacket auction's data
@@ -29,6 +29,7 @@
 #include "Policies/Singleton.h"
 #include "DBCStructure.h"
 #include "Log.h"
+#include "AuctionHouseIndex.h"
 
 class Item;
 class Player;
@@ -120,11 +121,7 @@ class AuctionHouseObject
 
         AuctionEntryMap *GetAuctions() { return &AuctionsMap; }
 
-        void AddAuction(AuctionEntry *ah)
-        {
-            MANGOS_ASSERT( ah );
-            AuctionsMap[ah->Id] = ah;
-        }
+        void AddAuction(AuctionEntry *ah);
 
         AuctionEntry* GetAuction(uint32 id) const
         {
@@ -143,6 +140,7 @@ class AuctionHouseObject
             uint32& count, uint32& totalcount);
     private:
         AuctionEntryMap AuctionsMap;
+        AuctionHouseIndex m_index;                          // search indexes, updated with AuctionsMap
 };
 
 class AuctionHouseMgr
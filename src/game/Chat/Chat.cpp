@@ -85,6 +85,7 @@ ChatCommand * ChatHandler::getCommandTable()
         { NODE, "stop",       SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleBotStopCommand,                  "", nullptr },
         { NODE, "start",      SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleBotStartCommand,                 "", nullptr },
         { NODE, "ranadd",     SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleBotAddRandomCommand,             "", nullptr },
+        { NODE, "loadtest",   SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleBotLoadTestCommand,              "", nullptr },
         { MSTR, nullptr,   0,                  false, nullptr,                                                "", nullptr },
     };
     static ChatCommand accountSetCommandTable[] =
@@ -269,6 +270,11 @@ ChatCommand * ChatHandler::getCommandTable()
         { NODE, "movemotion",     SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugMoveCommand,                "", nullptr },
         { NODE, "factionchange_items", SEC_ADMINISTRATOR, true, &ChatHandler::HandleFactionChangeItemsCommand,    "", nullptr },
         { NODE, "loottable",      SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleDebugLootTableCommand,           "", nullptr },
+        { NODE, "compression",    SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleDebugCompressionCommand,         "", nullptr },
+        { NODE, "mapqueue",       SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleDebugMapQueueCommand,            "", nullptr },
+        { NODE, "logstats",       SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleDebugLogStatsCommand,            "", nullptr },
+        { NODE, "charsaves",      SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleDebugCharSavesCommand,           "", nullptr },
+        { NODE, "pools",          SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleDebugPoolsCommand,               "", nullptr },
         { MSTR, nullptr,       0,                  false, nullptr,                                                "", nullptr }
     };
 
@@ -775,6 +781,7 @@ ChatCommand * ChatHandler::getCommandTable()
     static ChatCommand serverCommandTable[] =
     {
         { NODE, "corpses",        SEC_GAMEMASTER,     true,  &ChatHandler::HandleServerCorpsesCommand,       "", nullptr },
+        { NODE, "dbqueue",        SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleServerDbQueueCommand,       "", nullptr },
         { NODE, "exit",           SEC_CONSOLE,        true,  &ChatHandler::HandleServerExitCommand,          "", nullptr },
         { NODE, "idlerestart",    SEC_ADMINISTRATOR,  true, nullptr,                                           "", serverIdleRestartCommandTable },
         { NODE, "idleshutdown",   SEC_ADMINISTRATOR,  true, nullptr,                                           "", serverShutdownCommandTable },
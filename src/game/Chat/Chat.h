@@ -184,6 +184,11 @@ class MANGOS_DLL_SPEC ChatHandler
         bool HandleDebugExp(char* );
         bool HandleVideoTurn(char* );
         bool HandleDebugLootTableCommand(char*);
+        bool HandleDebugCompressionCommand(char*);
+        bool HandleDebugMapQueueCommand(char*);
+        bool HandleDebugLogStatsCommand(char*);
+        bool HandleDebugCharSavesCommand(char*);
+        bool HandleDebugPoolsCommand(char*);
         bool HandleServiceDeleteCharacters(char* args);
 
         bool HandleSpamerMute(char* args);
@@ -233,6 +238,7 @@ class MANGOS_DLL_SPEC ChatHandler
         bool HandleBotReloadCommand(char * args);
         bool HandleBotStopCommand(char * args);
         bool HandleBotStartCommand(char * args);
+        bool HandleBotLoadTestCommand(char* args);
 
         // spell_disabled
         bool HandleReloadSpellDisabledCommand(char *args);
@@ -738,6 +744,7 @@ class MANGOS_DLL_SPEC ChatHandler
         bool HandleSendMassMoneyCommand(char* args);
 
         bool HandleServerCorpsesCommand(char* args);
+        bool HandleServerDbQueueCommand(char* args);
         bool HandleServerExitCommand(char* args);
         bool HandleServerIdleRestartCommand(char* args);
         bool HandleServerIdleShutDownCommand(char* args);
@@ -4906,9 +4906,10 @@ bool ChatHandler::HandleResetAllCommand(char* args)
     }
 
     CharacterDatabase.PExecute("UPDATE characters SET at_login = at_login | '%u' WHERE (at_login & '%u') = '0'", atLogin, atLogin);
-    HashMapHolder<Player>::MapType const& plist = sObjectAccessor.GetPlayers();
-    for (HashMapHolder<Player>::MapType::const_iterator itr = plist.begin(); itr != plist.end(); ++itr)
-        itr->second->SetAtLoginFlag(atLogin);
+    std::vector<Player*> players;
+    ObjectAccessor::GetPlayers(players);
+    for (Player* player : players)
+        player->SetAtLoginFlag(atLogin);
 
     return true;
 }
@@ -6173,6 +6174,26 @@ bool ChatHandler::HandleServerPLimitCommand(char *args)
     return true;
 }
 
+static void ShowDatabaseQueueStats(ChatHandler* handler, char const* name, Database& db)
+{
+    handler->PSendSysMessage("%s: %u queued operations, %u workers, batch size %u", name, db.GetDelayQueueSize(), db.GetAsyncWorkersCount(), db.GetAsyncBatchSize());
+    for (uint32 i = 0; i < db.GetAsyncWorkersCount(); ++i)
+    {
+        SqlDelayThread::Stats stats = db.GetAsyncWorkerStats(i);
+        handler->PSendSysMessage("  Worker %u: %u serial queued, " UI64FMTD " executed (" UI64FMTD " in " UI64FMTD " batches), busy " UI64FMTD "ms",
+            i, db.GetSerialDelayQueueSize(i), stats.executedOps, stats.batchedOps, stats.batches, stats.busyTime);
+    }
+}
+
+bool ChatHandler::HandleServerDbQueueCommand(char* /*args*/)
+{
+    ShowDatabaseQueueStats(this, "World", WorldDatabase);
+    ShowDatabaseQueueStats(this, "Characters", CharacterDatabase);
+    ShowDatabaseQueueStats(this, "Login", LoginDatabase);
+    ShowDatabaseQueueStats(this, "Logs", LogsDatabase);
+    return true;
+}
+
 bool ChatHandler::HandleCastCommand(char* args)
 {
     if (!*args)
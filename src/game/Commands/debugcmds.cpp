@@ -36,6 +36,12 @@
 #include "ObjectGuid.h"
 #include "SpellMgr.h"
 #include "World.h"
+#include "UpdateData.h"
+#include "MapWorkQueue.h"
+#include "PlayerSaveScheduler.h"
+#include "Utilities/ObjectPool.h"
+#include <zlib/zlib.h>
+#include <chrono>
 
 bool ChatHandler::HandleDebugSendSpellFailCommand(char* args)
 {
@@ -1275,3 +1281,154 @@ bool ChatHandler::HandleDebugSpellModsCommand(char* args)
 
     return true;
 }
+
+bool ChatHandler::HandleDebugCompressionCommand(char* args)
+{
+    uint32 level = sWorld.getConfig(CONFIG_UINT32_COMPRESSION);
+    if (*args && (!ExtractUInt32(&args, level) || level < 1 || level > 9))
+        return false;
+
+    std::vector<std::vector<uint8> > samples;
+    PacketCompressor::GetSamples(samples);
+    if (samples.empty())
+    {
+        SendSysMessage("No update packet sampled yet.");
+        SetSentErrorMessage(true);
+        return false;
+    }
+
+    uint64 inputSize = 0;
+    for (auto const& sample : samples)
+        inputSize += sample.size();
+    PSendSysMessage("Compressing %u sampled update packets (%u bytes) at level %u:", uint32(samples.size()), uint32(inputSize), level);
+
+    static char const* strategyNames[] = { "default", "filtered", "huffman", "rle" };
+    uint32 const passes = 20;
+    std::vector<uint8> output;
+    for (uint32 strategy = 0; strategy < 4; ++strategy)
+    {
+        uint64 outputSize = 0;
+        auto begin = std::chrono::steady_clock::now();
+        for (uint32 pass = 0; pass < passes; ++pass)
+        {
+            for (auto& sample : samples)
+            {
+                uint32 destSize = compressBound(sample.size());
+                output.resize(destSize);
+                PacketCompressor::Compress(output.data(), &destSize, sample.data(), sample.size(), level, strategy);
+                if (!pass)
+                    outputSize += destSize;
+            }
+        }
+        uint64 elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count();
+        if (!elapsedUs)
+            elapsedUs = 1;
+
+        PSendSysMessage("%-8s: %.1f MB/s, ratio %.2f%s", strategyNames[strategy],
+                        double(inputSize * passes) / double(elapsedUs), double(outputSize) / double(inputSize),
+                        strategy == sWorld.getConfig(CONFIG_UINT32_COMPRESSION_STRATEGY) && level == sWorld.getConfig(CONFIG_UINT32_COMPRESSION) ? " (current)" : "");
+    }
+    return true;
+}
+
+struct MapQueueBenchObject
+{
+    uint32 slot;
+};
+
+// Returns the time in us taken to fill 'queue' with 'objects' (each queued twice,
+// like objects changing several fields in a tick), iterate and clear it.
+template <class Queue>
+static uint64 BenchmarkMapQueue(Queue& queue, std::vector<MapQueueBenchObject>& objects, uint32 passes, uint64& checksum)
+{
+    auto begin = std::chrono::steady_clock::now();
+    for (uint32 pass = 0; pass < passes; ++pass)
+    {
+        for (auto& obj : objects)
+            queue.insert(&obj);
+        for (auto& obj : objects)
+            queue.insert(&obj);
+        for (auto obj : queue)
+            checksum += obj->slot;
+        queue.clear();
+    }
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count();
+}
+
+bool ChatHandler::HandleDebugMapQueueCommand(char* args)
+{
+    uint32 count = 10000;
+    if (*args && (!ExtractUInt32(&args, count) || !count || count > 1000000))
+        return false;
+
+    uint32 const passes = 100;
+    std::vector<MapQueueBenchObject> objects(count);
+    for (uint32 i = 0; i < count; ++i)
+        objects[i].slot = i;
+
+    uint64 checksum = 0;
+    std::set<MapQueueBenchObject*> set;
+    uint64 setTime = BenchmarkMapQueue(set, objects, passes, checksum);
+    MapWorkQueue<MapQueueBenchObject, MapQueueBenchObject, &MapQueueBenchObject::slot> queue;
+    uint64 queueTime = BenchmarkMapQueue(queue, objects, passes, checksum);
+
+    PSendSysMessage("%u objects, %u x (2 inserts each, iterate, clear):", count, passes);
+    PSendSysMessage("std::set     : %u us/pass", uint32(setTime / passes));
+    PSendSysMessage("MapWorkQueue : %u us/pass", uint32(queueTime / passes));
+    return true;
+}
+
+bool ChatHandler::HandleDebugLogStatsCommand(char* /*args*/)
+{
+    AsyncLogStats stats;
+    if (!sLog.GetAsyncStats(stats))
+    {
+        SendSysMessage("Asynchronous logging is disabled (Log.Async).");
+        return true;
+    }
+
+    PSendSysMessage("Log lines: " UI64FMTD " queued, " UI64FMTD " pending, " UI64FMTD " dropped",
+                    stats.queued, stats.queued - stats.written, stats.dropped);
+    return true;
+}
+
+bool ChatHandler::HandleDebugCharSavesCommand(char* /*args*/)
+{
+    PlayerSaveStats stats;
+    Player::GetSaveStats(stats);
+
+    PSendSysMessage("Character saves: " UI64FMTD, stats.saves);
+    PSendSysMessage("Rows: " UI64FMTD " written, " UI64FMTD " deleted, " UI64FMTD " unchanged",
+                    stats.rowsWritten, stats.rowsDeleted, stats.rowsSkipped);
+    if (stats.saves)
+        PSendSysMessage("Per save: %.1f written, %.1f deleted, %.1f unchanged", double(stats.rowsWritten) / stats.saves,
+                        double(stats.rowsDeleted) / stats.saves, double(stats.rowsSkipped) / stats.saves);
+
+    PlayerSaveSchedulerStats schedulerStats;
+    sPlayerSaveScheduler.GetStats(schedulerStats);
+    PSendSysMessage("Periodic saves: " UI64FMTD " scheduled, " UI64FMTD " forced, " UI64FMTD " deferred, %i available",
+                    schedulerStats.periodicSaves, schedulerStats.forcedSaves, schedulerStats.deferredSaves, schedulerStats.budget);
+    PSendSysMessage("Ticks without saves (DB queue %u, max %u): " UI64FMTD, CharacterDatabase.GetDelayQueueSize(),
+                    sWorld.getConfig(CONFIG_UINT32_PLAYER_SAVE_MAX_QUEUE_SIZE), schedulerStats.throttledTicks);
+    return true;
+}
+
+bool ChatHandler::HandleDebugPoolsCommand(char* /*args*/)
+{
+    std::vector<ObjectPoolStats> pools;
+    ObjectPoolBase::GetAllStats(pools);
+    if (pools.empty())
+    {
+        SendSysMessage("No pooled object allocated yet.");
+        return true;
+    }
+
+    for (ObjectPoolStats const& pool : pools)
+    {
+        PSendSysMessage("%s (%u bytes): " SI64FMTD " in use / %u in %u slabs (%u KB), %u shared free",
+                        pool.name, pool.objectSize, pool.inUse, pool.capacity, pool.slabs,
+                        uint32(uint64(pool.capacity) * pool.objectSize / 1024), pool.sharedFree);
+        PSendSysMessage("    " UI64FMTD " allocations, " UI64FMTD " derived class allocations not pooled", pool.allocations, pool.fallbacks);
+    }
+    return true;
+}
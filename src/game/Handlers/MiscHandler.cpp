@@ -105,11 +105,10 @@ public:
         data << uint32(clientcount);                            // clientcount place holder, listed count
         data << uint32(clientcount);                            // clientcount place holder, online count
 
-        // TODO: Guard Player map
-        HashMapHolder<Player>::MapType& m = sObjectAccessor.GetPlayers();
-        for (HashMapHolder<Player>::MapType::const_iterator itr = m.begin(); itr != m.end(); ++itr)
+        std::vector<Player*> players;
+        ObjectAccessor::GetPlayers(players);
+        for (Player* pl : players)
         {
-            Player* pl = itr->second;
 
             if (security == SEC_PLAYER)
             {
@@ -218,7 +217,7 @@ public:
                 break;
         }
 
-        uint32 count = m.size();
+        uint32 count = players.size();
         data.put(0, clientcount);                               // insert right count, listed count
         data.put(4, count > 49 ? count : clientcount);          // insert right count, online count
 
@@ -1187,10 +1187,10 @@ void ScourgeInvasionEvent::UpdateWorldState()
         // If its all the same we dont need to update players
         return;
     }
-    HashMapHolder<Player>::MapType& m = sObjectAccessor.GetPlayers();
-    for (HashMapHolder<Player>::MapType::const_iterator itr = m.begin(); itr != m.end(); ++itr)
+    std::vector<Player*> players;
+    ObjectAccessor::GetPlayers(players);
+    for (Player* pl : players)
     {
-        Player* pl = itr->second;
         // do not process players which are not in world
         if (!pl->IsInWorld())
             continue;
@@ -26,10 +26,12 @@
 #include "GridMap.h"
 #include "VMapFactory.h"
 #include "MoveMap.h"
+#include "MapTree.h"
 #include "World.h"
 #include "Policies/SingletonImp.h"
 #include "Util.h"
 #include "SQLStorages.h"
+#include "MappedFile.h"
 
 char const* MAP_MAGIC         = "MAPS";
 char const* MAP_VERSION_MAGIC = "z1.3";
@@ -37,9 +39,65 @@ char const* MAP_AREA_MAGIC    = "AREA";
 char const* MAP_HEIGHT_MAGIC  = "MHGT";
 char const* MAP_LIQUID_MAGIC  = "MLIQ";
 
+/*
+ * Source of GridMap::loadData: stdio (arrays are copied in new[] buffers)
+ * or a mapped file (arrays point directly in the mapping, shared with other processes).
+ */
+class GridMapFileReader
+{
+    public:
+        explicit GridMapFileReader(FILE* file) : m_file(file), m_mapped(nullptr), m_pos(0) {}
+        explicit GridMapFileReader(MappedFile const* mapped) : m_file(nullptr), m_mapped(mapped), m_pos(0) {}
+
+        void Seek(uint32 offset)
+        {
+            if (m_file)
+                fseek(m_file, offset, SEEK_SET);
+            else
+                m_pos = offset;
+        }
+
+        bool Read(void* dest, size_t size)
+        {
+            if (m_file)
+                return fread(dest, size, 1, m_file) == 1;
+
+            if (m_pos + size > m_mapped->GetSize())
+                return false;
+            memcpy(dest, m_mapped->GetData() + m_pos, size);
+            m_pos += size;
+            return true;
+        }
+
+        // Returns a new[] array or a pointer in the mapping (read only, never deleted)
+        template <class T>
+        T* ReadArray(size_t count)
+        {
+            if (m_file)
+            {
+                T* data = new T[count];
+                fread(data, sizeof(T), count, m_file);
+                return data;
+            }
+
+            size_t size = sizeof(T) * count;
+            if (m_pos + size > m_mapped->GetSize())
+                return nullptr;
+            T* data = reinterpret_cast<T*>(m_mapped->GetData() + m_pos);
+            m_pos += size;
+            return data;
+        }
+
+    private:
+        FILE* m_file;
+        MappedFile const* m_mapped;
+        size_t m_pos;
+};
+
 GridMap::GridMap()
 {
     m_flags = 0;
+    m_mappedFile = nullptr;
 
     // Area data
     m_gridArea = 0;
@@ -74,57 +132,67 @@ bool GridMap::loadData(char* filename)
     // Unload old data if exist
     unloadData();
 
-    GridMapFileHeader header;
+    FILE* in = nullptr;
+    if (sWorld.getConfig(CONFIG_BOOL_TERRAIN_MMAP))
+    {
+        m_mappedFile = new MappedFile();
+        // Not return error if file not found
+        if (!m_mappedFile->Open(filename))
+        {
+            delete m_mappedFile;
+            m_mappedFile = nullptr;
+            return true;
+        }
+    }
     // Not return error if file not found
-    FILE* in = fopen(filename, "rb");
-    if (!in)
+    else if (!(in = fopen(filename, "rb")))
         return true;
 
-    fread(&header, sizeof(header), 1, in);
-    if (header.mapMagic     == *((uint32 const*)(MAP_MAGIC)) &&
+    GridMapFileReader reader = in ? GridMapFileReader(in) : GridMapFileReader(m_mappedFile);
+    bool result = false;
+
+    GridMapFileHeader header;
+    if (reader.Read(&header, sizeof(header)) &&
+            header.mapMagic     == *((uint32 const*)(MAP_MAGIC)) &&
             header.versionMagic == *((uint32 const*)(MAP_VERSION_MAGIC)))
     {
         // loadup area data
-        if (header.areaMapOffset && !loadAreaData(in, header.areaMapOffset, header.areaMapSize))
-        {
+        if (header.areaMapOffset && !loadAreaData(reader, header.areaMapOffset, header.areaMapSize))
             sLog.outError("Error loading map area data\n");
-            fclose(in);
-            return false;
-        }
-
         // loadup height data
-        if (header.heightMapOffset && !loadHeightData(in, header.heightMapOffset, header.heightMapSize))
-        {
+        else if (header.heightMapOffset && !loadHeightData(reader, header.heightMapOffset, header.heightMapSize))
             sLog.outError("Error loading map height data\n");
-            fclose(in);
-            return false;
-        }
-
         // loadup liquid data
-        if (header.liquidMapOffset && !loadGridMapLiquidData(in, header.liquidMapOffset, header.liquidMapSize))
-        {
+        else if (header.liquidMapOffset && !loadGridMapLiquidData(reader, header.liquidMapOffset, header.liquidMapSize))
             sLog.outError("Error loading map liquids data\n");
-            fclose(in);
-            return false;
-        }
-
-        fclose(in);
-        return true;
+        else
+            result = true;
     }
+    else
+        sLog.outError("Map file '%s' is non-compatible version (outdated?). Please, create new using ad.exe program.", filename);
 
-    sLog.outError("Map file '%s' is non-compatible version (outdated?). Please, create new using ad.exe program.", filename);
-    fclose(in);
-    return false;
+    if (in)
+        fclose(in);
+    return result;
 }
 
 void GridMap::unloadData()
 {
-    delete[] m_area_map;
-    delete[] m_V9;
-    delete[] m_V8;
-    delete[] m_liquidEntry;
-    delete[] m_liquidFlags;
-    delete[] m_liquid_map;
+    // mapped arrays are released with the mapping
+    if (m_mappedFile)
+    {
+        delete m_mappedFile;
+        m_mappedFile = nullptr;
+    }
+    else
+    {
+        delete[] m_area_map;
+        delete[] m_V9;
+        delete[] m_V8;
+        delete[] m_liquidEntry;
+        delete[] m_liquidFlags;
+        delete[] m_liquid_map;
+    }
 
     m_area_map = NULL;
     m_V9 = NULL;
@@ -135,30 +203,28 @@ void GridMap::unloadData()
     m_gridGetHeight = &GridMap::getHeightFromFlat;
 }
 
-bool GridMap::loadAreaData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadAreaData(GridMapFileReader& in, uint32 offset, uint32 /*size*/)
 {
     GridMapAreaHeader header;
-    fseek(in, offset, SEEK_SET);
-    fread(&header, sizeof(header), 1, in);
-    if (header.fourcc != *((uint32 const*)(MAP_AREA_MAGIC)))
+    in.Seek(offset);
+    if (!in.Read(&header, sizeof(header)) || header.fourcc != *((uint32 const*)(MAP_AREA_MAGIC)))
         return false;
 
     m_gridArea = header.gridArea;
     if (!(header.flags & MAP_AREA_NO_AREA))
     {
-        m_area_map = new uint16 [16 * 16];
-        fread(m_area_map, sizeof(uint16), 16 * 16, in);
+        if (!(m_area_map = in.ReadArray<uint16>(16 * 16)))
+            return false;
     }
 
     return true;
 }
 
-bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadHeightData(GridMapFileReader& in, uint32 offset, uint32 /*size*/)
 {
     GridMapHeightHeader header;
-    fseek(in, offset, SEEK_SET);
-    fread(&header, sizeof(header), 1, in);
-    if (header.fourcc != *((uint32 const*)(MAP_HEIGHT_MAGIC)))
+    in.Seek(offset);
+    if (!in.Read(&header, sizeof(header)) || header.fourcc != *((uint32 const*)(MAP_HEIGHT_MAGIC)))
         return false;
 
     m_gridHeight = header.gridHeight;
@@ -166,30 +232,31 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
     {
         if ((header.flags & MAP_HEIGHT_AS_INT16))
         {
-            m_uint16_V9 = new uint16 [129 * 129];
-            m_uint16_V8 = new uint16 [128 * 128];
-            fread(m_uint16_V9, sizeof(uint16), 129 * 129, in);
-            fread(m_uint16_V8, sizeof(uint16), 128 * 128, in);
+            m_uint16_V9 = in.ReadArray<uint16>(129 * 129);
+            m_uint16_V8 = in.ReadArray<uint16>(128 * 128);
             m_gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 65535;
             m_gridGetHeight = &GridMap::getHeightFromUint16;
         }
         else if ((header.flags & MAP_HEIGHT_AS_INT8))
         {
-            m_uint8_V9 = new uint8 [129 * 129];
-            m_uint8_V8 = new uint8 [128 * 128];
-            fread(m_uint8_V9, sizeof(uint8), 129 * 129, in);
-            fread(m_uint8_V8, sizeof(uint8), 128 * 128, in);
+            m_uint8_V9 = in.ReadArray<uint8>(129 * 129);
+            m_uint8_V8 = in.ReadArray<uint8>(128 * 128);
             m_gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 255;
             m_gridGetHeight = &GridMap::getHeightFromUint8;
         }
         else
         {
-            m_V9 = new float [129 * 129];
-            m_V8 = new float [128 * 128];
-            fread(m_V9, sizeof(float), 129 * 129, in);
-            fread(m_V8, sizeof(float), 128 * 128, in);
+            m_V9 = in.ReadArray<float>(129 * 129);
+            m_V8 = in.ReadArray<float>(128 * 128);
             m_gridGetHeight = &GridMap::getHeightFromFloat;
         }
+
+        // truncated mapped file
+        if (!m_V9 || !m_V8)
+        {
+            m_gridGetHeight = &GridMap::getHeightFromFlat;
+            return false;
+        }
     }
     else
         m_gridGetHeight = &GridMap::getHeightFromFlat;
@@ -197,12 +264,11 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
     return true;
 }
 
-bool GridMap::loadGridMapLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadGridMapLiquidData(GridMapFileReader& in, uint32 offset, uint32 /*size*/)
 {
     GridMapLiquidHeader header;
-    fseek(in, offset, SEEK_SET);
-    fread(&header, sizeof(header), 1, in);
-    if (header.fourcc != *((uint32 const*)(MAP_LIQUID_MAGIC)))
+    in.Seek(offset);
+    if (!in.Read(&header, sizeof(header)) || header.fourcc != *((uint32 const*)(MAP_LIQUID_MAGIC)))
         return false;
 
     m_liquidType    = header.liquidType;
@@ -214,17 +280,16 @@ bool GridMap::loadGridMapLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
 
     if (!(header.flags & MAP_LIQUID_NO_TYPE))
     {
-        m_liquidEntry = new uint16[16 * 16];
-        fread(m_liquidEntry, sizeof(uint16), 16 * 16, in);
-
-        m_liquidFlags = new uint8[16 * 16];
-        fread(m_liquidFlags, sizeof(uint8), 16 * 16, in);
+        m_liquidEntry = in.ReadArray<uint16>(16 * 16);
+        m_liquidFlags = in.ReadArray<uint8>(16 * 16);
+        if (!m_liquidEntry || !m_liquidFlags)
+            return false;
     }
 
     if (!(header.flags & MAP_LIQUID_NO_HEIGHT))
     {
-        m_liquid_map = new float [m_liquid_width * m_liquid_height];
-        fread(m_liquid_map, sizeof(float), m_liquid_width * m_liquid_height, in);
+        if (!(m_liquid_map = in.ReadArray<float>(m_liquid_width * m_liquid_height)))
+            return false;
     }
 
     return true;
@@ -662,6 +727,8 @@ TerrainInfo::TerrainInfo(uint32 mapid) : m_mapId(mapid)
         {
             m_GridMaps[i][k] = NULL;
             m_GridRef[i][k] = 0;
+            m_PrefetchedGridMaps[i][k].gridMap = NULL;
+            m_PrefetchedGridMaps[i][k].old = false;
         }
     }
 
@@ -685,7 +752,10 @@ TerrainInfo::~TerrainInfo()
 {
     for (int k = 0; k < MAX_NUMBER_OF_GRIDS; ++k)
         for (int i = 0; i < MAX_NUMBER_OF_GRIDS; ++i)
+        {
             delete m_GridMaps[i][k];
+            delete m_PrefetchedGridMaps[i][k].gridMap;
+        }
 
     VMAP::VMapFactory::createOrGetVMapManager()->unloadMap(m_mapId);
     MMAP::MMapFactory::createOrGetMMapManager()->unloadMap(m_mapId);
@@ -754,6 +824,29 @@ void TerrainInfo::CleanUpGrids(const uint32 diff)
         }
     }
 
+    {
+        LOCK_GUARD lock(m_mutex);
+        for (int y = 0; y < MAX_NUMBER_OF_GRIDS; ++y)
+        {
+            for (int x = 0; x < MAX_NUMBER_OF_GRIDS; ++x)
+            {
+                PrefetchedGridMap& prefetched = m_PrefetchedGridMaps[x][y];
+                if (!prefetched.gridMap)
+                    continue;
+
+                // players changed their way
+                if (prefetched.old)
+                {
+                    prefetched.gridMap->unloadData();
+                    delete prefetched.gridMap;
+                    prefetched.gridMap = NULL;
+                }
+                else
+                    prefetched.old = true;
+            }
+        }
+    }
+
     i_timer.Reset();
 }
 
@@ -1123,20 +1216,12 @@ GridMap* TerrainInfo::LoadMapAndVMap(const uint32 x, const uint32 y)
 
         if (!m_GridMaps[x][y])
         {
-            GridMap* map = new GridMap();
-
-            // map file name
-            int len = sWorld.GetDataPath().length() + strlen("maps/%03u%02u%02u.map") + 1;
-            char* tmp = new char[len];
-            snprintf(tmp, len, (char*)(sWorld.GetDataPath() + "maps/%03u%02u%02u.map").c_str(), m_mapId, x, y);
-
-            if (!map->loadData(tmp))
-            {
-                sLog.outError("Error load map file: \n %s\n", tmp);
-                // ASSERT(false);
-            }
+            GridMap* map = m_PrefetchedGridMaps[x][y].gridMap;
+            if (map)
+                m_PrefetchedGridMaps[x][y].gridMap = NULL;
+            else
+                map = LoadGridMap(x, y);
 
-            delete[] tmp;
             m_GridMaps[x][y] = map;
 
             // load VMAPs for current map/grid...
@@ -1164,6 +1249,76 @@ GridMap* TerrainInfo::LoadMapAndVMap(const uint32 x, const uint32 y)
     return  m_GridMaps[x][y];
 }
 
+GridMap* TerrainInfo::LoadGridMap(const uint32 x, const uint32 y) const
+{
+    GridMap* map = new GridMap();
+
+    // map file name
+    int len = sWorld.GetDataPath().length() + strlen("maps/%03u%02u%02u.map") + 1;
+    char* tmp = new char[len];
+    snprintf(tmp, len, (char*)(sWorld.GetDataPath() + "maps/%03u%02u%02u.map").c_str(), m_mapId, x, y);
+
+    if (!map->loadData(tmp))
+    {
+        sLog.outError("Error load map file: \n %s\n", tmp);
+        // ASSERT(false);
+    }
+
+    delete[] tmp;
+    return map;
+}
+
+// Reads the whole file so the map thread later finds it in the page cache
+static void WarmFile(std::string const& fileName)
+{
+    FILE* file = fopen(fileName.c_str(), "rb");
+    if (!file)
+        return;
+
+    char buffer[64 * 1024];
+    while (fread(buffer, 1, sizeof(buffer), file) == sizeof(buffer))
+        ;
+    fclose(file);
+}
+
+void TerrainInfo::Prefetch(const uint32 x, const uint32 y)
+{
+    MANGOS_ASSERT(x < MAX_NUMBER_OF_GRIDS);
+    MANGOS_ASSERT(y < MAX_NUMBER_OF_GRIDS);
+
+    if (IsPrefetched(x, y))
+        return;
+
+    // file reads without the lock, map threads keep loading other grids meanwhile
+    GridMap* map = LoadGridMap(x, y);
+
+    if (VMAP::VMapFactory::createOrGetVMapManager()->isMapLoadingEnabled())
+        WarmFile(sWorld.GetDataPath() + "vmaps/" + VMAP::StaticMapTree::getTileFileName(m_mapId, x, y));
+
+    char mmapTile[32];
+    snprintf(mmapTile, sizeof(mmapTile), "mmaps/%03u%02u%02u.mmtile", m_mapId, x, y);
+    WarmFile(sWorld.GetDataPath() + mmapTile);
+
+    LOCK_GUARD lock(m_mutex);
+    if (!m_GridMaps[x][y] && !m_PrefetchedGridMaps[x][y].gridMap)
+    {
+        m_PrefetchedGridMaps[x][y].gridMap = map;
+        m_PrefetchedGridMaps[x][y].old = false;
+    }
+    else
+    {
+        // loaded by a map in the meantime
+        map->unloadData();
+        delete map;
+    }
+}
+
+bool TerrainInfo::IsPrefetched(const uint32 x, const uint32 y)
+{
+    LOCK_GUARD lock(m_mutex);
+    return m_GridMaps[x][y] || m_PrefetchedGridMaps[x][y].gridMap;
+}
+
 float TerrainInfo::GetWaterLevel(float x, float y, float z, float* pGround /*= NULL*/) const
 {
     if (const_cast<TerrainInfo*>(this)->GetGrid(x, y))
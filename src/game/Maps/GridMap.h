@@ -36,6 +36,8 @@ class InstanceData;
 class Group;
 class BattleGround;
 class Map;
+class MappedFile;
+class GridMapFileReader;
 
 struct GridMapFileHeader
 {
@@ -153,9 +155,12 @@ class GridMap
         uint8* m_liquidFlags;
         float* m_liquid_map;
 
-        bool loadAreaData(FILE* in, uint32 offset, uint32 size);
-        bool loadHeightData(FILE* in, uint32 offset, uint32 size);
-        bool loadGridMapLiquidData(FILE* in, uint32 offset, uint32 size);
+        // Terrain.MMap: arrays above point in the mapped file instead of new[] buffers
+        MappedFile* m_mappedFile;
+
+        bool loadAreaData(GridMapFileReader& in, uint32 offset, uint32 size);
+        bool loadHeightData(GridMapFileReader& in, uint32 offset, uint32 size);
+        bool loadGridMapLiquidData(GridMapFileReader& in, uint32 offset, uint32 size);
 
         // Get height functions and pointers
         typedef float(GridMap::*pGetHeightPtr)(float x, float y) const;
@@ -240,6 +245,14 @@ class MANGOS_DLL_SPEC TerrainInfo : public Referencable<AtomicLong>
 
 
         void LoadAll();
+
+        // Called by the terrain loader thread for grids players are about to enter.
+        // The .map file is parsed and kept aside until the grid is loaded, vmap and
+        // navmesh tiles are only read to warm the page cache: they are inserted by
+        // the map thread, as their trees can not change during queries.
+        void Prefetch(const uint32 x, const uint32 y);
+        bool IsPrefetched(const uint32 x, const uint32 y);
+
         // this method should be used only by TerrainManager
         // to cleanup unreferenced GridMap objects - they are too heavy
         // to destroy them dynamically, especially on highly populated servers
@@ -258,6 +271,7 @@ class MANGOS_DLL_SPEC TerrainInfo : public Referencable<AtomicLong>
 
         GridMap* GetGrid(const float x, const float y);
         GridMap* LoadMapAndVMap(const uint32 x, const uint32 y);
+        GridMap* LoadGridMap(const uint32 x, const uint32 y) const;
 
         int RefGrid(const uint32& x, const uint32& y);
         int UnrefGrid(const uint32& x, const uint32& y);
@@ -267,6 +281,15 @@ class MANGOS_DLL_SPEC TerrainInfo : public Referencable<AtomicLong>
         GridMap* m_GridMaps[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
         int16 m_GridRef[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
 
+        // Prefetched and not loaded yet, protected by m_mutex. Dropped at the
+        // second clean up if the grid was never loaded.
+        struct PrefetchedGridMap
+        {
+            GridMap* gridMap;
+            bool old;
+        };
+        PrefetchedGridMap m_PrefetchedGridMaps[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
+
         // global garbage collection timer
         ShortIntervalTimer i_timer;
 
@@ -138,7 +138,7 @@ MessageDeliverer::Visit(CameraMapType &m)
         if (i_toSelf || owner != &i_player)
         {
             if (WorldSession* session = owner->GetSession())
-                session->SendPacket(i_message);
+                session->SendPacket(i_message, &i_shared);
         }
     }
 }
@@ -153,7 +153,7 @@ void MessageDelivererExcept::Visit(CameraMapType &m)
             continue;
 
         if (WorldSession* session = owner->GetSession())
-            session->SendPacket(i_message);
+            session->SendPacket(i_message, &i_shared);
     }
 }
 
@@ -164,7 +164,7 @@ ObjectMessageDeliverer::Visit(CameraMapType &m)
     for (CameraMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
         if (WorldSession* session = iter->getSource()->GetOwner()->GetSession())
-            session->SendPacket(i_message);
+            session->SendPacket(i_message, &i_shared);
     }
 }
 
@@ -180,7 +180,7 @@ MessageDistDeliverer::Visit(CameraMapType &m)
                 (!i_dist || iter->getSource()->GetBody()->IsWithinDist(&i_player, i_dist)))
         {
             if (WorldSession* session = owner->GetSession())
-                session->SendPacket(i_message);
+                session->SendPacket(i_message, &i_shared);
         }
     }
 }
@@ -193,7 +193,7 @@ ObjectMessageDistDeliverer::Visit(CameraMapType &m)
         if (!i_dist || iter->getSource()->GetBody()->IsWithinDist(&i_object, i_dist))
         {
             if (WorldSession* session = iter->getSource()->GetOwner()->GetSession())
-                session->SendPacket(i_message);
+                session->SendPacket(i_message, &i_shared);
         }
     }
 }
@@ -65,6 +65,7 @@ namespace MaNGOS
     {
         Player &i_player;
         WorldPacket *i_message;
+        SharedWorldPacket i_shared;                         // single copy of a big packet, queued by every socket
         bool i_toSelf;
         MessageDeliverer(Player &pl, WorldPacket *msg, bool to_self) : i_player(pl), i_message(msg), i_toSelf(to_self) {}
         void Visit(CameraMapType &m);
@@ -74,6 +75,7 @@ namespace MaNGOS
     struct MessageDelivererExcept
     {
         WorldPacket*  i_message;
+        SharedWorldPacket i_shared;
         Player const* i_skipped_receiver;
 
         MessageDelivererExcept(WorldPacket *msg, Player const* skipped)
@@ -86,6 +88,7 @@ namespace MaNGOS
     struct MANGOS_DLL_DECL ObjectMessageDeliverer
     {
         WorldPacket *i_message;
+        SharedWorldPacket i_shared;
         explicit ObjectMessageDeliverer(WorldPacket *msg) : i_message(msg) {}
         void Visit(CameraMapType &m);
         template<class SKIP> void Visit(GridRefManager<SKIP> &) {}
@@ -95,6 +98,7 @@ namespace MaNGOS
     {
         Player &i_player;
         WorldPacket *i_message;
+        SharedWorldPacket i_shared;
         bool i_toSelf;
         bool i_ownTeamOnly;
         float i_dist;
@@ -109,6 +113,7 @@ namespace MaNGOS
     {
         WorldObject &i_object;
         WorldPacket *i_message;
+        SharedWorldPacket i_shared;
         float i_dist;
         ObjectMessageDistDeliverer(WorldObject &obj, WorldPacket *msg, float dist) : i_object(obj), i_message(msg), i_dist(dist) {}
         void Visit(CameraMapType &m);
@@ -60,8 +60,10 @@ Map::~Map()
 {
     UnloadAll(true);
 
-    if (!m_scriptSchedule.empty())
-        sScriptMgr.DecreaseScheduledScriptCount(m_scriptSchedule.size());
+    FlushScriptQueue();
+    m_scriptSchedule.KillAllEvents(true);
+    if (uint64 pending = GetScriptStepsPending())
+        sScriptMgr.DecreaseScheduledScriptCount(pending);
 
     if (m_persistentState)
         m_persistentState->SetUsedByMapState(NULL);         // field pointer can be deleted after this
@@ -93,13 +95,14 @@ Map::Map(uint32 id, time_t expiry, uint32 InstanceId)
       m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE), m_persistentState(NULL),
       m_activeNonPlayersIter(m_activeNonPlayers.end()), _transportsUpdateIter(_transports.end()),
       i_gridExpiry(expiry), m_TerrainData(sTerrainMgr.LoadTerrain(id)),
+      m_scriptQueue(nullptr), m_scriptStepsScheduled(0), m_scriptStepsExecuted(0), m_scriptStepsTerminated(0),
       i_data(NULL), i_script_id(0), m_unloading(false), m_crashed(false),
       _processingSendObjUpdates(false), _processingUnitsRelocation(false),
       m_updateFinished(false), m_updateDiffMod(0), m_GridActivationDistance(DEFAULT_VISIBILITY_DISTANCE),
       _lastPlayersUpdate(WorldTimer::getMSTime()), _lastMapUpdate(WorldTimer::getMSTime()),
       _lastCellsUpdate(WorldTimer::getMSTime()), _inactivePlayersSkippedUpdates(0),
-      _objUpdatesThreads(0), _unitRelocationThreads(0), _lastPlayerLeftTime(0),
-      m_lastMvtSpellsUpdate(0)
+      _objUpdatesThreads(0), _unitRelocationThreads(0), _unitsMvtUpdated(0), _unitsMvtUpdateThreads(0), _lastPlayerLeftTime(0),
+      m_lastMvtSpellsUpdate(0), m_gridPrefetchTimer(0)
 {
     m_CreatureGuids.Set(sObjectMgr.GetFirstTemporaryCreatureLowGuid());
     m_GameObjectGuids.Set(sObjectMgr.GetFirstTemporaryGameObjectLowGuid());
@@ -730,27 +733,6 @@ inline void Map::UpdateActiveCellsSynch(uint32 now, uint32 diff)
     }
 }
 
-class UnitsMovementUpdater : public ACE_Based::Runnable
-{
-public:
-    UnitsMovementUpdater(int i, int nthreads, std::set<Unit*>& _updates, uint32 _diff) : threadIdx(i), nThreads(nthreads), updates(_updates), diff(_diff)
-    {
-    }
-
-    virtual void run()
-    {
-        int i = 0;
-        for (std::set<Unit*>::iterator iter = updates.begin(); iter != updates.end(); ++iter)
-            if (((++i) % nThreads) == threadIdx)
-                if ((*iter)->IsInWorld())
-                    (*iter)->GetMotionMaster()->UpdateMotionAsync(diff);
-    }
-    int threadIdx;
-    int nThreads;
-    std::set<Unit*>& updates;
-    uint32 diff;
-};
-
 inline void Map::UpdateCells(uint32 map_diff)
 {
     uint32 now = WorldTimer::getMSTime();
@@ -765,18 +747,30 @@ inline void Map::UpdateCells(uint32 map_diff)
     else
         UpdateActiveCellsSynch(now, diff);
 
-    int nthreads = sWorld.getConfig(CONFIG_UINT32_CONTINENTS_MOTIONUPDATE_THREADS);
-    if (IsContinent() && nthreads)
+    UpdateMotionAsync(diff);
+}
+
+// Paths requested by movement generators during the cells update (40 mobs
+// pulled at once ...) are computed here in one batch. Each pool thread keeps
+// its own navmesh queries, see MMapManager::GetNavMeshQuery.
+void Map::UpdateMotionAsync(uint32 diff)
+{
+    _unitsMvtUpdated = unitsMvtUpdate.size();
+    uint32 threads = GetMotionUpdateThreads();
+    if (!_unitsMvtUpdated || !threads)
     {
-        std::vector<ACE_Based::Thread*> threads;
-        for (int i = 0; i < nthreads; ++i)
-            threads.push_back(new ACE_Based::Thread(new UnitsMovementUpdater(i, nthreads, unitsMvtUpdate, diff)));
-        for (int i = 0; i < threads.size(); ++i)
-        {
-            threads[i]->wait();
-            delete threads[i];
-        }
+        unitsMvtUpdate.clear();
+        return;
     }
+
+    // Pathfinding cost is very uneven, small chunks keep the threads busy
+    _unitsMvtUpdateThreads = sMapMgr.GetJobPool().ParallelFor(_unitsMvtUpdated, 4, threads,
+        [&](uint32 /*slot*/, uint32 begin, uint32 end)
+        {
+            for (uint32 i = begin; i < end; ++i)
+                if (unitsMvtUpdate[i]->IsInWorld())
+                    unitsMvtUpdate[i]->GetMotionMaster()->UpdateMotionAsync(diff);
+        });
     unitsMvtUpdate.clear();
 }
 
@@ -814,6 +808,22 @@ void Map::UpdateSessionsMovementAndSpellsIfNeeded()
     m_lastMvtSpellsUpdate = WorldTimer::getMSTime();
 }
 
+uint32 Map::GetIdleUpdateDelay() const
+{
+    uint32 now = WorldTimer::getMSTime();
+    uint32 packetsDiff = sWorld.getConfig(CONFIG_UINT32_MAPUPDATE_UPDATE_PACKETS_DIFF);
+    uint32 playersDiff = sWorld.getConfig(CONFIG_UINT32_MAPUPDATE_UPDATE_PLAYERS_DIFF);
+    uint32 sincePackets = WorldTimer::getMSTimeDiff(m_lastMvtSpellsUpdate, now);
+    uint32 sincePlayers = WorldTimer::getMSTimeDiff(_lastPlayersUpdate, now);
+
+    uint32 delay = sincePackets < packetsDiff ? packetsDiff - sincePackets : 1;
+    if (sincePlayers < playersDiff)
+        delay = std::min(delay, playersDiff - sincePlayers);
+    else
+        delay = 1;
+    return delay;
+}
+
 void Map::UpdatePlayers()
 {
     uint32 now = WorldTimer::getMSTime();
@@ -904,20 +914,26 @@ void Map::Update(uint32 t_diff)
     uint32 additionnalUpdateCounts = 0;
     if (_updateIdx >= 0)
     {
+        // Keep processing movement and players until every continent is done
         additionnalWaitTime = WorldTimer::getMSTime();
-        sMapMgr.MarkContinentUpdateFinished(_updateIdx);
-        while (!sMapMgr.IsContinentUpdateFinished())
+        additionnalUpdateCounts = sMapMgr.WaitForContinentsUpdate([this]()
         {
-            ACE_Based::Thread::Sleep(10);
-            if (sMapMgr.IsContinentUpdateFinished())
-                break;
-
             UpdateSessionsMovementAndSpellsIfNeeded();
             UpdatePlayers();
-            ++additionnalUpdateCounts;
-        }
+            return GetIdleUpdateDelay();
+        });
         additionnalWaitTime = WorldTimer::getMSTimeDiffToNow(additionnalWaitTime);
+
+        m_barrierWaitTime.last = additionnalWaitTime;
+        m_barrierWaitTime.total += additionnalWaitTime;
+        ++m_barrierWaitTime.count;
+        if (additionnalWaitTime > m_barrierWaitTime.max)
+            m_barrierWaitTime.max = additionnalWaitTime;
     }
+
+    uint32 const phaseTimes[MAX_MAP_UPDATE_PHASES] = { sessionsUpdateTime, playersUpdateTime, activeCellsUpdateTime, objectsUpdateTime,
+        visibilityUpdateTime, playersUpdateTime2, additionnalWaitTime, updateMapTime };
+    m_updatePhaseStats.Add(phaseTimes);
     // Don't unload grids if it's battleground, since we may have manually added GOs,creatures, those doesn't load from DB at grid re-load !
     // This isn't really bother us, since as soon as we have instanced BG-s, the whole map unloads as the BG gets ended
     if (!IsBattleGround())
@@ -932,8 +948,10 @@ void Map::Update(uint32 t_diff)
         }
     }
 
+    UpdateGridPrefetch(t_diff);
+
     ///- Process necessary scripts
-    ScriptsProcess();
+    ScriptsProcess(t_diff);
 
     if (i_data)
         i_data->Update(t_diff);
@@ -1330,6 +1348,108 @@ void Map::UnloadAll(bool pForce)
     }
 }
 
+void Map::UpdateGridPrefetch(uint32 diff)
+{
+    if (!IsContinent() || m_unloading || !sWorld.getConfig(CONFIG_BOOL_GRID_PREFETCH))
+        return;
+
+    uint32 const lookahead = sWorld.getConfig(CONFIG_UINT32_GRID_PREFETCH_LOOKAHEAD);
+
+    // Player speeds are measured over one second, enough to follow flight paths and mounts
+    m_gridPrefetchTimer += diff;
+    if (m_gridPrefetchTimer >= IN_MILLISECONDS)
+    {
+        float const maxMove = m_gridPrefetchTimer * 0.1f;   // 100 yards/s, faster means teleported
+        float const scale = float(lookahead) / m_gridPrefetchTimer;
+
+        GridPrefetchSamples samples;
+        for (MapRefManager::iterator itr = m_mapRefManager.begin(); itr != m_mapRefManager.end(); ++itr)
+        {
+            Player* player = itr->getSource();
+            if (!player->IsInWorld())
+                continue;
+
+            GridPrefetchSample& sample = samples[player->GetObjectGuid()];
+            sample.x = player->GetPositionX();
+            sample.y = player->GetPositionY();
+
+            GridPrefetchSamples::const_iterator last = m_gridPrefetchSamples.find(player->GetObjectGuid());
+            if (last == m_gridPrefetchSamples.end())
+                continue;
+
+            float dx = sample.x - last->second.x;
+            float dy = sample.y - last->second.y;
+            float moved = sqrt(dx * dx + dy * dy);
+            // Grids in sight are already loaded by the visibility updates
+            if (moved * scale < SIZE_OF_GRID_CELL || moved > maxMove)
+                continue;
+
+            // Halfway too, the visibility area does not cover the whole way
+            dx *= scale;
+            dy *= scale;
+            PrefetchGridsAround(sample.x + dx / 2, sample.y + dy / 2);
+            PrefetchGridsAround(sample.x + dx, sample.y + dy);
+        }
+
+        m_gridPrefetchSamples.swap(samples);
+        m_gridPrefetchTimer = 0;
+    }
+
+    // Objects spawning is the expensive part of a grid load, spread it over the ticks
+    uint32 budget = sWorld.getConfig(CONFIG_UINT32_GRID_PREFETCH_GRIDS_PER_TICK);
+    while (budget && !m_gridPrefetchQueue.empty())
+    {
+        GridPrefetchRequest const& request = m_gridPrefetchQueue.front();
+        GridPair const p = request.grid;
+        bool expired = WorldTimer::getMSTimeDiffToNow(request.queueTime) > lookahead;
+        if (loaded(p) || expired)
+        {
+            m_gridPrefetchQueue.pop_front();
+            continue;
+        }
+
+        // Terrain still read by the loader, do not block the map on its lock
+        if (sMapMgr.GetTerrainLoader().IsRunning() && !m_TerrainData->IsPrefetched((MAX_NUMBER_OF_GRIDS - 1) - p.x_coord, (MAX_NUMBER_OF_GRIDS - 1) - p.y_coord))
+            break;
+
+        m_gridPrefetchQueue.pop_front();
+        DEBUG_FILTER_LOG(LOG_FILTER_PLAYER_MOVES, "Prefetching grid[%u,%u] on map %u", p.x_coord, p.y_coord, i_id);
+        EnsureGridLoadedAtEnter(Cell(CellPair(p.x_coord * MAX_NUMBER_OF_CELLS, p.y_coord * MAX_NUMBER_OF_CELLS)));
+        --budget;
+    }
+}
+
+void Map::PrefetchGridsAround(float x, float y)
+{
+    if (!MaNGOS::IsValidMapCoord(x, y))
+        return;
+
+    float const radius = GetGridActivationDistance();
+    GridPair const low = MaNGOS::ComputeGridPair(x - radius, y - radius);
+    GridPair const high = MaNGOS::ComputeGridPair(x + radius, y + radius);
+
+    for (uint32 gx = low.x_coord; gx <= high.x_coord; ++gx)
+    {
+        for (uint32 gy = low.y_coord; gy <= high.y_coord; ++gy)
+        {
+            GridPair const p(gx, gy);
+            if (loaded(p))
+                continue;
+
+            bool queued = false;
+            for (std::deque<GridPrefetchRequest>::const_iterator itr = m_gridPrefetchQueue.begin(); itr != m_gridPrefetchQueue.end() && !queued; ++itr)
+                queued = itr->grid == p;
+            if (queued)
+                continue;
+
+            // Terrain grids are indexed the other way (see EnsureGridCreated)
+            sMapMgr.GetTerrainLoader().Queue(m_TerrainData, (MAX_NUMBER_OF_GRIDS - 1) - gx, (MAX_NUMBER_OF_GRIDS - 1) - gy);
+            GridPrefetchRequest request = { p, WorldTimer::getMSTime() };
+            m_gridPrefetchQueue.push_back(request);
+        }
+    }
+}
+
 bool Map::CheckGridIntegrity(Creature* c, bool moved) const
 {
     Cell const& cur_cell = c->GetCurrentCell();
@@ -1491,6 +1611,42 @@ void Map::AddObjectToRemoveList(WorldObject *obj)
     i_objectsToRemove_lock.release();
 }
 
+void Map::AddRelocatedUnit(Unit* obj)
+{
+    if (_processingUnitsRelocation)
+        return;
+    i_unitsRelocated_lock.acquire();
+    i_unitsRelocated.insert(obj);
+    i_unitsRelocated_lock.release();
+}
+
+void Map::RemoveRelocatedUnit(Unit* obj)
+{
+    ASSERT(!_processingUnitsRelocation);
+    i_unitsRelocated_lock.acquire();
+    i_unitsRelocated.erase(obj);
+    i_unitsRelocated_lock.release();
+}
+
+void Map::AddUnitToMovementUpdate(Unit* unit)
+{
+    unitsMvtUpdate_lock.acquire();
+    unitsMvtUpdate.insert(unit);
+    unitsMvtUpdate_lock.release();
+}
+
+void Map::RemoveUnitFromMovementUpdate(Unit* unit)
+{
+    unitsMvtUpdate_lock.acquire();
+    unitsMvtUpdate.erase(unit);
+    unitsMvtUpdate_lock.release();
+}
+
+uint32 Map::GetMotionUpdateThreads() const
+{
+    return sWorld.getConfig(IsContinent() ? CONFIG_UINT32_CONTINENTS_MOTIONUPDATE_THREADS : CONFIG_UINT32_INSTANCES_MOTIONUPDATE_THREADS);
+}
+
 void Map::RemoveAllObjectsInRemoveList()
 {
     if (i_objectsToRemove.empty())
@@ -1499,8 +1655,8 @@ void Map::RemoveAllObjectsInRemoveList()
     i_objectsToRemove_lock.acquire();
     while (!i_objectsToRemove.empty())
     {
-        WorldObject* obj = *i_objectsToRemove.begin();
-        i_objectsToRemove.erase(i_objectsToRemove.begin());
+        WorldObject* obj = i_objectsToRemove[i_objectsToRemove.size() - 1];
+        i_objectsToRemove.erase(obj);
 
         switch (obj->GetTypeId())
         {
@@ -2160,6 +2316,31 @@ void BattleGroundMap::UnloadAll(bool pForce)
     Map::UnloadAll(pForce);
 }
 
+// A script step waiting for its delay in the map script schedule
+class ScriptStepEvent : public BasicEvent
+{
+    public:
+        ScriptStepEvent(Map& map, ScriptAction const& action, uint32 delay)
+            : m_map(map), m_action(action), m_delay(delay), m_terminated(false), m_nextQueued(nullptr) {}
+
+        bool Execute(uint64 /*e_time*/, uint32 /*p_time*/) override
+        {
+            if (!m_terminated)
+                m_map.ScriptStepExecute(m_action);
+            return true;
+        }
+
+        Map& m_map;
+        ScriptAction m_action;
+        uint32 m_delay;                                     // ms, counted from the time the step leaves the queue
+        bool m_terminated;                                  // removed from the script, only waits to be deleted
+        ScriptStepEvent* m_nextQueued;                      // step queued before this one
+
+        DECLARE_POOLED_ALLOCATOR(ScriptStepEvent);
+};
+
+DEFINE_POOLED_ALLOCATOR(ScriptStepEvent);
+
 /// Put scripts in the execution queue
 void Map::ScriptsStart(ScriptMapMap const& scripts, uint32 id, Object* source, Object* target)
 {
@@ -2173,10 +2354,11 @@ void Map::ScriptsStart(ScriptMapMap const& scripts, uint32 id, Object* source, O
     ObjectGuid targetGuid = target ? target->GetObjectGuid() : ObjectGuid();
     ObjectGuid ownerGuid  = source->isType(TYPEMASK_ITEM) ? ((Item*)source)->GetOwnerGuid() : ObjectGuid();
 
-    ///- Schedule script execution for all scripts in the script map
+    ///- Schedule script execution for all scripts in the script map, queued at once
     ScriptMap const *s2 = &(s->second);
-    bool immedScript = false;
-    m_scriptSchedule_lock.acquire();
+    ScriptStepEvent* first = nullptr;
+    ScriptStepEvent* last = nullptr;
+    uint32 count = 0;
     for (ScriptMap::const_iterator iter = s2->begin(); iter != s2->end(); ++iter)
     {
         ScriptAction sa;
@@ -2185,13 +2367,18 @@ void Map::ScriptsStart(ScriptMapMap const& scripts, uint32 id, Object* source, O
         sa.ownerGuid  = ownerGuid;
 
         sa.script = &iter->second;
-        m_scriptSchedule.insert(ScriptScheduleMap::value_type(time_t(sWorld.GetGameTime() + iter->first), sa));
-        if (iter->first == 0)
-            immedScript = true;
+        ScriptStepEvent* step = new ScriptStepEvent(*this, sa, iter->first * IN_MILLISECONDS);
+        step->m_nextQueued = last;
+        if (!first)
+            first = step;
+        last = step;
+        ++count;
 
         sScriptMgr.IncreaseScheduledScriptsCount();
     }
-    m_scriptSchedule_lock.release();
+
+    if (count)
+        QueueScriptSteps(first, last, count);
 }
 
 void Map::ScriptCommandStart(ScriptInfo const& script, uint32 delay, Object* source, Object* target)
@@ -2209,250 +2396,279 @@ void Map::ScriptCommandStart(ScriptInfo const& script, uint32 delay, Object* sou
     sa.ownerGuid  = ownerGuid;
 
     sa.script = &script;
-    m_scriptSchedule_lock.acquire();
-    m_scriptSchedule.insert(ScriptScheduleMap::value_type(time_t(sWorld.GetGameTime() + delay), sa));
+    ScriptStepEvent* step = new ScriptStepEvent(*this, sa, delay * IN_MILLISECONDS);
     sScriptMgr.IncreaseScheduledScriptsCount();
-    m_scriptSchedule_lock.release();
+    QueueScriptSteps(step, step, 1);
+}
+
+// Scripts are mostly started by the map thread, but also by the world thread for some packets:
+// the steps are pushed on a lock free stack, the map thread takes them all at its next update.
+void Map::QueueScriptSteps(ScriptStepEvent* first, ScriptStepEvent* last, uint32 count)
+{
+    m_scriptStepsScheduled += count;
+
+    ScriptStepEvent* queued = m_scriptQueue.load(std::memory_order_relaxed);
+    do
+        first->m_nextQueued = queued;
+    while (!m_scriptQueue.compare_exchange_weak(queued, last, std::memory_order_release, std::memory_order_relaxed));
+}
+
+// Moves the queued steps to the schedule, in the order they were queued.
+// Returns false if there was none.
+bool Map::FlushScriptQueue()
+{
+    ScriptStepEvent* step = m_scriptQueue.exchange(nullptr, std::memory_order_acquire);
+    if (!step)
+        return false;
+
+    // the stack starts with the last queued step
+    ScriptStepEvent* ordered = nullptr;
+    while (step)
+    {
+        ScriptStepEvent* previous = step->m_nextQueued;
+        step->m_nextQueued = ordered;
+        ordered = step;
+        step = previous;
+    }
+
+    while (ordered)
+    {
+        step = ordered;
+        ordered = step->m_nextQueued;
+        step->m_nextQueued = nullptr;
+        m_scriptSchedule.AddEvent(step, m_scriptSchedule.CalculateTime(step->m_delay));
+    }
+    return true;
 }
 
 // Removes all parts of script from the queue.
 void Map::TerminateScript(ScriptAction& step)
 {
-    for (auto rmItr = m_scriptSchedule.begin(); rmItr != m_scriptSchedule.end();)
+    FlushScriptQueue();
+
+    std::vector<BasicEvent*> events;
+    m_scriptSchedule.GetEvents(events);
+    for (BasicEvent* event : events)
     {
-        if (rmItr->second.IsSameScript(step.script->id, step.sourceGuid, step.targetGuid, step.ownerGuid))
+        ScriptStepEvent* scheduled = static_cast<ScriptStepEvent*>(event);
+        if (!scheduled->m_terminated && scheduled->m_action.IsSameScript(step.script->id, step.sourceGuid, step.targetGuid, step.ownerGuid))
         {
-            m_scriptSchedule.erase(rmItr++);
+            scheduled->m_terminated = true;
+            ++m_scriptStepsTerminated;
             sScriptMgr.DecreaseScheduledScriptCount();
         }
-        else
-            ++rmItr;
     }
 }
 
 /// Process queued scripts
-void Map::ScriptsProcess()
+void Map::ScriptsProcess(uint32 diff)
 {
-    m_scriptSchedule_lock.acquire();
-    if (m_scriptSchedule.empty())
-    {
-        m_scriptSchedule_lock.release();
-        return;
-    }
+    FlushScriptQueue();
+    m_scriptSchedule.Update(diff);
 
-    ///- Process overdue queued scripts
-    ScriptScheduleMap::iterator iter = m_scriptSchedule.begin();
-    // ok as multimap is a *sorted* associative container
-    while (!m_scriptSchedule.empty() && (iter->first <= sWorld.GetGameTime()))
-    {
-        ScriptAction step = iter->second;
-        m_scriptSchedule_lock.release();
+    // Steps started by the executed ones: the immediate ones still run in this update
+    while (FlushScriptQueue())
+        m_scriptSchedule.Update(0);
+}
+
+/// Execute a due script step
+void Map::ScriptStepExecute(ScriptAction& step)
+{
+    ++m_scriptStepsExecuted;
+    sScriptMgr.DecreaseScheduledScriptCount();
 
-        Object* source = nullptr;
+    Object* source = nullptr;
 
-        if (step.sourceGuid)
+    if (step.sourceGuid)
+    {
+        switch (step.sourceGuid.GetHigh())
         {
-            switch (step.sourceGuid.GetHigh())
+            case HIGHGUID_ITEM:
+                // case HIGHGUID_CONTAINER: ==HIGHGUID_ITEM
             {
-                case HIGHGUID_ITEM:
-                    // case HIGHGUID_CONTAINER: ==HIGHGUID_ITEM
-                {
-                    if (Player* player = HashMapHolder<Player>::Find(step.ownerGuid))
-                        source = player->GetItemByGuid(step.sourceGuid);
-                    break;
-                }
-                case HIGHGUID_UNIT:
-                    source = GetCreature(step.sourceGuid);
-                    break;
-                case HIGHGUID_PET:
-                    source = GetPet(step.sourceGuid);
-                    break;
-                case HIGHGUID_PLAYER:
-                    source = HashMapHolder<Player>::Find(step.sourceGuid);
-                    break;
-                case HIGHGUID_GAMEOBJECT:
-                    source = GetGameObject(step.sourceGuid);
-                    break;
-                case HIGHGUID_CORPSE:
-                    source = HashMapHolder<Corpse>::Find(step.sourceGuid);
-                    break;
-                default:
-                    sLog.outError("*_script source with unsupported guid %s", step.sourceGuid.GetString().c_str());
-                    break;
+                if (Player* player = HashMapHolder<Player>::Find(step.ownerGuid))
+                    source = player->GetItemByGuid(step.sourceGuid);
+                break;
             }
+            case HIGHGUID_UNIT:
+                source = GetCreature(step.sourceGuid);
+                break;
+            case HIGHGUID_PET:
+                source = GetPet(step.sourceGuid);
+                break;
+            case HIGHGUID_PLAYER:
+                source = HashMapHolder<Player>::Find(step.sourceGuid);
+                break;
+            case HIGHGUID_GAMEOBJECT:
+                source = GetGameObject(step.sourceGuid);
+                break;
+            case HIGHGUID_CORPSE:
+                source = HashMapHolder<Corpse>::Find(step.sourceGuid);
+                break;
+            default:
+                sLog.outError("*_script source with unsupported guid %s", step.sourceGuid.GetString().c_str());
+                break;
         }
+    }
 
-        if (source && !source->IsInWorld())
-            source = nullptr;
+    if (source && !source->IsInWorld())
+        source = nullptr;
 
-        Object* target = nullptr;
+    Object* target = nullptr;
 
-        if (step.targetGuid)
+    if (step.targetGuid)
+    {
+        switch (step.targetGuid.GetHigh())
         {
-            switch (step.targetGuid.GetHigh())
-            {
-                case HIGHGUID_UNIT:
-                    target = GetCreature(step.targetGuid);
-                    break;
-                case HIGHGUID_PET:
-                    target = GetPet(step.targetGuid);
-                    break;
-                case HIGHGUID_PLAYER:
-                    target = HashMapHolder<Player>::Find(step.targetGuid);
-                    break;
-                case HIGHGUID_GAMEOBJECT:
-                    target = GetGameObject(step.targetGuid);
-                    break;
-                case HIGHGUID_CORPSE:
-                    target = HashMapHolder<Corpse>::Find(step.targetGuid);
-                    break;
-                default:
-                    sLog.outError("*_script target with unsupported guid %s", step.targetGuid.GetString().c_str());
-                    break;
-            }
+            case HIGHGUID_UNIT:
+                target = GetCreature(step.targetGuid);
+                break;
+            case HIGHGUID_PET:
+                target = GetPet(step.targetGuid);
+                break;
+            case HIGHGUID_PLAYER:
+                target = HashMapHolder<Player>::Find(step.targetGuid);
+                break;
+            case HIGHGUID_GAMEOBJECT:
+                target = GetGameObject(step.targetGuid);
+                break;
+            case HIGHGUID_CORPSE:
+                target = HashMapHolder<Corpse>::Find(step.targetGuid);
+                break;
+            default:
+                sLog.outError("*_script target with unsupported guid %s", step.targetGuid.GetString().c_str());
+                break;
         }
+    }
 
-        if (target && !target->IsInWorld())
-            target = nullptr;
+    if (target && !target->IsInWorld())
+        target = nullptr;
 
-        // we swap target and source if data_flags & 0x1
-        if (step.script->raw.data[4] & SF_GENERAL_SWAP_INITIAL_TARGETS)
-            std::swap(source, target);
+    // we swap target and source if data_flags & 0x1
+    if (step.script->raw.data[4] & SF_GENERAL_SWAP_INITIAL_TARGETS)
+        std::swap(source, target);
 
-        bool scriptResultOk = true;
+    bool scriptResultOk = true;
 
-        // If we have a buddy lets find it.
-        if (step.script->buddy_id)
+    // If we have a buddy lets find it.
+    if (step.script->buddy_id)
+    {
+        Object* pBuddy = nullptr;
+        switch (step.script->buddy_type)
         {
-            Object* pBuddy = nullptr;
-            switch (step.script->buddy_type)
+            case BUDDY_TYPE_CREATURE_ENTRY:
             {
-                case BUDDY_TYPE_CREATURE_ENTRY:
+                if (source && source->isType(TYPEMASK_WORLDOBJECT))
                 {
-                    if (source && source->isType(TYPEMASK_WORLDOBJECT))
-                    {
-                        WorldObject* pSource = (WorldObject*)source;
-                        Creature* pCreatureBuddy = nullptr;
+                    WorldObject* pSource = (WorldObject*)source;
+                    Creature* pCreatureBuddy = nullptr;
 
-                        MaNGOS::NearestCreatureEntryWithLiveStateInObjectRangeCheck u_check(*pSource, step.script->buddy_id, true, step.script->buddy_radius);
-                        MaNGOS::CreatureLastSearcher<MaNGOS::NearestCreatureEntryWithLiveStateInObjectRangeCheck> searcher(pCreatureBuddy, u_check);
+                    MaNGOS::NearestCreatureEntryWithLiveStateInObjectRangeCheck u_check(*pSource, step.script->buddy_id, true, step.script->buddy_radius);
+                    MaNGOS::CreatureLastSearcher<MaNGOS::NearestCreatureEntryWithLiveStateInObjectRangeCheck> searcher(pCreatureBuddy, u_check);
 
-                        Cell::VisitGridObjects(pSource, searcher, step.script->buddy_radius);
+                    Cell::VisitGridObjects(pSource, searcher, step.script->buddy_radius);
 
-                        if (pCreatureBuddy)
-                            pBuddy = pCreatureBuddy;
-                    }
-                    else
-                        sLog.outError("ScriptsProcess: Attempt to search for nearby creature in script with id %u but source is not a world object.", step.script->id);
-                    break;
+                    if (pCreatureBuddy)
+                        pBuddy = pCreatureBuddy;
                 }
-                case BUDDY_TYPE_CREATURE_GUID:
+                else
+                    sLog.outError("ScriptsProcess: Attempt to search for nearby creature in script with id %u but source is not a world object.", step.script->id);
+                break;
+            }
+            case BUDDY_TYPE_CREATURE_GUID:
+            {
+                const CreatureData* pCreatureData = sObjectMgr.GetCreatureData(step.script->buddy_id);
+                if (pCreatureData)
                 {
-                    const CreatureData* pCreatureData = sObjectMgr.GetCreatureData(step.script->buddy_id);
-                    if (pCreatureData)
-                    {
-                        Creature* pCreatureBuddy = this->GetCreature(ObjectGuid(HIGHGUID_UNIT, pCreatureData->id, step.script->buddy_id));
-
-                        if (pCreatureBuddy)
-                            pBuddy = pCreatureBuddy;
-                    }
-                    break;
+                    Creature* pCreatureBuddy = this->GetCreature(ObjectGuid(HIGHGUID_UNIT, pCreatureData->id, step.script->buddy_id));
+
+                    if (pCreatureBuddy)
+                        pBuddy = pCreatureBuddy;
                 }
-                case BUDDY_TYPE_CREATURE_INSTANCE_DATA:
+                break;
+            }
+            case BUDDY_TYPE_CREATURE_INSTANCE_DATA:
+            {
+                InstanceData* pInstanceData = this->GetInstanceData();
+                if (pInstanceData)
                 {
-                    InstanceData* pInstanceData = this->GetInstanceData();
-                    if (pInstanceData)
-                    {
-                        Creature* pCreatureBuddy = pInstanceData->GetCreature(pInstanceData->GetData64(step.script->buddy_id));
-
-                        if (pCreatureBuddy)
-                            pBuddy = pCreatureBuddy;
-                    }
-                    break;
+                    Creature* pCreatureBuddy = pInstanceData->GetCreature(pInstanceData->GetData64(step.script->buddy_id));
+
+                    if (pCreatureBuddy)
+                        pBuddy = pCreatureBuddy;
                 }
-                case BUDDY_TYPE_GAMEOBJECT_ENTRY:
+                break;
+            }
+            case BUDDY_TYPE_GAMEOBJECT_ENTRY:
+            {
+                if (source && source->isType(TYPEMASK_WORLDOBJECT))
                 {
-                    if (source && source->isType(TYPEMASK_WORLDOBJECT))
-                    {
-                        WorldObject* pSource = (WorldObject*)source;
-                        GameObject* pGameObjectBuddy = nullptr;
+                    WorldObject* pSource = (WorldObject*)source;
+                    GameObject* pGameObjectBuddy = nullptr;
 
-                        MaNGOS::NearestGameObjectEntryInObjectRangeCheck u_check(*pSource, step.script->buddy_id, step.script->buddy_radius);
-                        MaNGOS::GameObjectLastSearcher<MaNGOS::NearestGameObjectEntryInObjectRangeCheck> searcher(pGameObjectBuddy, u_check);
+                    MaNGOS::NearestGameObjectEntryInObjectRangeCheck u_check(*pSource, step.script->buddy_id, step.script->buddy_radius);
+                    MaNGOS::GameObjectLastSearcher<MaNGOS::NearestGameObjectEntryInObjectRangeCheck> searcher(pGameObjectBuddy, u_check);
 
-                        Cell::VisitGridObjects(pSource, searcher, step.script->buddy_radius);
+                    Cell::VisitGridObjects(pSource, searcher, step.script->buddy_radius);
 
-                        if (pGameObjectBuddy)
-                            pBuddy = pGameObjectBuddy;
-                    }
-                    else
-                        sLog.outError("ScriptsProcess: Attempt to search for nearby gameobject in script with id %u but source is not a world object.", step.script->id);
-                    break;
-                }
-                case BUDDY_TYPE_GAMEOBJECT_GUID:
-                {
-                    GameObjectData const* pGameObjectData = sObjectMgr.GetGOData(step.script->buddy_id);
-                    if (pGameObjectData)
-                    {
-                        GameObject* pGameObjectBuddy = this->GetGameObject(ObjectGuid(HIGHGUID_GAMEOBJECT, pGameObjectData->id, step.script->buddy_id));
-
-                        if (pGameObjectBuddy)
-                            pBuddy = pGameObjectBuddy;
-                    }
-                    break;
+                    if (pGameObjectBuddy)
+                        pBuddy = pGameObjectBuddy;
                 }
-                case BUDDY_TYPE_GAMEOBJECT_INSTANCE_DATA:
+                else
+                    sLog.outError("ScriptsProcess: Attempt to search for nearby gameobject in script with id %u but source is not a world object.", step.script->id);
+                break;
+            }
+            case BUDDY_TYPE_GAMEOBJECT_GUID:
+            {
+                GameObjectData const* pGameObjectData = sObjectMgr.GetGOData(step.script->buddy_id);
+                if (pGameObjectData)
                 {
-                    InstanceData* pInstanceData = this->GetInstanceData();
-                    if (pInstanceData)
-                    {
-                        GameObject* pGameObjectBuddy = pInstanceData->GetGameObject(pInstanceData->GetData64(step.script->buddy_id));
-
-                        if (pGameObjectBuddy)
-                            pBuddy = pGameObjectBuddy;
-                    }
-                    break;
+                    GameObject* pGameObjectBuddy = this->GetGameObject(ObjectGuid(HIGHGUID_GAMEOBJECT, pGameObjectData->id, step.script->buddy_id));
+
+                    if (pGameObjectBuddy)
+                        pBuddy = pGameObjectBuddy;
                 }
+                break;
             }
-
-            if (pBuddy)
-                source = pBuddy;
-            else
+            case BUDDY_TYPE_GAMEOBJECT_INSTANCE_DATA:
             {
-                sLog.outError("ScriptsProcess: Failed to find buddy for script with id %u (buddy_id: %u), (buddy_radius: %u), (buddy_type: %u).", step.script->id, step.script->buddy_id, step.script->buddy_radius, step.script->buddy_type);
-                scriptResultOk = false;
+                InstanceData* pInstanceData = this->GetInstanceData();
+                if (pInstanceData)
+                {
+                    GameObject* pGameObjectBuddy = pInstanceData->GetGameObject(pInstanceData->GetData64(step.script->buddy_id));
+
+                    if (pGameObjectBuddy)
+                        pBuddy = pGameObjectBuddy;
+                }
+                break;
             }
         }
 
-        // we swap target and source again if data_flags & 0x2
-        // this way we have all possible combinations with 3 targets
-        if (step.script->raw.data[4] & SF_GENERAL_SWAP_FINAL_TARGETS)
-            std::swap(source, target);
-        
-        // we replace the target with the source if data_flags & 0x4
-        if (step.script->raw.data[4] & SF_GENERAL_TARGET_SELF)
-            target = source;
-        
-        
-        if (scriptResultOk)
-            scriptResultOk = (this->*(m_ScriptCommands[step.script->command]))(step, source, target);
-
-        // Command returns true if we should abort script.
-        if (scriptResultOk)
-            TerminateScript(step);
+        if (pBuddy)
+            source = pBuddy;
         else
         {
-            m_scriptSchedule_lock.acquire();
-            iter = m_scriptSchedule.begin();
-
-            if (iter->second.script == step.script)
-                m_scriptSchedule.erase(iter);
-
-            sScriptMgr.DecreaseScheduledScriptCount();
+            sLog.outError("ScriptsProcess: Failed to find buddy for script with id %u (buddy_id: %u), (buddy_radius: %u), (buddy_type: %u).", step.script->id, step.script->buddy_id, step.script->buddy_radius, step.script->buddy_type);
+            scriptResultOk = false;
         }
-        iter = m_scriptSchedule.begin();
     }
-    m_scriptSchedule_lock.release();
+
+    // we swap target and source again if data_flags & 0x2
+    // this way we have all possible combinations with 3 targets
+    if (step.script->raw.data[4] & SF_GENERAL_SWAP_FINAL_TARGETS)
+        std::swap(source, target);
+    
+    // we replace the target with the source if data_flags & 0x4
+    if (step.script->raw.data[4] & SF_GENERAL_TARGET_SELF)
+        target = source;
+    
+    
+    if (scriptResultOk)
+        scriptResultOk = (this->*(m_ScriptCommands[step.script->command]))(step, source, target);
+
+    // Command returns true if we should abort script.
+    if (scriptResultOk)
+        TerminateScript(step);
 }
 
 /**
@@ -2569,39 +2785,29 @@ WorldObject* Map::GetWorldObject(ObjectGuid guid)
     return NULL;
 }
 
-class ObjectUpdatePacketBuilder : public ACE_Based::Runnable
+// Chunks small enough for the pool threads to balance uneven objects, big
+// enough to keep the atomic chunk counter out of the profile.
+static uint32 GetMapJobChunkSize(uint32 count, uint32 threads)
 {
-public:
-    ObjectUpdatePacketBuilder(std::set<Object*>::iterator& a, std::set<Object*>::iterator& b, uint32 now) : begin(a), end(b), beginTime(now), current(a)
-    {
-    }
+    uint32 chunkSize = count / (threads * 8);
+    return chunkSize < 16 ? 16 : chunkSize;
+}
 
-    virtual void run()
-    {
-        WorldDatabase.ThreadStart(); // Not needed if we don't do SQL queries from this thread ...
-        DoUpdateObjects();
-        WorldDatabase.ThreadEnd();
-    }
-    void DoUpdateObjects()
+// Removes from 'queue' every item processed before the job timed out.
+// 'processed' holds the number of items done at the start of each chunk.
+template <class Queue, class T>
+static void EraseProcessedJobItems(Queue& queue, std::vector<T*> const& items, std::vector<uint32> const& processed, uint32 chunkSize)
+{
+    queue.clear();
+    for (uint32 chunk = 0; chunk < processed.size(); ++chunk)
     {
-        uint32 timeout = sWorld.getConfig(CONFIG_UINT32_MAP_OBJECTSUPDATE_TIMEOUT);
-        UpdateDataMapType update_players; // Player -> UpdateData
-
-        for (; current != end; ++current)
-        {
-            if (WorldTimer::getMSTimeDiffToNow(beginTime) > timeout)
-                break;
-            (*current)->BuildUpdateData(update_players);
-        }
-
-        for (UpdateDataMapType::iterator iter = update_players.begin(); iter != update_players.end(); ++iter)
-            iter->second.Send(iter->first->GetSession());
+        uint32 end = (chunk + 1) * chunkSize;
+        if (end > items.size())
+            end = items.size();
+        for (uint32 i = chunk * chunkSize + processed[chunk]; i < end; ++i)
+            queue.insert(items[i]);
     }
-    std::set<Object*>::iterator begin;
-    std::set<Object*>::iterator current;
-    std::set<Object*>::iterator end;
-    uint32 beginTime;
-};
+}
 
 //#define MAP_SENDOBJECTUPDATES_PROFILE
 
@@ -2623,98 +2829,40 @@ void Map::SendObjectUpdates()
         if (!threads)
             threads = 1;
     }
-    if (!_objUpdatesThreads)
-        _objUpdatesThreads = 1;
-    if (threads < _objUpdatesThreads)
-        _objUpdatesThreads = threads;
-    if (threads > objectsCount)
-        threads = objectsCount;
-
-    uint32 step = objectsCount / threads;
-    uint32 i = 0;
-    ACE_Based::Thread** updaters = threads > 1 ? new ACE_Based::Thread*[threads - 1] : NULL;
-    ObjectUpdatePacketBuilder** objUpdaters = new ObjectUpdatePacketBuilder*[threads];
-    std::set<Object*>::iterator itBegin = i_objectsToClientUpdate.begin();
-    std::set<Object*>::iterator itEnd = i_objectsToClientUpdate.begin();
-    ASSERT(step > 0);
-    ASSERT(threads >= 1);
-    for (uint32 i = 0; i < threads; ++i)
-    {
-        itBegin = itEnd;
-        if (i == (threads - 1))
-            itEnd = i_objectsToClientUpdate.end();
-        else
-        {
-            for (uint32 j = 0; j < step; ++j)
-                ++itEnd;
-        }
-        objUpdaters[i] = new ObjectUpdatePacketBuilder(itBegin, itEnd, now);
-        objUpdaters[i]->incReference();
 
-        if (i == (threads - 1)) // Do not create a useless supplementary thread
-            objUpdaters[i]->DoUpdateObjects();
-        else
-            updaters[i] = new ACE_Based::Thread(objUpdaters[i]);
-    }
-    for (uint32 i = 0; i < (threads - 1); ++i)
-        updaters[i]->wait();
-    for (uint32 i = 0; i < threads; ++i)
-    {
-        /* std::set::erase
-         * Iterators, pointers and references referring to elements removed by the function are invalidated.
-         * All other iterators, pointers and references keep their validity.
-         */
-        i_objectsToClientUpdate.erase(objUpdaters[i]->begin, objUpdaters[i]->current);
-        objUpdaters[i]->decReference();
-        if (i != (threads - 1))
-            delete updaters[i];
-    }
+    uint32 timeout = sWorld.getConfig(CONFIG_UINT32_MAP_OBJECTSUPDATE_TIMEOUT);
+    std::vector<Object*> objects(i_objectsToClientUpdate.begin(), i_objectsToClientUpdate.end());
+    uint32 chunkSize = GetMapJobChunkSize(objectsCount, threads);
+    std::vector<uint32> processed((objectsCount + chunkSize - 1) / chunkSize, 0);
+    std::vector<UpdateDataMapType> updatePlayers(threads); // Player -> UpdateData, per slot
 
-    // If we timeout, use more threads !
-    if (i_objectsToClientUpdate.size())
-        ++_objUpdatesThreads;
-    else
-        --_objUpdatesThreads;
+    _objUpdatesThreads = sMapMgr.GetJobPool().ParallelFor(objectsCount, chunkSize, threads,
+        [&](uint32 slot, uint32 begin, uint32 end)
+        {
+            uint32& done = processed[begin / chunkSize];
+            for (uint32 i = begin; i < end; ++i, ++done)
+            {
+                if (WorldTimer::getMSTimeDiffToNow(now) > timeout)
+                    break;
+                objects[i]->BuildUpdateData(updatePlayers[slot]);
+            }
+        },
+        [&](uint32 slot)
+        {
+            for (UpdateDataMapType::iterator iter = updatePlayers[slot].begin(); iter != updatePlayers[slot].end(); ++iter)
+                iter->second.Send(iter->first->GetSession());
+        });
+
+    EraseProcessedJobItems(i_objectsToClientUpdate, objects, processed, chunkSize);
 
     _processingSendObjUpdates = false;
-    delete[] updaters;
-    delete[] objUpdaters;
 #ifdef MAP_SENDOBJECTUPDATES_PROFILE
     uint32 diff = WorldTimer::getMSTimeDiffToNow(now);
     if (diff > 50)
-        sLog.outString("SendObjectUpdates in %04u ms [%u threads. %3u/%3u]", diff, threads, objectsCount - i_objectsToClientUpdate.size(), objectsCount);
+        sLog.outString("SendObjectUpdates in %04u ms [%u threads. %3u/%3u]", diff, _objUpdatesThreads, objectsCount - i_objectsToClientUpdate.size(), objectsCount);
 #endif
 }
 
-class VisibilityUpdater : public ACE_Based::Runnable
-{
-public:
-    VisibilityUpdater(std::set<Unit*>::iterator& a, std::set<Unit*>::iterator& b, uint32 now) : begin(a), end(b), beginTime(now), current(a)
-    {
-    }
-
-    virtual void run()
-    {
-        WorldDatabase.ThreadStart();
-        DoUpdateVisibility();
-        WorldDatabase.ThreadEnd();
-    }
-    void DoUpdateVisibility()
-    {
-        uint32 timeout = sWorld.getConfig(CONFIG_UINT32_MAP_VISIBILITYUPDATE_TIMEOUT);
-        for (; current != end; ++current)
-        {
-            if (WorldTimer::getMSTimeDiffToNow(beginTime) > timeout)
-                break;
-            (*current)->ProcessRelocationVisibilityUpdates();
-        }
-    }
-    std::set<Unit*>::iterator begin;
-    std::set<Unit*>::iterator current;
-    std::set<Unit*>::iterator end;
-    uint32 beginTime;
-};
-
 //#define MAP_UPDATEVISIBILITY_PROFILE
 
 void Map::UpdateVisibilityForRelocations()
@@ -2726,7 +2874,7 @@ void Map::UpdateVisibilityForRelocations()
         return;
     _processingUnitsRelocation = true;
 
-    // Compute number of threads to spawn
+    // Compute maximum number of threads
     uint32 threads = 1;
     if (IsContinent())
     {
@@ -2734,60 +2882,32 @@ void Map::UpdateVisibilityForRelocations()
         if (!threads)
             threads = 1;
     }
-    if (!_unitRelocationThreads)
-        _unitRelocationThreads = 1;
-    if (threads < _unitRelocationThreads)
-        _unitRelocationThreads = threads;
-    if (threads > objectsCount)
-        threads = objectsCount;
-
-    uint32 step = objectsCount / threads;
-    uint32 i = 0;
-    ACE_Based::Thread** updaters = threads > 1 ? new ACE_Based::Thread*[threads - 1] : NULL;
-    VisibilityUpdater** visUpdaters = new VisibilityUpdater*[threads];
-    std::set<Unit*>::iterator itBegin = i_unitsRelocated.begin();
-    std::set<Unit*>::iterator itEnd = i_unitsRelocated.begin();
-    ASSERT(step > 0);
-    for (uint32 i = 0; i < threads; ++i)
-    {
-        itBegin = itEnd;
-        if (i == (threads - 1))
-            itEnd = i_unitsRelocated.end();
-        else
+
+    uint32 timeout = sWorld.getConfig(CONFIG_UINT32_MAP_VISIBILITYUPDATE_TIMEOUT);
+    std::vector<Unit*> units(i_unitsRelocated.begin(), i_unitsRelocated.end());
+    uint32 chunkSize = GetMapJobChunkSize(objectsCount, threads);
+    std::vector<uint32> processed((objectsCount + chunkSize - 1) / chunkSize, 0);
+
+    _unitRelocationThreads = sMapMgr.GetJobPool().ParallelFor(objectsCount, chunkSize, threads,
+        [&](uint32 /*slot*/, uint32 begin, uint32 end)
         {
-            for (uint32 j = 0; j < step; ++j)
-                ++itEnd;
-        }
-        visUpdaters[i] = new VisibilityUpdater(itBegin, itEnd, now);
-        visUpdaters[i]->incReference();
-        if (i == (threads - 1))
-            visUpdaters[i]->DoUpdateVisibility();
-        else
-            updaters[i] = new ACE_Based::Thread(visUpdaters[i]);
-    }
-    for (uint32 i = 0; i < threads - 1; ++i)
-        updaters[i]->wait();
-    for (uint32 i = 0; i < threads; ++i)
-    {
-        i_unitsRelocated.erase(visUpdaters[i]->begin, visUpdaters[i]->current);
-        visUpdaters[i]->decReference();
-        if (i != (threads - 1))
-            delete updaters[i];
-    }
+            uint32& done = processed[begin / chunkSize];
+            for (uint32 i = begin; i < end; ++i, ++done)
+            {
+                if (WorldTimer::getMSTimeDiffToNow(now) > timeout)
+                    break;
+                units[i]->ProcessRelocationVisibilityUpdates();
+            }
+        });
 
-    if (i_unitsRelocated.size())
-        ++_unitRelocationThreads;
-    else
-        --_unitRelocationThreads;
+    EraseProcessedJobItems(i_unitsRelocated, units, processed, chunkSize);
 
     _processingUnitsRelocation = false;
-    delete[] updaters;
-    delete[] visUpdaters;
 
 #ifdef MAP_UPDATEVISIBILITY_PROFILE
     uint32 diff = WorldTimer::getMSTimeDiffToNow(now);
     if (diff > 50)
-        sLog.outString("VisibilityUpdate in %04u ms [%u threads/done %u/%u]", diff, threads, objectsCount - i_unitsRelocated.size(), objectsCount);
+        sLog.outString("VisibilityUpdate in %04u ms [%u threads/done %u/%u]", diff, _unitRelocationThreads, objectsCount - i_unitsRelocated.size(), objectsCount);
 #endif
 }
 
@@ -3188,8 +3308,8 @@ void Map::CrashUnload()
     }
     //UnloadAll(true);
 
-    if (!m_scriptSchedule.empty())
-        sScriptMgr.DecreaseScheduledScriptCount(m_scriptSchedule.size());
+    if (uint64 pending = GetScriptStepsPending())
+        sScriptMgr.DecreaseScheduledScriptCount(pending);
 
     if (m_persistentState)
     {
@@ -3235,6 +3355,11 @@ void Map::PrintInfos(ChatHandler& handler)
     handler.PSendSysMessage("%u non player active", m_activeNonPlayers.size());
     handler.PSendSysMessage("%u objects to client update [%u threads]", i_objectsToClientUpdate.size(), _objUpdatesThreads);
     handler.PSendSysMessage("%u objects relocated [%u threads]", i_unitsRelocated.size(), _unitRelocationThreads);
-    handler.PSendSysMessage("%u scripts scheduled", m_scriptSchedule.size());
+    handler.PSendSysMessage("%u units motion updated [%u threads]", _unitsMvtUpdated, _unitsMvtUpdateThreads);
+    handler.PSendSysMessage(UI64FMTD " script steps scheduled [" UI64FMTD " started, " UI64FMTD " executed, " UI64FMTD " terminated]",
+        GetScriptStepsPending(), m_scriptStepsScheduled.load(), m_scriptStepsExecuted, m_scriptStepsTerminated);
     handler.PSendSysMessage("Vis:%.1f Act:%.1f", m_VisibleDistance, m_GridActivationDistance);
+    if (m_barrierWaitTime.count)
+        handler.PSendSysMessage("Continents barrier wait: last %ums, max %ums, avg %ums over %u ticks",
+            m_barrierWaitTime.last, m_barrierWaitTime.max, uint32(m_barrierWaitTime.total / m_barrierWaitTime.count), m_barrierWaitTime.count);
 }
@@ -44,8 +44,12 @@
 #include "WorldSession.h"
 #include "SQLStorages.h"
 #include "CreatureLinkingMgr.h"
+#include "MapWorkQueue.h"
+#include "Utilities/EventProcessor.h"
 
+#include <atomic>
 #include <bitset>
+#include <deque>
 #include <list>
 #include <set>
 
@@ -70,6 +74,7 @@ struct ScriptInfo;
 class BattleGround;
 class GridMap;
 class Transport;
+class ScriptStepEvent;
 
 namespace VMAP
 {
@@ -193,9 +198,55 @@ typedef ACE_Thread_Mutex MapMutexType; // Use ACE_Null_Mutex to disable locks
 
 typedef bool(Map::*ScriptCommandFunction) (ScriptAction& step, Object* source, Object* target);
 
+// Map::Update phases, as in the slow map update performance log
+enum MapUpdatePhase
+{
+    MAP_UPDATE_PHASE_SESSIONS,
+    MAP_UPDATE_PHASE_PLAYERS,
+    MAP_UPDATE_PHASE_CELLS,
+    MAP_UPDATE_PHASE_SEND_OBJ_UPDATES,
+    MAP_UPDATE_PHASE_RELOCATIONS,
+    MAP_UPDATE_PHASE_PLAYERS2,
+    MAP_UPDATE_PHASE_BARRIER_WAIT,
+    MAP_UPDATE_PHASE_TOTAL,                                 // without the barrier wait
+    MAX_MAP_UPDATE_PHASES
+};
+
+// Time spent in each phase in ms, over the updates since the last reset
+struct MapUpdatePhaseStats
+{
+    MapUpdatePhaseStats() { Reset(); }
+
+    void Reset()
+    {
+        updates = 0;
+        for (uint32 i = 0; i < MAX_MAP_UPDATE_PHASES; ++i)
+        {
+            total[i] = 0;
+            max[i] = 0;
+        }
+    }
+
+    void Add(uint32 const (&times)[MAX_MAP_UPDATE_PHASES])
+    {
+        ++updates;
+        for (uint32 i = 0; i < MAX_MAP_UPDATE_PHASES; ++i)
+        {
+            total[i] += times[i];
+            if (times[i] > max[i])
+                max[i] = times[i];
+        }
+    }
+
+    uint32 updates;
+    uint64 total[MAX_MAP_UPDATE_PHASES];
+    uint32 max[MAX_MAP_UPDATE_PHASES];
+};
+
 class MANGOS_DLL_SPEC Map : public GridRefManager<NGridType>, public MaNGOS::ObjectLevelLockable<Map, ACE_Thread_Mutex>
 {
     friend class MapReference;
+    friend class ScriptStepEvent;
     friend class ObjectGridLoader;
     friend class ObjectWorldLoader;
 
@@ -205,6 +256,9 @@ class MANGOS_DLL_SPEC Map : public GridRefManager<NGridType>, public MaNGOS::Obj
     public:
         virtual ~Map();
         void PrintInfos(ChatHandler& handler);
+        // Read between two map system updates only
+        MapUpdatePhaseStats const& GetUpdatePhaseStats() const { return m_updatePhaseStats; }
+        void ResetUpdatePhaseStats() { m_updatePhaseStats.Reset(); }
         void SpawnActiveObjects();
         // currently unused for normal maps
         bool CanUnload(uint32 diff)
@@ -229,8 +283,10 @@ class MANGOS_DLL_SPEC Map : public GridRefManager<NGridType>, public MaNGOS::Obj
         inline void UpdateActiveCellsAsynch(uint32 now, uint32 diff);
         inline void UpdateActiveCellsCallback(uint32 diff, uint32 now, uint32 threadId, uint32 totalThreads, uint32 step);
         inline void UpdateCells(uint32 diff);
+        void UpdateMotionAsync(uint32 diff);
         void UpdateSync(const uint32);
         void UpdatePlayers();
+        uint32 GetIdleUpdateDelay() const;
         void DoUpdate(uint32 maxDiff);
         virtual void Update(uint32);
         void UpdateSessionsMovementAndSpellsIfNeeded();
@@ -326,9 +382,11 @@ class MANGOS_DLL_SPEC Map : public GridRefManager<NGridType>, public MaNGOS::Obj
         PlayerList const& GetPlayers() const { return m_mapRefManager; }
 
         //per-map script storage
+        // Can be called from any thread, delays are in seconds
         void ScriptsStart(std::map<uint32, std::multimap<uint32, ScriptInfo> > const& scripts, uint32 id, Object* source, Object* target);
         void ScriptCommandStart(ScriptInfo const& script, uint32 delay, Object* source, Object* target);
         void TerminateScript(ScriptAction& step);
+        uint64 GetScriptStepsPending() const { return m_scriptStepsScheduled - m_scriptStepsExecuted - m_scriptStepsTerminated; }
 
         // must called with AddToWorld
         void AddToActive(WorldObject* obj);
@@ -384,34 +442,13 @@ class MANGOS_DLL_SPEC Map : public GridRefManager<NGridType>, public MaNGOS::Obj
             i_objectsToClientUpdate_lock.release();
         }
         // May be called from a different map ...
-        void AddRelocatedUnit(Unit* obj)
-        {
-            if (_processingUnitsRelocation)
-                return;
-            i_unitsRelocated_lock.acquire();
-            i_unitsRelocated.insert(obj);
-            i_unitsRelocated_lock.release();
-        }
-        void RemoveRelocatedUnit(Unit* obj)
-        {
-            ASSERT(!_processingUnitsRelocation);
-            i_unitsRelocated_lock.acquire();
-            i_unitsRelocated.erase(obj);
-            i_unitsRelocated_lock.release();
-        }
+        void AddRelocatedUnit(Unit* obj);
+        void RemoveRelocatedUnit(Unit* obj);
 
-        void AddUnitToMovementUpdate(Unit* unit)
-        {
-            unitsMvtUpdate_lock.acquire();
-            unitsMvtUpdate.insert(unit);
-            unitsMvtUpdate_lock.release();
-        }
-        void RemoveUnitFromMovementUpdate(Unit* unit)
-        {
-            unitsMvtUpdate_lock.acquire();
-            unitsMvtUpdate.erase(unit);
-            unitsMvtUpdate_lock.release();
-        }
+        void AddUnitToMovementUpdate(Unit* unit);
+        void RemoveUnitFromMovementUpdate(Unit* unit);
+        // 0 if motion updates are not batched on this map
+        uint32 GetMotionUpdateThreads() const;
         // DynObjects currently
         uint32 GenerateLocalLowGuid(HighGuid guidhigh);
 
@@ -530,7 +567,10 @@ class MANGOS_DLL_SPEC Map : public GridRefManager<NGridType>, public MaNGOS::Obj
         void setGridObjectDataLoaded(bool pLoaded, uint32 x, uint32 y) { getNGrid(x,y)->setGridObjectDataLoaded(pLoaded); }
 
         void setNGrid(NGridType* grid, uint32 x, uint32 y);
-        void ScriptsProcess();
+        void ScriptsProcess(uint32 diff);
+        void ScriptStepExecute(ScriptAction& step);
+        void QueueScriptSteps(ScriptStepEvent* first, ScriptStepEvent* last, uint32 count);
+        bool FlushScriptQueue();
 
         void SendObjectUpdates();
         void UpdateVisibilityForRelocations();
@@ -538,15 +578,21 @@ class MANGOS_DLL_SPEC Map : public GridRefManager<NGridType>, public MaNGOS::Obj
         bool                    _processingSendObjUpdates;
         uint32                  _objUpdatesThreads;
         mutable MapMutexType    i_objectsToClientUpdate_lock;
-        std::set<Object *>      i_objectsToClientUpdate;
+        typedef MapWorkQueue<Object, Object, &Object::m_clientUpdateQueueSlot> ClientUpdateQueue;
+        typedef MapWorkQueue<Unit, WorldObject, &WorldObject::m_relocatedQueueSlot> RelocatedUnitsQueue;
+        typedef MapWorkQueue<Unit, WorldObject, &WorldObject::m_movementQueueSlot> MovementUpdateQueue;
+
+        ClientUpdateQueue       i_objectsToClientUpdate;
 
         bool                    _processingUnitsRelocation;
         uint32                  _unitRelocationThreads;
         mutable MapMutexType    i_unitsRelocated_lock;
-        std::set<Unit* >        i_unitsRelocated;
+        RelocatedUnitsQueue     i_unitsRelocated;
 
         mutable MapMutexType    unitsMvtUpdate_lock;
-        std::set<Unit*>         unitsMvtUpdate;
+        MovementUpdateQueue     unitsMvtUpdate;
+        uint32                  _unitsMvtUpdated;
+        uint32                  _unitsMvtUpdateThreads;
 
     protected:
         MapEntry const* i_mapEntry;
@@ -593,11 +639,14 @@ class MANGOS_DLL_SPEC Map : public GridRefManager<NGridType>, public MaNGOS::Obj
         std::bitset<TOTAL_NUMBER_OF_CELLS_PER_MAP*TOTAL_NUMBER_OF_CELLS_PER_MAP> marked_cells;
 
         mutable MapMutexType    i_objectsToRemove_lock;
-        std::set<WorldObject *> i_objectsToRemove;
+        MapWorkQueue<WorldObject, WorldObject, &WorldObject::m_removeQueueSlot> i_objectsToRemove;
 
-        typedef std::multimap<time_t, ScriptAction> ScriptScheduleMap;
-        MapMutexType      m_scriptSchedule_lock;
-        ScriptScheduleMap m_scriptSchedule;
+        // Script steps are queued without lock by any thread, and timed by the map update in ms
+        std::atomic<ScriptStepEvent*> m_scriptQueue;        // last queued step
+        EventProcessor    m_scriptSchedule;
+        std::atomic<uint64> m_scriptStepsScheduled;
+        uint64            m_scriptStepsExecuted;
+        uint64            m_scriptStepsTerminated;
 
         InstanceData* i_data;
         uint32 i_script_id;
@@ -624,6 +673,37 @@ class MANGOS_DLL_SPEC Map : public GridRefManager<NGridType>, public MaNGOS::Obj
 
         int8 _updateIdx;
 
+        // Time spent waiting for the other continents at the end of Map::Update
+        struct BarrierWaitStats
+        {
+            BarrierWaitStats() : last(0), max(0), count(0), total(0) {}
+            uint32 last;
+            uint32 max;
+            uint32 count;
+            uint64 total;
+        };
+        BarrierWaitStats m_barrierWaitTime;
+        MapUpdatePhaseStats m_updatePhaseStats;
+
+        // Continents load the grids players are heading to ahead of time (GridPrefetch.* config)
+        void UpdateGridPrefetch(uint32 diff);
+        void PrefetchGridsAround(float x, float y);
+
+        struct GridPrefetchSample
+        {
+            float x;
+            float y;
+        };
+        struct GridPrefetchRequest
+        {
+            GridPair grid;
+            uint32 queueTime;
+        };
+        typedef UNORDERED_MAP<ObjectGuid, GridPrefetchSample> GridPrefetchSamples;
+        GridPrefetchSamples m_gridPrefetchSamples;              // player positions at the last prediction
+        std::deque<GridPrefetchRequest> m_gridPrefetchQueue;    // grids waiting for their objects to be spawned
+        uint32 m_gridPrefetchTimer;
+
         // Holder for information about linked mobs
         CreatureLinkingHolder m_creatureLinkingHolder;
 
@@ -40,9 +40,8 @@ MapManager::MapManager()
     : i_gridCleanUpDelay(sWorld.getConfig(CONFIG_UINT32_INTERVAL_GRIDCLEAN)),
     i_MaxInstanceId(RESERVED_INSTANCES_LAST),
     i_GridStateErrorCount(0),
-    i_continentUpdateFinished(NULL),
-    i_maxContinentThread(0),
-    asyncMapUpdating(false)
+    asyncMapUpdating(false),
+    m_jobPool([]() { WorldDatabase.ThreadStart(); }, []() { WorldDatabase.ThreadEnd(); })
 {
     i_timer.SetInterval(sWorld.getConfig(CONFIG_UINT32_INTERVAL_MAPUPDATE));
 }
@@ -73,6 +72,9 @@ MapManager::Initialize()
         terrain->AddRef(); // So it won't be deleted
         terrain->LoadAll();
     }
+
+    if (sWorld.getConfig(CONFIG_BOOL_GRID_PREFETCH))
+        m_terrainLoader.Start();
 }
 
 void MapManager::InitStateMachine()
@@ -239,55 +241,6 @@ void MapManager::DeleteInstance(uint32 mapid, uint32 instanceId)
     }
 }
 
-class MapAsyncUpdater : public ACE_Based::Runnable
-{
-public:
-    MapAsyncUpdater(bool* updFinished, uint32 updateDiff) :
-        updateFinished(updFinished), diff(updateDiff), loops(0)
-    {
-    }
-
-    virtual void run()
-    {
-        WorldDatabase.ThreadStart();
-        do
-        {
-            for (std::vector<Map*>::iterator it = maps.begin(); it != maps.end(); ++it)
-            {
-                if (loops && *updateFinished)
-                    break;
-                (*it)->DoUpdate(diff);
-            }
-            if (!(*updateFinished))
-                ACE_Based::Thread::Sleep(5);
-            ++loops;
-        }
-        while (!(*updateFinished));
-        WorldDatabase.ThreadEnd();
-    }
-    std::vector<Map*> maps;
-    volatile bool* updateFinished;
-    uint32 diff;
-    uint32 loops;
-};
-
-class ContinentAsyncUpdater : public ACE_Based::Runnable
-{
-public:
-    ContinentAsyncUpdater(uint32 updateDiff, Map* m) : diff(updateDiff), map(m)
-    {
-    }
-
-    virtual void run()
-    {
-        WorldDatabase.ThreadStart();
-        map->DoUpdate(diff);
-        WorldDatabase.ThreadEnd();
-    }
-    Map* map;
-    uint32 diff;
-};
-
 void MapManager::Update(uint32 diff)
 {
     i_timer.Update(diff);
@@ -299,14 +252,17 @@ void MapManager::Update(uint32 diff)
     ExecuteDelayedPlayerTeleports();
 
     uint32 mapsDiff = (uint32)i_timer.GetCurrent();
-    bool updateFinished = false;
+    uint32 updateBeginTime = WorldTimer::getMSTime();
     asyncMapUpdating = true;
-    std::vector<MapAsyncUpdater*> instanceUpdaters(sWorld.getConfig(CONFIG_UINT32_MAPUPDATE_INSTANCED_UPDATE_THREADS));
-    std::vector<ContinentAsyncUpdater*> continentsUpdaters;
-    for (int i = 0; i < instanceUpdaters.size(); ++i)
-        instanceUpdaters[i] = new MapAsyncUpdater(&updateFinished, mapsDiff); // Will be deleted at thread end
+    uint32 instanceThreads = sWorld.getConfig(CONFIG_UINT32_MAPUPDATE_INSTANCED_UPDATE_THREADS);
+    // Map threads take part in their own jobs, the pool provides the others
+    uint32 jobThreads = std::max(sWorld.getConfig(CONFIG_UINT32_MAP_OBJECTSUPDATE_THREADS), sWorld.getConfig(CONFIG_UINT32_MAP_VISIBILITYUPDATE_THREADS));
+    jobThreads = std::max(jobThreads, sWorld.getConfig(CONFIG_UINT32_CONTINENTS_MOTIONUPDATE_THREADS));
+    jobThreads = std::max(jobThreads, sWorld.getConfig(CONFIG_UINT32_INSTANCES_MOTIONUPDATE_THREADS));
+    m_jobPool.EnsureThreads(jobThreads - 1);
+    std::vector<Map*> continents;
+    std::vector<Map*> instances;
 
-    int mapIdx = 0;
     int continentsIdx = 0;
     uint32 now = WorldTimer::getMSTime();
     for (MapMapType::iterator iter = i_maps.begin(); iter != i_maps.end(); ++iter)
@@ -322,52 +278,49 @@ void MapManager::Update(uint32 diff)
         iter->second->SetMapUpdateIndex(-1);
         if (iter->second->Instanceable())
         {
-            if (instanceUpdaters.size())
-            {
-                instanceUpdaters[mapIdx % instanceUpdaters.size()]->maps.push_back(iter->second);
-                ++mapIdx;
-            }
+            if (instanceThreads)
+                instances.push_back(iter->second);
             else
                 iter->second->Update(mapsDiff);
         }
-        else // One threat per continent part
+        else // One worker per continent part
         {
             iter->second->SetMapUpdateIndex(continentsIdx++);
-            ContinentAsyncUpdater* task = new ContinentAsyncUpdater(mapsDiff, iter->second);
-            continentsUpdaters.push_back(task);
+            continents.push_back(iter->second);
         }
     }
-    i_maxContinentThread = continentsIdx;
-    i_continentUpdateFinished = new volatile bool[i_maxContinentThread];
-    for (int i = 0; i < i_maxContinentThread; ++i)
-        i_continentUpdateFinished[i] = false;
+    i_continentsBarrier.Reset(continentsIdx);
 
-    std::vector<ACE_Based::Thread*> asyncUpdateThreads(instanceUpdaters.size() + continentsUpdaters.size());
+    // Continents wait for each other at the end of their update, so each one
+    // needs its own worker on top of the instance workers.
+    if (!continents.empty() || !instances.empty())
+        m_updater.EnsureWorkers(continents.size() + instanceThreads);
 
-    for (int tid = 0; tid < instanceUpdaters.size(); ++tid)
-        asyncUpdateThreads[tid]                             = new ACE_Based::Thread(instanceUpdaters[tid]);
-    for (int tid = 0; tid < continentsUpdaters.size(); ++tid)
-        asyncUpdateThreads[tid + instanceUpdaters.size()]   = new ACE_Based::Thread(continentsUpdaters[tid]);
+    m_updater.BeginTick(mapsDiff);
+    for (Map* map : continents)
+        m_updater.ScheduleContinent(map);
+    for (Map* map : instances)
+        m_updater.ScheduleInstance(map);
 
     // Finish continents updating
-    for (int tid = instanceUpdaters.size(); tid < asyncUpdateThreads.size(); ++tid)
-    {
-        asyncUpdateThreads[tid]->wait();
-        delete asyncUpdateThreads[tid];
-    }
+    m_updater.WaitForContinents();
 
-    updateFinished = true;
     SwitchPlayersInstances();
 
     // And then instances updating
-    for (int tid = 0; tid < instanceUpdaters.size(); ++tid)
+    m_updater.FinishTick();
+    asyncMapUpdating = false;
+
+    uint32 updateTime = WorldTimer::getMSTimeDiffToNow(updateBeginTime);
+    if (sWorld.getConfig(CONFIG_UINT32_PERFLOG_SLOW_MAPSYSTEM_UPDATE) && updateTime > sWorld.getConfig(CONFIG_UINT32_PERFLOG_SLOW_MAPSYSTEM_UPDATE))
     {
-        asyncUpdateThreads[tid]->wait();
-        delete asyncUpdateThreads[tid];
+        for (uint32 i = 0; i < m_updater.GetWorkerCount(); ++i)
+        {
+            MapUpdatePool::WorkerStats const& stats = m_updater.GetWorkerStats(i);
+            sLog.out(LOG_PERFORMANCE, "MapUpdater worker %02u: %4ums busy [%3u updates|%2u stolen] in %ums tick",
+                i, stats.busyTime, stats.updates, stats.stolen, updateTime);
+        }
     }
-    delete[] i_continentUpdateFinished;
-    i_continentUpdateFinished = NULL;
-    asyncMapUpdating = false;
 
     // Execute far teleports after all map updates have finished
     ExecuteDelayedPlayerTeleports();
@@ -429,6 +382,10 @@ bool MapManager::IsValidMAP(uint32 mapid)
 
 void MapManager::UnloadAll()
 {
+    m_updater.Stop();
+    m_jobPool.Stop();
+    m_terrainLoader.Stop();
+
     for (MapMapType::iterator iter = i_maps.begin(); iter != i_maps.end(); ++iter)
         iter->second->UnloadAll(true);
 
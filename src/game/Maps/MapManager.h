@@ -29,6 +29,10 @@
 #include "ace/Thread_Mutex.h"
 #include "Map.h"
 #include "GridStates.h"
+#include "MapUpdater.h"
+#include "JobPool.h"
+#include "TerrainLoader.h"
+#include "TickBarrier.h"
 
 class BattleGround;
 
@@ -187,22 +191,17 @@ class MANGOS_DLL_DECL MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::
         void ExecuteSingleDelayedTeleport(Player *player);
         void CancelDelayedPlayerTeleport(Player *player);
 
-        void MarkContinentUpdateFinished(int idx)
-        {
-            ASSERT(idx < i_maxContinentThread);
-            i_continentUpdateFinished[idx] = true;
-        }
-        bool IsContinentUpdateFinished()
+        // Threads shared by the parallel phases of every map update
+        JobPool& GetJobPool() { return m_jobPool; }
+
+        // Only running with GridPrefetch.Enable
+        TerrainLoader& GetTerrainLoader() { return m_terrainLoader; }
+
+        // Called by every continent at the end of its update. Returns once all
+        // continents are done, running 'idle' in the meantime.
+        uint32 WaitForContinentsUpdate(TickBarrier::IdleTask const& idle)
         {
-            // Check pointer rather than deref. Deleted after
-            // continent and instance updates are finished
-            if (i_continentUpdateFinished == NULL)
-                return true;
-
-            for (int i = 0; i < i_maxContinentThread; ++i)
-                if (!i_continentUpdateFinished[i])
-                    return false;
-            return true;
+            return i_continentsBarrier.ArriveAndWait(idle);
         }
     private:
 
@@ -230,9 +229,11 @@ class MANGOS_DLL_DECL MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::
         IntervalTimer i_timer;
 
         uint32 i_MaxInstanceId;
-        int             i_maxContinentThread;
-        volatile bool*  i_continentUpdateFinished;
+        TickBarrier     i_continentsBarrier;
         bool asyncMapUpdating;
+        MapUpdatePool   m_updater;
+        JobPool         m_jobPool;
+        TerrainLoader   m_terrainLoader;
 
         // Instanced continent zones
         const static int LAST_CONTINENT_ID = 2;
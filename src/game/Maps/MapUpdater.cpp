@@ -0,0 +1,285 @@
+/*
+ * Copyright (C) 2017 Light's Hope <https://lightshope.org>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "MapUpdater.h"
+#include "Map.h"
+#include "Timer.h"
+#include "Log.h"
+#include "Database/DatabaseEnv.h"
+
+// Minimum delay between two updates of the same instance while continents are still running
+#define INSTANCE_REUPDATE_DELAY 5
+
+MapUpdatePool::MapUpdatePool() : m_queuedTasks(0), m_activeMaps(0), m_pendingContinents(0),
+    m_repeatInstances(false), m_stop(false), m_diff(0), m_nextContinentWorker(0), m_nextInstanceWorker(0)
+{
+}
+
+MapUpdatePool::~MapUpdatePool()
+{
+    Stop();
+}
+
+void MapUpdatePool::EnsureWorkers(uint32 count)
+{
+    if (count <= m_workers.size())
+        return;
+
+    // Workers walk the whole worker list when stealing, so the list is only
+    // rebuilt while every thread is stopped. Only happens when a new continent
+    // instance appears, or on first use.
+    uint32 oldCount = m_workers.size();
+    Stop();
+
+    m_stop = false;
+    for (uint32 i = 0; i < count; ++i)
+    {
+        m_workers.emplace_back(new Worker());
+        memset(&m_workers.back()->stats, 0, sizeof(WorkerStats));
+    }
+    for (uint32 i = 0; i < count; ++i)
+        m_workers[i]->thread = std::thread(&MapUpdatePool::Work, this, i);
+
+    sLog.outInfo("[MapUpdater] Map update workers: %u -> %u", oldCount, count);
+}
+
+void MapUpdatePool::Stop()
+{
+    if (m_workers.empty())
+        return;
+
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_stop = true;
+    }
+    m_workAvailable.notify_all();
+
+    for (auto& worker : m_workers)
+        if (worker->thread.joinable())
+            worker->thread.join();
+    m_workers.clear();
+}
+
+void MapUpdatePool::BeginTick(uint32 diff)
+{
+    MANGOS_ASSERT(m_activeMaps == 0);
+    m_diff = diff;
+    m_repeatInstances = true;
+    m_nextContinentWorker = 0;
+    m_nextInstanceWorker = 0;
+    for (auto& worker : m_workers)
+        memset(&worker->stats, 0, sizeof(WorkerStats));
+}
+
+void MapUpdatePool::ScheduleContinent(Map* map)
+{
+    MANGOS_ASSERT(!m_workers.empty());
+    ++m_activeMaps;
+    ++m_pendingContinents;
+    Task task = { map, true };
+    Push(m_nextContinentWorker++ % m_workers.size(), task);
+}
+
+void MapUpdatePool::ScheduleInstance(Map* map)
+{
+    MANGOS_ASSERT(!m_workers.empty());
+    ++m_activeMaps;
+    // Fill from the last worker, continents are placed from the first one
+    uint32 count = m_workers.size();
+    Task task = { map, false };
+    Push(count - 1 - (m_nextInstanceWorker++ % count), task);
+}
+
+void MapUpdatePool::WaitForContinents()
+{
+    std::unique_lock<std::mutex> guard(m_lock);
+    m_tickState.wait(guard, [this]() { return m_pendingContinents == 0; });
+}
+
+void MapUpdatePool::FinishTick()
+{
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_repeatInstances = false;
+    }
+    m_workAvailable.notify_all();
+
+    std::unique_lock<std::mutex> guard(m_lock);
+    m_tickState.wait(guard, [this]() { return m_activeMaps == 0; });
+}
+
+void MapUpdatePool::Push(uint32 workerIdx, Task const& task)
+{
+    {
+        std::lock_guard<std::mutex> guard(m_workers[workerIdx]->lock);
+        m_workers[workerIdx]->tasks.push_back(task);
+    }
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        ++m_queuedTasks;
+    }
+    m_workAvailable.notify_one();
+}
+
+bool MapUpdatePool::TakeTask(uint32 workerIdx, Task& task)
+{
+    if (!m_queuedTasks)
+        return false;
+
+    Worker& self = *m_workers[workerIdx];
+    {
+        std::lock_guard<std::mutex> guard(self.lock);
+        if (!self.tasks.empty())
+        {
+            task = self.tasks.back();
+            self.tasks.pop_back();
+            --m_queuedTasks;
+            return true;
+        }
+    }
+
+    uint32 count = m_workers.size();
+    for (uint32 i = 1; i < count; ++i)
+    {
+        Worker& victim = *m_workers[(workerIdx + i) % count];
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if (victim.tasks.empty())
+            continue;
+
+        task = victim.tasks.front();
+        victim.tasks.pop_front();
+        --m_queuedTasks;
+        ++self.stats.stolen;
+        return true;
+    }
+    return false;
+}
+
+void MapUpdatePool::Work(uint32 workerIdx)
+{
+    WorldDatabase.ThreadStart();
+
+    Worker& self = *m_workers[workerIdx];
+    Task task;
+    while (true)
+    {
+        if (TakeTask(workerIdx, task))
+        {
+            Execute(workerIdx, task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> guard(m_lock);
+        if (m_stop)
+            break;
+        if (m_queuedTasks)
+            continue;
+
+        if (self.parked.empty())
+        {
+            m_workAvailable.wait(guard);
+            continue;
+        }
+
+        if (!m_repeatInstances)
+        {
+            guard.unlock();
+            DropParkedMaps(workerIdx);
+            continue;
+        }
+
+        // Sleep until the next instance re-update is due, or new work arrives
+        uint32 now = WorldTimer::getMSTime();
+        uint32 wait = INSTANCE_REUPDATE_DELAY;
+        for (auto const& parked : self.parked)
+        {
+            uint32 elapsed = WorldTimer::getMSTimeDiff(parked.lastUpdate, now);
+            uint32 remaining = elapsed >= INSTANCE_REUPDATE_DELAY ? 0 : INSTANCE_REUPDATE_DELAY - elapsed;
+            if (remaining < wait)
+                wait = remaining;
+        }
+        if (wait)
+            m_workAvailable.wait_for(guard, std::chrono::milliseconds(wait));
+        guard.unlock();
+        UpdateParkedMaps(workerIdx);
+    }
+
+    WorldDatabase.ThreadEnd();
+}
+
+void MapUpdatePool::Execute(uint32 workerIdx, Task const& task)
+{
+    Worker& self = *m_workers[workerIdx];
+    uint32 beginTime = WorldTimer::getMSTime();
+    task.map->DoUpdate(m_diff);
+    self.stats.busyTime += WorldTimer::getMSTimeDiffToNow(beginTime);
+    ++self.stats.updates;
+
+    if (task.continent)
+    {
+        if (--m_pendingContinents == 0)
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            m_tickState.notify_all();
+        }
+        OnMapDone(1);
+    }
+    else if (m_repeatInstances)
+    {
+        ParkedMap parked = { task.map, WorldTimer::getMSTime() };
+        self.parked.push_back(parked);
+    }
+    else
+        OnMapDone(1);
+}
+
+void MapUpdatePool::UpdateParkedMaps(uint32 workerIdx)
+{
+    Worker& self = *m_workers[workerIdx];
+    for (auto& parked : self.parked)
+    {
+        if (!m_repeatInstances)
+            break;
+
+        uint32 now = WorldTimer::getMSTime();
+        if (WorldTimer::getMSTimeDiff(parked.lastUpdate, now) < INSTANCE_REUPDATE_DELAY)
+            continue;
+
+        parked.map->DoUpdate(m_diff);
+        self.stats.busyTime += WorldTimer::getMSTimeDiffToNow(now);
+        ++self.stats.updates;
+        parked.lastUpdate = WorldTimer::getMSTime();
+    }
+}
+
+void MapUpdatePool::DropParkedMaps(uint32 workerIdx)
+{
+    Worker& self = *m_workers[workerIdx];
+    uint32 count = self.parked.size();
+    self.parked.clear();
+    OnMapDone(count);
+}
+
+void MapUpdatePool::OnMapDone(uint32 count)
+{
+    if (count && (m_activeMaps -= count) == 0)
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_tickState.notify_all();
+    }
+}
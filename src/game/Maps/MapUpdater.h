@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2017 Light's Hope <https://lightshope.org>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_MAPUPDATER_H
+#define MANGOS_MAPUPDATER_H
+
+#include "Common.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class Map;
+
+/*
+ * Long-lived pool of map update workers used by MapManager::Update.
+ *
+ * Every worker owns a deque of map updates. A worker pops its own work from
+ * the back and, once empty, steals from the front of the other workers'
+ * deques, so slow instances no longer hold back the maps statically assigned
+ * behind them.
+ *
+ * Continents are scheduled one per worker: they wait for each other at the
+ * end of Map::Update, so the pool always keeps at least one worker per
+ * continent. Instances are updated once, then re-updated by the worker that
+ * ran them until every continent is done (same behaviour as the old
+ * per-tick MapAsyncUpdater threads).
+ */
+class MapUpdatePool
+{
+    public:
+        struct WorkerStats
+        {
+            uint32 busyTime;        // ms spent in Map::DoUpdate during the last tick
+            uint32 updates;         // map updates executed (including instance re-updates)
+            uint32 stolen;          // tasks taken from another worker's deque
+        };
+
+        MapUpdatePool();
+        ~MapUpdatePool();
+
+        // Spawns workers until at least 'count' are running. Never shrinks.
+        void EnsureWorkers(uint32 count);
+        void Stop();
+
+        void BeginTick(uint32 diff);
+        void ScheduleContinent(Map* map);
+        void ScheduleInstance(Map* map);
+        // Blocks until every continent scheduled this tick has finished its update
+        void WaitForContinents();
+        // Stops re-updating instances and blocks until every worker is idle
+        void FinishTick();
+
+        uint32 GetWorkerCount() const { return m_workers.size(); }
+        // Only meaningful between FinishTick and the next BeginTick
+        WorkerStats const& GetWorkerStats(uint32 idx) const { return m_workers[idx]->stats; }
+
+    private:
+        struct Task
+        {
+            Map* map;
+            bool continent;
+        };
+
+        struct ParkedMap
+        {
+            Map* map;
+            uint32 lastUpdate;
+        };
+
+        struct Worker
+        {
+            std::mutex lock;
+            std::deque<Task> tasks;
+            std::vector<ParkedMap> parked; // owned by the worker thread only
+            std::thread thread;
+            WorkerStats stats;
+        };
+
+        void Push(uint32 workerIdx, Task const& task);
+        bool TakeTask(uint32 workerIdx, Task& task);
+        void Work(uint32 workerIdx);
+        void Execute(uint32 workerIdx, Task const& task);
+        void UpdateParkedMaps(uint32 workerIdx);
+        void DropParkedMaps(uint32 workerIdx);
+        void OnMapDone(uint32 count);
+
+        std::vector<std::unique_ptr<Worker> > m_workers;
+
+        std::mutex m_lock;
+        std::condition_variable m_workAvailable;
+        std::condition_variable m_tickState;
+
+        std::atomic<uint32> m_queuedTasks;         // tasks sitting in a deque
+        std::atomic<uint32> m_activeMaps;          // maps not done for this tick (includes parked instances)
+        std::atomic<uint32> m_pendingContinents;
+        std::atomic_bool m_repeatInstances;
+        std::atomic_bool m_stop;
+
+        uint32 m_diff;
+        uint32 m_nextContinentWorker;
+        uint32 m_nextInstanceWorker;
+};
+
+#endif
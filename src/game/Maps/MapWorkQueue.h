@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2017 Light's Hope <https://lightshope.org>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_MAPWORKQUEUE_H
+#define MANGOS_MAPWORKQUEUE_H
+
+#include "Platform/Define.h"
+#include <vector>
+
+/*
+ * Flat set of objects queued for some per-tick map work (client updates,
+ * visibility updates ...).
+ *
+ * Each queued object remembers its index in the queue ('Slot' member, which
+ * may live in a base class of T so that T can stay incomplete here), so
+ * insert and erase are O(1) without any allocation once the vector has grown,
+ * and workers can split the contiguous storage directly.
+ * A slot is only trusted if the queue holds the object at that index: stale
+ * slots left by Clear, or by a queue of another map, are harmless.
+ * Order is not kept on erase (last item is moved in the hole).
+ *
+ * Not thread safe, Map guards every queue with its own lock.
+ */
+template <class T, class SlotOwner, uint32 SlotOwner::*Slot>
+class MapWorkQueue
+{
+    public:
+        typedef typename std::vector<T*>::const_iterator const_iterator;
+
+        // Returns false if already queued
+        bool insert(T* obj)
+        {
+            if (contains(obj))
+                return false;
+            obj->*Slot = m_items.size();
+            m_items.push_back(obj);
+            return true;
+        }
+
+        bool erase(T* obj)
+        {
+            if (!contains(obj))
+                return false;
+            uint32 slot = obj->*Slot;
+            T* last = m_items.back();
+            m_items[slot] = last;
+            last->*Slot = slot;
+            m_items.pop_back();
+            return true;
+        }
+
+        bool contains(T const* obj) const
+        {
+            uint32 slot = obj->*Slot;
+            return slot < m_items.size() && m_items[slot] == obj;
+        }
+
+        // Keeps the capacity, queues refill at the same rate every tick
+        void clear() { m_items.clear(); }
+
+        bool empty() const { return m_items.empty(); }
+        uint32 size() const { return m_items.size(); }
+        T* operator[](uint32 idx) const { return m_items[idx]; }
+        const_iterator begin() const { return m_items.begin(); }
+        const_iterator end() const { return m_items.end(); }
+
+    private:
+        std::vector<T*> m_items;
+};
+
+#endif
@@ -47,8 +47,22 @@ void MMapFactory::clear()
 }
 
 // ######################## MMapManager ########################
+namespace
+{
+    struct CachedNavMeshQuery
+    {
+        uint32 mapId;
+        uint32 generation;
+        dtNavMeshQuery const* query;
+    };
+
+    // A thread works on very few maps, a flat vector is enough
+    thread_local std::vector<CachedNavMeshQuery> threadNavMeshQueries;
+}
+
 MMapManager::~MMapManager()
 {
+    ++queriesGeneration;
     for (MMapDataSet::iterator i = loadedMMaps.begin(); i != loadedMMaps.end(); ++i)
         delete i->second;
 
@@ -141,6 +155,13 @@ bool MMapManager::loadMap(uint32 mapId, int32 x, int32 y)
     char *fileName = new char[pathLen];
     snprintf(fileName, pathLen, (sWorld.GetDataPath() + "mmaps/%03i%02i%02i.mmtile").c_str(), mapId, x, y);
 
+    if (sWorld.getConfig(CONFIG_BOOL_TERRAIN_MMAP))
+    {
+        bool result = loadMappedTile(mmap, fileName, mapId, x, y);
+        delete [] fileName;
+        return result;
+    }
+
     FILE *file = fopen(fileName, "rb");
     if (!file)
     {
@@ -203,6 +224,65 @@ bool MMapManager::loadMap(uint32 mapId, int32 x, int32 y)
     return false;
 }
 
+// Tile data points in a copy on write mapping of the file: pages only read by Detour
+// (vertices, detail meshes, BV tree) stay shared with the other processes
+bool MMapManager::loadMappedTile(MMapData* mmap, char const* fileName, uint32 mapId, int32 x, int32 y)
+{
+    MappedFile* file = new MappedFile();
+    if (!file->Open(fileName, true))
+    {
+        DEBUG_LOG("MMAP:loadMap: Could not open mmtile file '%s'", fileName);
+        delete file;
+        return false;
+    }
+
+    MmapTileHeader fileHeader;
+    if (file->GetSize() < sizeof(MmapTileHeader))
+        fileHeader.mmapMagic = 0;
+    else
+        memcpy(&fileHeader, file->GetData(), sizeof(MmapTileHeader));
+
+    if (fileHeader.mmapMagic != MMAP_MAGIC)
+    {
+        sLog.outError("MMAP:loadMap: Bad header in mmap %03u%02i%02i.mmtile", mapId, x, y);
+        delete file;
+        return false;
+    }
+
+    if (fileHeader.mmapVersion != MMAP_VERSION)
+    {
+        sLog.outError("MMAP:loadMap: %03u%02i%02i.mmtile was built with generator v%i, expected v%i",
+                      mapId, x, y, fileHeader.mmapVersion, MMAP_VERSION);
+        delete file;
+        return false;
+    }
+
+    if (file->GetSize() < sizeof(MmapTileHeader) + fileHeader.size)
+    {
+        sLog.outError("MMAP:loadMap: Bad header or data in mmap %03u%02i%02i.mmtile", mapId, x, y);
+        delete file;
+        return false;
+    }
+
+    unsigned char* data = file->GetData() + sizeof(MmapTileHeader);
+    dtTileRef tileRef = 0;
+
+    // no DT_TILE_FREE_DATA, the mapping is released on unload
+    dtStatus dResult = mmap->navMesh->addTile(data, fileHeader.size, 0, 0, &tileRef);
+    if (dtStatusFailed(dResult))
+    {
+        sLog.outError("MMAP:loadMap: Could not load %03u%02i%02i.mmtile into navmesh [result 0x%x]", mapId, x, y, dResult);
+        delete file;
+        return false;
+    }
+
+    uint32 packedGridPos = packTileID(x, y);
+    mmap->mmapLoadedTiles.insert(std::pair<uint32, dtTileRef>(packedGridPos, tileRef));
+    mmap->mappedTiles[packedGridPos] = file;
+    ++loadedTiles;
+    return true;
+}
+
 bool MMapManager::unloadMap(uint32 mapId, int32 x, int32 y)
 {
     // check if we have this map loaded
@@ -238,6 +318,12 @@ bool MMapManager::unloadMap(uint32 mapId, int32 x, int32 y)
     else
     {
         mmap->mmapLoadedTiles.erase(packedGridPos);
+        MappedTileSet::iterator mapped = mmap->mappedTiles.find(packedGridPos);
+        if (mapped != mmap->mappedTiles.end())
+        {
+            delete mapped->second;
+            mmap->mappedTiles.erase(mapped);
+        }
         --loadedTiles;
         return true;
     }
@@ -266,6 +352,7 @@ bool MMapManager::unloadMap(uint32 mapId)
             --loadedTiles;
     }
 
+    ++queriesGeneration;
     delete mmap;
     loadedMMaps.erase(mapId);
     DETAIL_LOG("MMAP:unloadMap: Unloaded %03i.mmap", mapId);
@@ -292,6 +379,7 @@ bool MMapManager::unloadMapInstance(uint32 mapId, uint32 instanceId)
 
     dtNavMeshQuery* query = mmap->navMeshQueries[instanceId];
 
+    ++queriesGeneration;
     dtFreeNavMeshQuery(query);
     mmap->navMeshQueries.erase(instanceId);
     DETAIL_LOG("MMAP:unloadMapInstance: Unloaded mapId %03u instanceId %u", mapId, instanceId);
@@ -309,6 +397,18 @@ dtNavMesh const* MMapManager::GetNavMesh(uint32 mapId)
 
 dtNavMeshQuery const* MMapManager::GetNavMeshQuery(uint32 mapId)
 {
+    uint32 generation = queriesGeneration.load();
+    CachedNavMeshQuery* cached = NULL;
+    for (std::vector<CachedNavMeshQuery>::iterator it = threadNavMeshQueries.begin(); it != threadNavMeshQueries.end(); ++it)
+    {
+        if (it->mapId != mapId)
+            continue;
+        if (it->generation == generation)
+            return it->query;
+        cached = &*it;
+        break;
+    }
+
     if (loadedMMaps.find(mapId) == loadedMMaps.end())
         return NULL;
 
@@ -341,6 +441,14 @@ dtNavMeshQuery const* MMapManager::GetNavMeshQuery(uint32 mapId)
         navMeshQuery = it->second;
     mmap->navMeshQueries_lock.release();
 
+    if (!cached)
+    {
+        threadNavMeshQueries.push_back(CachedNavMeshQuery());
+        cached = &threadNavMeshQueries.back();
+        cached->mapId = mapId;
+    }
+    cached->generation = generation;
+    cached->query = navMeshQuery;
     return navMeshQuery;
 }
 
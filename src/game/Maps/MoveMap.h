@@ -22,8 +22,10 @@
 #include <ace/Guard_T.h>
 #include <ace/Thread_Mutex.h>
 #include <ace/RW_Mutex.h>
+#include <atomic>
 
 #include "Utilities/UnorderedMapSet.h"
+#include "MappedFile.h"
 
 #include "Detour/Include/DetourAlloc.h"
 #include "Detour/Include/DetourNavMesh.h"
@@ -45,6 +47,7 @@ namespace MMAP
 {
     typedef UNORDERED_MAP<uint32, dtTileRef> MMapTileSet;
     typedef UNORDERED_MAP<uint32, dtNavMeshQuery*> NavMeshQuerySet;
+    typedef UNORDERED_MAP<uint32, MappedFile*> MappedTileSet;
 
     // dummy struct to hold map's mmap data
     struct MMapData
@@ -57,6 +60,10 @@ namespace MMAP
 
             if (navMesh)
                 dtFreeNavMesh(navMesh);
+
+            // tiles data is not owned by the navmesh
+            for (MappedTileSet::iterator i = mappedTiles.begin(); i != mappedTiles.end(); ++i)
+                delete i->second;
         }
 
         dtNavMesh* navMesh;
@@ -65,6 +72,7 @@ namespace MMAP
         NavMeshQuerySet navMeshQueries;     // threadId to query
         ACE_RW_Mutex navMeshQueries_lock;
         MMapTileSet mmapLoadedTiles;        // maps [map grid coords] to [dtTile]
+        MappedTileSet mappedTiles;          // Terrain.MMap: maps [map grid coords] to the tile file
         ACE_Thread_Mutex tilesLoading_lock;
     };
 
@@ -75,7 +83,7 @@ namespace MMAP
     class MMapManager
     {
         public:
-            MMapManager() : loadedTiles(0) {}
+            MMapManager() : loadedTiles(0), queriesGeneration(0) {}
             ~MMapManager();
 
             bool loadMap(uint32 mapId, int32 x, int32 y);
@@ -86,6 +94,8 @@ namespace MMAP
 
             // The returned [dtNavMeshQuery const*] is NOT threadsafe
             // Returns a NavMeshQuery valid for current thread only.
+            // Queries are cached per thread, the lock is only taken on first use
+            // of a map by a thread, or after a query got freed.
             dtNavMeshQuery const* GetNavMeshQuery(uint32 mapId);
             dtNavMeshQuery const* GetModelNavMeshQuery(uint32 displayId);
             dtNavMesh const* GetNavMesh(uint32 mapId);
@@ -94,6 +104,7 @@ namespace MMAP
             uint32 getLoadedMapsCount() const { return loadedMMaps.size(); }
         private:
             bool loadMapData(uint32 mapId);
+            bool loadMappedTile(MMapData* mmap, char const* fileName, uint32 mapId, int32 x, int32 y);
             uint32 packTileID(int32 x, int32 y);
 
             MMapDataSet loadedMMaps;
@@ -101,6 +112,8 @@ namespace MMAP
             MMapDataSet loadedModels;
             uint32 loadedTiles;
             ACE_Thread_Mutex lockForModels;
+            // Bumped each time a query is freed, invalidates the per thread caches
+            std::atomic<uint32> queriesGeneration;
     };
 
     // static class
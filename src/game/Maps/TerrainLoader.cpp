@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2017 Light's Hope <https://lightshope.org>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "TerrainLoader.h"
+#include "GridMap.h"
+
+TerrainLoader::TerrainLoader() : m_stop(false), m_prefetched(0)
+{
+}
+
+TerrainLoader::~TerrainLoader()
+{
+    Stop();
+}
+
+void TerrainLoader::Start()
+{
+    if (IsRunning())
+        return;
+
+    m_stop = false;
+    m_thread = std::thread(&TerrainLoader::Work, this);
+}
+
+void TerrainLoader::Stop()
+{
+    if (!IsRunning())
+        return;
+
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_stop = true;
+    }
+    m_requestAvailable.notify_one();
+    m_thread.join();
+
+    for (std::deque<Request>::const_iterator itr = m_requests.begin(); itr != m_requests.end(); ++itr)
+        ReleaseTerrain(itr->terrain);
+    m_requests.clear();
+}
+
+void TerrainLoader::Queue(TerrainInfo* terrain, uint32 x, uint32 y)
+{
+    if (!IsRunning())
+        return;
+
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        for (std::deque<Request>::const_iterator itr = m_requests.begin(); itr != m_requests.end(); ++itr)
+            if (itr->terrain == terrain && itr->x == x && itr->y == y)
+                return;
+
+        terrain->AddRef();
+        Request request = { terrain, x, y };
+        m_requests.push_back(request);
+    }
+    m_requestAvailable.notify_one();
+}
+
+void TerrainLoader::Work()
+{
+    while (true)
+    {
+        Request request;
+        {
+            std::unique_lock<std::mutex> guard(m_lock);
+            m_requestAvailable.wait(guard, [this]() { return m_stop || !m_requests.empty(); });
+            if (m_stop)
+                return;
+
+            request = m_requests.front();
+            m_requests.pop_front();
+        }
+
+        request.terrain->Prefetch(request.x, request.y);
+        ++m_prefetched;
+        ReleaseTerrain(request.terrain);
+    }
+}
+
+void TerrainLoader::ReleaseTerrain(TerrainInfo* terrain)
+{
+    // the map using it may have been unloaded meanwhile
+    if (terrain->Release())
+        sTerrainMgr.UnloadTerrain(terrain->GetMapId());
+}
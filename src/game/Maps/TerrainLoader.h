@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2017 Light's Hope <https://lightshope.org>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_TERRAINLOADER_H
+#define MANGOS_TERRAINLOADER_H
+
+#include "Common.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+class TerrainInfo;
+
+/*
+ * Background thread prefetching the terrain of the grids players are about
+ * to enter (see Map::UpdateGridPrefetch), so that the file reads no longer
+ * happen inside the map update when the grid gets loaded.
+ *
+ * Queued terrains are referenced until their request is processed.
+ */
+class TerrainLoader
+{
+    public:
+        TerrainLoader();
+        ~TerrainLoader();
+
+        void Start();
+        void Stop();
+        bool IsRunning() const { return m_thread.joinable(); }
+
+        // Ignored if the loader is not running or the grid is already queued
+        void Queue(TerrainInfo* terrain, uint32 x, uint32 y);
+
+        uint32 GetPrefetchedCount() const { return m_prefetched; }
+
+    private:
+        struct Request
+        {
+            TerrainInfo* terrain;
+            uint32 x;
+            uint32 y;
+        };
+
+        void Work();
+        static void ReleaseTerrain(TerrainInfo* terrain);
+
+        std::thread m_thread;
+        std::mutex m_lock;
+        std::condition_variable m_requestAvailable;
+        std::deque<Request> m_requests;
+        bool m_stop;
+        std::atomic<uint32> m_prefetched;
+};
+
+#endif
@@ -100,11 +100,7 @@ Player* ObjectAccessor::FindPlayerByNameNotInWorld(const char *name)
     if (!normalizePlayerName(cppname))
         return nullptr;
 
-    NameToPlayerPtr::iterator it = playerNameToPlayerPointer.find(cppname);
-    if (it != playerNameToPlayerPointer.end())
-        return it->second;
-
-    return NULL;
+    return playerNameToPlayerPointer.Find(cppname);
 }
 
 Player* ObjectAccessor::FindPlayerByName(const char *name)
@@ -121,11 +117,7 @@ MasterPlayer* ObjectAccessor::FindMasterPlayer(const char *name)
     if (!normalizePlayerName(cppname))
         return nullptr;
 
-    NameToMasterPlayerPtr::iterator it = playerNameToMasterPlayerPointer.find(cppname);
-    if (it != playerNameToMasterPlayerPointer.end())
-        return it->second;
-
-    return NULL;
+    return playerNameToMasterPlayerPointer.Find(cppname);
 }
 
 MasterPlayer* ObjectAccessor::FindMasterPlayer(ObjectGuid guid)
@@ -162,10 +154,10 @@ PlayerPointer ObjectAccessor::FindPlayerPointer(const char* name)
 void
 ObjectAccessor::SaveAllPlayers()
 {
-    HashMapHolder<Player>::ReadGuard g(HashMapHolder<Player>::GetLock());
-    HashMapHolder<Player>::MapType& m = sObjectAccessor.GetPlayers();
-    for (HashMapHolder<Player>::MapType::iterator itr = m.begin(); itr != m.end(); ++itr)
-        itr->second->SaveToDB();
+    std::vector<Player*> players;
+    GetPlayers(players);
+    for (Player* player : players)
+        player->SaveToDB();
 }
 
 void ObjectAccessor::KickPlayer(ObjectGuid guid)
@@ -354,27 +346,26 @@ ObjectAccessor::NameToMasterPlayerPtr ObjectAccessor::playerNameToMasterPlayerPo
 void ObjectAccessor::AddObject(Player *player)
 {
     HashMapHolder<Player>::Insert(player);
-    playerNameToPlayerPointer[player->GetName()] = player;
+    playerNameToPlayerPointer.Insert(player->GetName(), player);
 }
 void ObjectAccessor::RemoveObject(Player *player)
 {
     HashMapHolder<Player>::Remove(player);
-    playerNameToPlayerPointer.erase(player->GetName());
+    playerNameToPlayerPointer.Remove(player->GetName());
 }
 void ObjectAccessor::AddObject(MasterPlayer *player)
 {
     HashMapHolder<MasterPlayer>::Insert(player);
-    playerNameToMasterPlayerPointer[player->GetName()] = player;
+    playerNameToMasterPlayerPointer.Insert(player->GetName(), player);
 }
 void ObjectAccessor::RemoveObject(MasterPlayer *player)
 {
     HashMapHolder<MasterPlayer>::Remove(player);
-    playerNameToMasterPlayerPointer.erase(player->GetName());
+    playerNameToMasterPlayerPointer.Remove(player->GetName());
 }
 /// Define the static member of HashMapHolder
 
 template <class T> typename HashMapHolder<T>::MapType HashMapHolder<T>::m_objectMap;
-template <class T> ACE_RW_Thread_Mutex HashMapHolder<T>::i_lock;
 
 /// Global definitions for the hashmap storage
 
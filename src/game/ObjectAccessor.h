@@ -31,6 +31,7 @@
 #include "Policies/ThreadingModel.h"
 
 #include "UpdateData.h"
+#include "ShardedObjectMap.h"
 
 #include "GridDefines.h"
 #include "Object.h"
@@ -42,6 +43,7 @@
 
 #include <set>
 #include <list>
+#include <vector>
 
 class Unit;
 class WorldObject;
@@ -52,40 +54,21 @@ class HashMapHolder
 {
     public:
 
-        typedef UNORDERED_MAP<ObjectGuid, T*>   MapType;
-        typedef ACE_RW_Thread_Mutex LockType;
-        typedef ACE_Read_Guard<LockType> ReadGuard;
-        typedef ACE_Write_Guard<LockType> WriteGuard;
+        typedef ShardedObjectMap<ObjectGuid, T> MapType;
 
-        static void Insert(T* o)
-        {
-            WriteGuard guard(i_lock);
-            m_objectMap[o->GetObjectGuid()] = o;
-        }
+        static void Insert(T* o) { m_objectMap.Insert(o->GetObjectGuid(), o); }
+        static void Remove(T* o) { m_objectMap.Remove(o->GetObjectGuid()); }
+        static T* Find(ObjectGuid guid) { return m_objectMap.Find(guid); }
 
-        static void Remove(T* o)
-        {
-            WriteGuard guard(i_lock);
-            m_objectMap.erase(o->GetObjectGuid());
-        }
-
-        static T* Find(ObjectGuid guid)
-        {
-            ReadGuard guard(i_lock);
-            typename MapType::iterator itr = m_objectMap.find(guid);
-            return (itr != m_objectMap.end()) ? itr->second : NULL;
-        }
-
-        static MapType& GetContainer() { return m_objectMap; }
-
-        static LockType& GetLock() { return i_lock; }
+        // Copy of all the registered objects, the registry is not locked anymore on return
+        static void GetAll(std::vector<T*>& objects) { m_objectMap.GetAll(objects); }
+        static uint32 Size() { return m_objectMap.Size(); }
 
     private:
 
         //Non instanceable only static
         HashMapHolder() {}
 
-        static LockType i_lock;
         static MapType  m_objectMap;
 };
 
@@ -126,15 +109,9 @@ class MANGOS_DLL_DECL ObjectAccessor : public MaNGOS::Singleton<ObjectAccessor,
 
         static void KickPlayer(ObjectGuid guid);
 
-        HashMapHolder<Player>::MapType& GetPlayers()
-        {
-            return HashMapHolder<Player>::GetContainer();
-        }
-
-        HashMapHolder<MasterPlayer>::MapType& GetMasterPlayers()
-        {
-            return HashMapHolder<MasterPlayer>::GetContainer();
-        }
+        // Players registered in the world, including the ones not yet/no longer in a map
+        static void GetPlayers(std::vector<Player*>& players) { HashMapHolder<Player>::GetAll(players); }
+        static uint32 GetPlayersCount() { return HashMapHolder<Player>::Size(); }
 
         void SaveAllPlayers();
 
@@ -166,8 +143,9 @@ class MANGOS_DLL_DECL ObjectAccessor : public MaNGOS::Singleton<ObjectAccessor,
         LockType i_playerGuard;
         LockType i_corpseGuard;
 
-        typedef std::map<std::string, Player*> NameToPlayerPtr;
-        typedef std::map<std::string, MasterPlayer*> NameToMasterPlayerPtr;
+        // Keyed by normalized name (see normalizePlayerName)
+        typedef ShardedObjectMap<std::string, Player> NameToPlayerPtr;
+        typedef ShardedObjectMap<std::string, MasterPlayer> NameToMasterPlayerPtr;
         static NameToPlayerPtr playerNameToPlayerPointer;
         static NameToMasterPlayerPtr playerNameToMasterPlayerPointer;
 };
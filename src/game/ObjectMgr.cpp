@@ -1002,6 +1002,9 @@ struct SQLCreatureLoader : public SQLStorageLoaderBase<SQLCreatureLoader, SQLSto
     {
         dst = D(sScriptMgr.GetScriptId(src));
     }
+
+    // script ids are indexes in the sorted script names
+    uint32 snapshot_salt() const { return sScriptMgr.GetScriptNamesHash(); }
 };
 
 void ObjectMgr::LoadCreatureTemplates()
@@ -1642,11 +1645,40 @@ void ObjectMgr::LoadCreatureSpells()
     sLog.outString();
 }
 
+// `creature` row as read by LoadCreatures, saved as is in the spawns snapshot
+struct CreatureSpawnRow
+{
+    uint32 guid;
+    uint32 entry;
+    uint32 mapid;
+    uint32 modelid;
+    int32 equipmentId;
+    float posX;
+    float posY;
+    float posZ;
+    float orientation;
+    uint32 spawntimesecsmin;
+    uint32 spawntimesecsmax;
+    float spawndist;
+    uint32 currentwaypoint;
+    uint32 curhealth;
+    uint32 curmana;
+    bool isDead;
+    uint8 movementType;
+    int16 gameEvent;
+    int16 guidPoolId;
+    int16 entryPoolId;
+    uint32 spawnFlags;
+    float visibilityModifier;
+    uint8 patchMin;
+    uint8 patchMax;
+};
+
 void ObjectMgr::LoadCreatures(bool reload)
 {
     uint32 count = 0;
-    //                                                0                       1   2    3
-    QueryResult *result = WorldDatabase.Query("SELECT creature.guid, creature.id, map, modelid,"
+    //                                                    0              1            2    3
+    static char const* const loadCreaturesQuery = "SELECT creature.guid, creature.id, map, modelid,"
                           //   4             5           6           7            8               9                10            11            12
                           "equipment_id, position_x, position_y, position_z, orientation, spawntimesecsmin, spawntimesecsmax, spawndist, currentwaypoint,"
                           //   13         14       15          16          17
@@ -1656,9 +1688,55 @@ void ObjectMgr::LoadCreatures(bool reload)
                           "FROM creature "
                           "LEFT OUTER JOIN game_event_creature ON creature.guid = game_event_creature.guid "
                           "LEFT OUTER JOIN pool_creature ON creature.guid = pool_creature.guid "
-                          "LEFT OUTER JOIN pool_creature_template ON creature.id = pool_creature_template.id");
+                          "LEFT OUTER JOIN pool_creature_template ON creature.id = pool_creature_template.id";
 
-    if (!result)
+    std::vector<CreatureSpawnRow> rows;
+    SQLRowsSnapshot snapshot("creature_spawns", { "creature", "game_event_creature", "pool_creature", "pool_creature_template" }, loadCreaturesQuery);
+    if (!snapshot.Load(rows))
+    {
+        // prepared: rows come with the binary protocol, no text conversion on the ~100k spawns
+        static SqlStatementID loadCreaturesStmt;
+        SqlStatement stmt = WorldDatabase.CreateStatement(loadCreaturesStmt, loadCreaturesQuery);
+        if (QueryResult* result = stmt.Query())
+        {
+            rows.reserve(result->GetRowCount());
+            do
+            {
+                Field* fields = result->Fetch();
+                rows.emplace_back();                        // zero filled, padding included
+                CreatureSpawnRow& row = rows.back();
+                row.guid                = fields[ 0].GetUInt32();
+                row.entry               = fields[ 1].GetUInt32();
+                row.mapid               = fields[ 2].GetUInt32();
+                row.modelid             = fields[ 3].GetUInt32();
+                row.equipmentId         = fields[ 4].GetInt32();
+                row.posX                = fields[ 5].GetFloat();
+                row.posY                = fields[ 6].GetFloat();
+                row.posZ                = fields[ 7].GetFloat();
+                row.orientation         = fields[ 8].GetFloat();
+                row.spawntimesecsmin    = fields[ 9].GetUInt32();
+                row.spawntimesecsmax    = fields[10].GetUInt32();
+                row.spawndist           = fields[11].GetFloat();
+                row.currentwaypoint     = fields[12].GetUInt32();
+                row.curhealth           = fields[13].GetUInt32();
+                row.curmana             = fields[14].GetUInt32();
+                row.isDead              = fields[15].GetBool();
+                row.movementType        = fields[16].GetUInt8();
+                row.gameEvent           = fields[17].GetInt16();
+                row.guidPoolId          = fields[18].GetInt16();
+                row.entryPoolId         = fields[19].GetInt16();
+                row.spawnFlags          = fields[20].GetUInt32();
+                row.visibilityModifier  = fields[21].GetFloat();
+                row.patchMin            = fields[22].GetUInt8();
+                row.patchMax            = fields[23].GetUInt8();
+            }
+            while (result->NextRow());
+            delete result;
+        }
+        snapshot.Save(rows);
+    }
+
+    if (rows.empty())
     {
         BarGoLink bar(1);
 
@@ -1671,17 +1749,16 @@ void ObjectMgr::LoadCreatures(bool reload)
 
     // build single time for check creature data
 
-    BarGoLink bar(result->GetRowCount());
+    BarGoLink bar(rows.size());
 
-    do
+    for (CreatureSpawnRow const& row : rows)
     {
-        Field *fields = result->Fetch();
         bar.step();
 
-        uint32 guid         = fields[ 0].GetUInt32();
-        uint32 entry        = fields[ 1].GetUInt32();
-        uint8 patch_min     = fields[22].GetUInt8();
-        uint8 patch_max     = fields[23].GetUInt8();
+        uint32 guid         = row.guid;
+        uint32 entry        = row.entry;
+        uint8 patch_min     = row.patchMin;
+        uint8 patch_max     = row.patchMax;
         bool existsInPatch  = true;
 
         if ((patch_min > patch_max) || (patch_max > 10))
@@ -1710,27 +1787,27 @@ void ObjectMgr::LoadCreatures(bool reload)
         CreatureData& data = mCreatureDataMap[guid];
 
         data.id                 = entry;
-        data.mapid              = fields[ 2].GetUInt32();
-        data.modelid_override   = fields[ 3].GetUInt32();
-        data.equipmentId        = fields[ 4].GetUInt32();
-        data.posX               = fields[ 5].GetFloat();
-        data.posY               = fields[ 6].GetFloat();
-        data.posZ               = fields[ 7].GetFloat();
-        data.orientation        = fields[ 8].GetFloat();
-        data.spawntimesecsmin   = fields[ 9].GetUInt32();
-        data.spawntimesecsmax   = fields[10].GetUInt32();
-        data.spawndist          = fields[11].GetFloat();
-        data.currentwaypoint    = fields[12].GetUInt32();
-        data.curhealth          = fields[13].GetUInt32();
-        data.curmana            = fields[14].GetUInt32();
-        data.is_dead            = fields[15].GetBool();
-        data.movementType       = fields[16].GetUInt8();
-        data.spawnFlags         = fields[20].GetUInt32();
-        data.visibilityModifier = fields[21].GetFloat();
+        data.mapid              = row.mapid;
+        data.modelid_override   = row.modelid;
+        data.equipmentId        = row.equipmentId;
+        data.posX               = row.posX;
+        data.posY               = row.posY;
+        data.posZ               = row.posZ;
+        data.orientation        = row.orientation;
+        data.spawntimesecsmin   = row.spawntimesecsmin;
+        data.spawntimesecsmax   = row.spawntimesecsmax;
+        data.spawndist          = row.spawndist;
+        data.currentwaypoint    = row.currentwaypoint;
+        data.curhealth          = row.curhealth;
+        data.curmana            = row.curmana;
+        data.is_dead            = row.isDead;
+        data.movementType       = row.movementType;
+        data.spawnFlags         = row.spawnFlags;
+        data.visibilityModifier = row.visibilityModifier;
         data.instanciatedContinentInstanceId = sMapMgr.GetContinentInstanceId(data.mapid, data.posX, data.posY);
-        int16 gameEvent         = fields[17].GetInt16();
-        int16 GuidPoolId        = fields[18].GetInt16();
-        int16 EntryPoolId       = fields[19].GetInt16();
+        int16 gameEvent         = row.gameEvent;
+        int16 GuidPoolId        = row.guidPoolId;
+        int16 EntryPoolId       = row.entryPoolId;
 
         MapEntry const* mapEntry = sMapStorage.LookupEntry<MapEntry>(data.mapid);
         if (!mapEntry)
@@ -1824,9 +1901,6 @@ void ObjectMgr::LoadCreatures(bool reload)
         ++count;
 
     }
-    while (result->NextRow());
-
-    delete result;
 
     sLog.outString();
     sLog.outString(">> Loaded %lu creatures", (unsigned long)mCreatureDataMap.size());
@@ -1854,12 +1928,39 @@ void ObjectMgr::RemoveCreatureFromGrid(uint32 guid, CreatureData const* data)
     mMapObjectGuids_lock.release();
 }
 
+// `gameobject` row as read by LoadGameobjects, saved as is in the spawns snapshot
+struct GameObjectSpawnRow
+{
+    uint32 guid;
+    uint32 entry;
+    uint32 mapid;
+    float posX;
+    float posY;
+    float posZ;
+    float orientation;
+    float rotation0;
+    float rotation1;
+    float rotation2;
+    float rotation3;
+    int32 spawntimesecsmin;
+    int32 spawntimesecsmax;
+    uint32 animprogress;
+    uint32 state;
+    int16 gameEvent;
+    int16 guidPoolId;
+    int16 entryPoolId;
+    uint32 spawnFlags;
+    float visibilityModifier;
+    uint8 patchMin;
+    uint8 patchMax;
+};
+
 void ObjectMgr::LoadGameobjects(bool reload)
 {
     uint32 count = 0;
 
-    //                                                0                           1   2    3           4           5           6
-    QueryResult *result = WorldDatabase.Query("SELECT gameobject.guid, gameobject.id, map, position_x, position_y, position_z, orientation,"
+    //                                                      0                1              2    3           4           5           6
+    static char const* const loadGameObjectsQuery = "SELECT gameobject.guid, gameobject.id, map, position_x, position_y, position_z, orientation,"
                           //   7          8          9          10            11                12              13       14      15
                           "rotation0, rotation1, rotation2, rotation3, spawntimesecsmin, spawntimesecsmax, animprogress, state, event, "
                           //   16                          17                                   18          19             20        21
@@ -1867,9 +1968,53 @@ void ObjectMgr::LoadGameobjects(bool reload)
                           "FROM gameobject "
                           "LEFT OUTER JOIN game_event_gameobject ON gameobject.guid = game_event_gameobject.guid "
                           "LEFT OUTER JOIN pool_gameobject ON gameobject.guid = pool_gameobject.guid "
-                          "LEFT OUTER JOIN pool_gameobject_template ON gameobject.id = pool_gameobject_template.id");
+                          "LEFT OUTER JOIN pool_gameobject_template ON gameobject.id = pool_gameobject_template.id";
 
-    if (!result)
+    std::vector<GameObjectSpawnRow> rows;
+    SQLRowsSnapshot snapshot("gameobject_spawns", { "gameobject", "game_event_gameobject", "pool_gameobject", "pool_gameobject_template" }, loadGameObjectsQuery);
+    if (!snapshot.Load(rows))
+    {
+        // prepared: rows come with the binary protocol, no text conversion on the spawns
+        static SqlStatementID loadGameObjectsStmt;
+        SqlStatement stmt = WorldDatabase.CreateStatement(loadGameObjectsStmt, loadGameObjectsQuery);
+        if (QueryResult* result = stmt.Query())
+        {
+            rows.reserve(result->GetRowCount());
+            do
+            {
+                Field* fields = result->Fetch();
+                rows.emplace_back();                        // zero filled, padding included
+                GameObjectSpawnRow& row = rows.back();
+                row.guid                = fields[ 0].GetUInt32();
+                row.entry               = fields[ 1].GetUInt32();
+                row.mapid               = fields[ 2].GetUInt32();
+                row.posX                = fields[ 3].GetFloat();
+                row.posY                = fields[ 4].GetFloat();
+                row.posZ                = fields[ 5].GetFloat();
+                row.orientation         = fields[ 6].GetFloat();
+                row.rotation0           = fields[ 7].GetFloat();
+                row.rotation1           = fields[ 8].GetFloat();
+                row.rotation2           = fields[ 9].GetFloat();
+                row.rotation3           = fields[10].GetFloat();
+                row.spawntimesecsmin    = fields[11].GetInt32();
+                row.spawntimesecsmax    = fields[12].GetInt32();
+                row.animprogress        = fields[13].GetUInt32();
+                row.state               = fields[14].GetUInt32();
+                row.gameEvent           = fields[15].GetInt16();
+                row.guidPoolId          = fields[16].GetInt16();
+                row.entryPoolId         = fields[17].GetInt16();
+                row.spawnFlags          = fields[18].GetUInt32();
+                row.visibilityModifier  = fields[19].GetFloat();
+                row.patchMin            = fields[20].GetUInt8();
+                row.patchMax            = fields[21].GetUInt8();
+            }
+            while (result->NextRow());
+            delete result;
+        }
+        snapshot.Save(rows);
+    }
+
+    if (rows.empty())
     {
         BarGoLink bar(1);
 
@@ -1880,17 +2025,16 @@ void ObjectMgr::LoadGameobjects(bool reload)
         return;
     }
 
-    BarGoLink bar(result->GetRowCount());
+    BarGoLink bar(rows.size());
 
-    do
+    for (GameObjectSpawnRow const& row : rows)
     {
-        Field *fields = result->Fetch();
         bar.step();
 
-        uint32 guid         = fields[ 0].GetUInt32();
-        uint32 entry        = fields[ 1].GetUInt32();
-        uint8 patch_min     = fields[20].GetUInt8();
-        uint8 patch_max     = fields[21].GetUInt8();
+        uint32 guid         = row.guid;
+        uint32 entry        = row.entry;
+        uint8 patch_min     = row.patchMin;
+        uint8 patch_max     = row.patchMax;
 
         if ((patch_min > patch_max) || (patch_max > 10))
         {
@@ -1921,19 +2065,19 @@ void ObjectMgr::LoadGameobjects(bool reload)
         GameObjectData& data = mGameObjectDataMap[guid];
 
         data.id               = entry;
-        data.mapid            = fields[ 2].GetUInt32();
-        data.posX             = fields[ 3].GetFloat();
-        data.posY             = fields[ 4].GetFloat();
-        data.posZ             = fields[ 5].GetFloat();
-        data.orientation      = fields[ 6].GetFloat();
-        data.rotation0        = fields[ 7].GetFloat();
-        data.rotation1        = fields[ 8].GetFloat();
-        data.rotation2        = fields[ 9].GetFloat();
-        data.rotation3        = fields[10].GetFloat();
-        data.spawntimesecsmin = fields[11].GetInt32();
-        data.spawntimesecsmax = fields[12].GetInt32();
-        data.spawnFlags       = fields[18].GetUInt32();
-        data.visibilityModifier = fields[19].GetFloat();
+        data.mapid            = row.mapid;
+        data.posX             = row.posX;
+        data.posY             = row.posY;
+        data.posZ             = row.posZ;
+        data.orientation      = row.orientation;
+        data.rotation0        = row.rotation0;
+        data.rotation1        = row.rotation1;
+        data.rotation2        = row.rotation2;
+        data.rotation3        = row.rotation3;
+        data.spawntimesecsmin = row.spawntimesecsmin;
+        data.spawntimesecsmax = row.spawntimesecsmax;
+        data.spawnFlags       = row.spawnFlags;
+        data.visibilityModifier = row.visibilityModifier;
         data.instanciatedContinentInstanceId = sMapMgr.GetContinentInstanceId(data.mapid, data.posX, data.posY);
 
         MapEntry const* mapEntry = sMapStorage.LookupEntry<MapEntry>(data.mapid);
@@ -1953,9 +2097,9 @@ void ObjectMgr::LoadGameobjects(bool reload)
             data.spawntimesecsmax = data.spawntimesecsmin;
         }
 
-        data.animprogress   = fields[13].GetUInt32();
+        data.animprogress   = row.animprogress;
 
-        uint32 go_state     = fields[14].GetUInt32();
+        uint32 go_state     = row.state;
         if (go_state >= MAX_GO_STATE)
         {
             sLog.outErrorDb("Table `gameobject` have gameobject (GUID: %u Entry: %u) with invalid `state` (%u) value, skip", guid, data.id, go_state);
@@ -1963,9 +2107,9 @@ void ObjectMgr::LoadGameobjects(bool reload)
         }
         data.go_state       = GOState(go_state);
 
-        int16 gameEvent     = fields[15].GetInt16();
-        int16 GuidPoolId    = fields[16].GetInt16();
-        int16 EntryPoolId   = fields[17].GetInt16();
+        int16 gameEvent     = row.gameEvent;
+        int16 GuidPoolId    = row.guidPoolId;
+        int16 EntryPoolId   = row.entryPoolId;
 
         if (data.rotation0 < -1.0f || data.rotation0 > 1.0f)
         {
@@ -2003,12 +2147,60 @@ void ObjectMgr::LoadGameobjects(bool reload)
         ++count;
 
     }
+
+    sLog.outString();
+    sLog.outString(">> Loaded %lu gameobjects", (unsigned long)mGameObjectDataMap.size());
+}
+
+// Sums every column of a spawn row, so both result modes do the same reads
+static double ReadSpawnRows(QueryResult* result, uint32& rows)
+{
+    double checksum = 0.0;
+    rows = 0;
+    if (!result)
+        return checksum;
+
+    do
+    {
+        Field* fields = result->Fetch();
+        checksum += fields[0].GetUInt32() + fields[1].GetUInt32() + fields[2].GetUInt32();
+        checksum += fields[3].GetFloat() + fields[4].GetFloat() + fields[5].GetFloat() + fields[6].GetFloat();
+        ++rows;
+    }
     while (result->NextRow());
 
     delete result;
+    return checksum;
+}
+
+// Loads the spawn tables with text results (Database::Query) then binary results (prepared statement).
+// Startup only (WorldDatabase.LoadBenchmark): nothing else uses the world database yet.
+void ObjectMgr::CompareSpawnLoadModes()
+{
+    static char const* const tables[] = { "creature", "gameobject" };
+    static SqlStatementID loadStmts[countof(tables)];
+
+    sLog.outString("Comparing text and binary loading of the spawn tables...");
+    for (uint32 i = 0; i < countof(tables); ++i)
+    {
+        std::string sql = "SELECT guid, id, map, position_x, position_y, position_z, orientation FROM ";
+        sql += tables[i];
+
+        uint32 textRows, binaryRows;
+        uint32 begin = WorldTimer::getMSTime();
+        double textChecksum = ReadSpawnRows(WorldDatabase.Query(sql.c_str()), textRows);
+        uint32 textMs = WorldTimer::getMSTimeDiffToNow(begin);
 
+        begin = WorldTimer::getMSTime();
+        SqlStatement stmt = WorldDatabase.CreateStatement(loadStmts[i], sql.c_str());
+        double binaryChecksum = ReadSpawnRows(stmt.Query(), binaryRows);
+        uint32 binaryMs = WorldTimer::getMSTimeDiffToNow(begin);
+
+        sLog.outString(">> %-10s: %u rows, text %u ms, binary %u ms", tables[i], textRows, textMs, binaryMs);
+        if (textRows != binaryRows || fabs(textChecksum - binaryChecksum) > 1.0)
+            sLog.outError("Table `%s` reads differently with text and binary results!", tables[i]);
+    }
     sLog.outString();
-    sLog.outString(">> Loaded %lu gameobjects", (unsigned long)mGameObjectDataMap.size());
 }
 
 void ObjectMgr::AddGameobjectToGrid(uint32 guid, GameObjectData const* data)
@@ -2206,6 +2398,9 @@ struct SQLItemLoader : public SQLStorageLoaderBase<SQLItemLoader, SQLStorage>
     {
         dst = D(sScriptMgr.GetScriptId(src));
     }
+
+    // script ids are indexes in the sorted script names
+    uint32 snapshot_salt() const { return sScriptMgr.GetScriptNamesHash(); }
 };
 
 void ObjectMgr::LoadItemPrototypes()
@@ -4633,6 +4828,9 @@ struct SQLMapLoader : public SQLStorageLoaderBase<SQLMapLoader, SQLStorage>
     {
         dst = D(sScriptMgr.GetScriptId(src));
     }
+
+    // script ids are indexes in the sorted script names
+    uint32 snapshot_salt() const { return sScriptMgr.GetScriptNamesHash(); }
 };
 
 void ObjectMgr::LoadMapTemplate()
@@ -4705,6 +4903,9 @@ struct SQLWorldLoader : public SQLStorageLoaderBase<SQLWorldLoader, SQLStorage>
     {
         dst = D(sScriptMgr.GetScriptId(src));
     }
+
+    // script ids are indexes in the sorted script names
+    uint32 snapshot_salt() const { return sScriptMgr.GetScriptNamesHash(); }
 };
 
 void ObjectMgr::LoadNPCText()
@@ -5848,6 +6049,9 @@ struct SQLGameObjectLoader : public SQLStorageLoaderBase<SQLGameObjectLoader, SQ
     {
         dst = D(sScriptMgr.GetScriptId(src));
     }
+
+    // script ids are indexes in the sorted script names
+    uint32 snapshot_salt() const { return sScriptMgr.GetScriptNamesHash(); }
 };
 
 inline void CheckGOLockId(GameObjectInfo const* goInfo, uint32 dataN, uint32 N)
@@ -867,6 +867,7 @@ class ObjectMgr
         void LoadEquipmentTemplates();
         void LoadGameObjectLocales();
         void LoadGameobjects(bool reload = false);
+        void CompareSpawnLoadModes();
         void LoadItemPrototypes();
         void LoadItemRequiredTarget();
         void LoadItemLocales();
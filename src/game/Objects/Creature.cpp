@@ -188,6 +188,8 @@ Creature::Creature(CreatureSubtype subtype) :
     SetWalk(true, true);
 }
 
+DEFINE_POOLED_ALLOCATOR(Creature)
+
 Creature::~Creature()
 {
     CleanupsBeforeDelete();
@@ -33,6 +33,7 @@
 #include "CreatureGroups.h"
 #include "Cell.h"
 #include "Util.h"
+#include "Utilities/ObjectPool.h"
 
 #include <list>
 
@@ -494,6 +495,8 @@ class MANGOS_DLL_SPEC Creature : public Unit
         explicit Creature(CreatureSubtype subtype = CREATURE_SUBTYPE_GENERIC);
         virtual ~Creature();
 
+        DECLARE_POOLED_ALLOCATOR(Creature);
+
         void AddToWorld() override;
         void RemoveFromWorld() override;
 
@@ -30,6 +30,8 @@
 #include "GridNotifiersImpl.h"
 #include "SpellMgr.h"
 
+DEFINE_POOLED_ALLOCATOR(DynamicObject)
+
 DynamicObject::DynamicObject() : WorldObject(), m_effIndex(EFFECT_INDEX_0), m_spellId(0), m_aliveDuration(0), m_positive(false), m_radius(0)
 {
     m_objectType |= TYPEMASK_DYNAMICOBJECT;
@@ -25,6 +25,7 @@
 #include "Object.h"
 #include "DBCEnums.h"
 #include "Unit.h"
+#include "Utilities/ObjectPool.h"
 
 enum DynamicObjectType
 {
@@ -41,6 +42,8 @@ class DynamicObject : public WorldObject
         typedef std::map<ObjectGuid, uint32> AffectedMap;
         explicit DynamicObject();
 
+        DECLARE_POOLED_ALLOCATOR(DynamicObject);
+
         void AddToWorld();
         void RemoveFromWorld();
 
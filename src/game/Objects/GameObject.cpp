@@ -71,6 +71,8 @@ GameObject::GameObject() : WorldObject(),
     m_summonTarget = ObjectGuid();
 }
 
+DEFINE_POOLED_ALLOCATOR(GameObject)
+
 GameObject::~GameObject()
 {
     delete i_AI;
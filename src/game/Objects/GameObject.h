@@ -29,6 +29,7 @@
 #include "Database/DatabaseEnv.h"
 #include <mutex>
 #include "Util.h"
+#include "Utilities/ObjectPool.h"
 
 // GCC have alternative #pragma pack(N) syntax and old gcc version not support pack(push,N), also any gcc version not support it at some platform
 #if defined( __GNUC__ )
@@ -552,6 +553,8 @@ class MANGOS_DLL_SPEC GameObject : public WorldObject
         explicit GameObject();
         ~GameObject();
 
+        DECLARE_POOLED_ALLOCATOR(GameObject);
+
         void AddToWorld();
         void RemoveFromWorld();
 
@@ -177,7 +177,7 @@ void MovementInfo::Write(ByteBuffer &data) const
 }
 
 
-Object::Object() : m_updateFlag(0)
+Object::Object() : m_clientUpdateQueueSlot(0), m_updateFlag(0)
 {
     m_objectTypeId      = TYPEID_OBJECT;
     m_objectType        = TYPEMASK_OBJECT;
@@ -383,6 +383,50 @@ void Object::BuildValuesUpdateBlockForPlayer(UpdateData *data, Player *target) c
     data->AddUpdateBlock(buf);
 }
 
+void Object::BuildValuesUpdateBlockForPlayer(UpdateData *data, Player *target, UpdateValuesCache* caches) const
+{
+    UpdateValuesCache& cache = caches[target == this ? UPDATE_VISIBILITY_SELF : UPDATE_VISIBILITY_OTHER];
+    if (!cache.built)
+    {
+        UpdateMask updateMask;
+        updateMask.SetCount(m_valuesCount);
+        _SetUpdateBits(&updateMask, target);
+        _SetForcedUpdateBits(UPDATETYPE_VALUES, &updateMask, target);
+
+        cache.block.reserve(500);
+        cache.block << uint8(UPDATETYPE_VALUES);
+        cache.block << GetPackGUID();
+        cache.block << (uint8)updateMask.GetBlockCount();
+        cache.block.append(updateMask.GetMask(), updateMask.GetLength());
+        for (uint16 index = 0; index < m_valuesCount; ++index)
+        {
+            if (!updateMask.GetBit(index))
+                continue;
+
+            if (IsObserverDependentField(index))
+            {
+                cache.observerFields.push_back(std::make_pair(uint32(cache.block.wpos()), index));
+                cache.block << uint32(0);
+            }
+            else
+                cache.block << GetUpdateFieldValue(index);
+        }
+        cache.built = true;
+    }
+
+    bool IsActivateToQuest = _UpdateQuestActivation(target);
+    if (cache.observerFields.empty())
+    {
+        data->AddUpdateBlock(cache.block);
+        return;
+    }
+
+    ByteBuffer buf(cache.block);
+    for (auto const& field : cache.observerFields)
+        buf.put<uint32>(field.first, GetUpdateFieldValueFor(field.second, target, IsActivateToQuest));
+    data->AddUpdateBlock(buf);
+}
+
 void Object::BuildOutOfRangeUpdateBlock(UpdateData * data) const
 {
     data->AddOutOfRangeGUID(GetObjectGuid());
@@ -494,282 +538,292 @@ void Object::BuildMovementUpdate(ByteBuffer * data, uint8 updateFlags) const
     }
 }
 
-void Object::BuildValuesUpdate(uint8 updatetype, ByteBuffer * data, UpdateMask *updateMask, Player *target) const
+void Object::_SetForcedUpdateBits(uint8 updatetype, UpdateMask *updateMask, Player *target) const
 {
-    if (!target)
-        return;
-
-    bool IsActivateToQuest = false;
-
     if (updatetype == UPDATETYPE_CREATE_OBJECT || updatetype == UPDATETYPE_CREATE_OBJECT2)
     {
         if (isType(TYPEMASK_GAMEOBJECT) && !((GameObject*)this)->IsTransport())
-        {
-            if (((GameObject*)this)->ActivateToQuest(target) || target->isGameMaster())
-                IsActivateToQuest = true;
-
             updateMask->SetBit(GAMEOBJECT_DYN_FLAGS);
-        }
         if (target->HasOption(PLAYER_VIDEO_MODE) && isType(TYPEMASK_UNIT))
             updateMask->SetBit(UNIT_FIELD_FLAGS);
     }
     else                                                    // case UPDATETYPE_VALUES
     {
+        // Same for every observer, values updates are cached on that assumption
         if (isType(TYPEMASK_GAMEOBJECT) && !((GameObject*)this)->IsTransport())
         {
-            if (((GameObject*)this)->ActivateToQuest(target) || target->isGameMaster())
-                IsActivateToQuest = true;
-
             updateMask->SetBit(GAMEOBJECT_DYN_FLAGS);
             updateMask->SetBit(GAMEOBJECT_ANIMPROGRESS);
         }
     }
-    if (isType(TYPEMASK_GAMEOBJECT))
+}
+
+bool Object::_UpdateQuestActivation(Player *target) const
+{
+    if (!isType(TYPEMASK_GAMEOBJECT))
+        return false;
+
+    bool IsActivateToQuest = false;
+    if (!((GameObject*)this)->IsTransport())
+        if (((GameObject*)this)->ActivateToQuest(target) || target->isGameMaster())
+            IsActivateToQuest = true;
+
+    target->m_visibleGobjsQuestAct_lock.acquire();
+    target->m_visibleGobjQuestActivated[GetObjectGuid()] = IsActivateToQuest;
+    target->m_visibleGobjsQuestAct_lock.release();
+    return IsActivateToQuest;
+}
+
+bool Object::IsObserverDependentField(uint16 index) const
+{
+    if (isType(TYPEMASK_UNIT))
     {
-        target->m_visibleGobjsQuestAct_lock.acquire();
-        target->m_visibleGobjQuestActivated[GetObjectGuid()] = IsActivateToQuest;
-        target->m_visibleGobjsQuestAct_lock.release();
+        switch (index)
+        {
+            case UNIT_NPC_FLAGS:
+            case UNIT_FIELD_FLAGS:
+            case UNIT_DYNAMIC_FLAGS:
+            case UNIT_FIELD_FACTIONTEMPLATE:
+            case UNIT_FIELD_HEALTH:
+            case UNIT_FIELD_MAXHEALTH:
+                return true;
+            case PLAYER_FLAGS:                              // only reached by players (index < m_valuesCount)
+                return true;
+            default:
+                return false;
+        }
     }
+    if (isType(TYPEMASK_GAMEOBJECT))
+        return index == GAMEOBJECT_DYN_FLAGS;
+    if (GetTypeId() == TYPEID_CORPSE)
+        return index == CORPSE_FIELD_DYNAMIC_FLAGS;
+    return false;
+}
 
-    MANGOS_ASSERT(updateMask && updateMask->GetCount() == m_valuesCount);
+uint32 Object::GetUpdateFieldValue(uint16 index) const
+{
+    if (isType(TYPEMASK_UNIT))
+    {
+        // FIXME: Some values at server stored in float format but must be sent to client in uint32 format
+        if (index >= UNIT_FIELD_BASEATTACKTIME && index <= UNIT_FIELD_RANGEDATTACKTIME)
+        {
+            // convert from float to uint32 and send
+            return uint32(m_floatValues[index] < 0 ? 0 : m_floatValues[index]);
+        }
 
-    *data << (uint8)updateMask->GetBlockCount();
-    data->append(updateMask->GetMask(), updateMask->GetLength());
+        // there are some float values which may be negative or can't get negative due to other checks
+        if ((index >= PLAYER_FIELD_NEGSTAT0    && index <= PLAYER_FIELD_NEGSTAT4) ||
+            (index >= PLAYER_FIELD_RESISTANCEBUFFMODSPOSITIVE  && index <= (PLAYER_FIELD_RESISTANCEBUFFMODSPOSITIVE + 6)) ||
+            (index >= PLAYER_FIELD_RESISTANCEBUFFMODSNEGATIVE  && index <= (PLAYER_FIELD_RESISTANCEBUFFMODSNEGATIVE + 6)) ||
+            (index >= PLAYER_FIELD_POSSTAT0    && index <= PLAYER_FIELD_POSSTAT4))
+            return uint32(m_floatValues[index]);
+    }
+
+    // send in current format (float as float, uint32 as uint32)
+    return m_uint32Values[index];
+}
 
-    // 2 specialized loops for speed optimization in non-unit case
+uint32 Object::GetUpdateFieldValueFor(uint16 index, Player *target, bool isActivateToQuest) const
+{
     if (isType(TYPEMASK_UNIT))                              // unit (creature/player) case
     {
-        for (uint16 index = 0; index < m_valuesCount; ++index)
+        if (index == UNIT_NPC_FLAGS)
         {
-            if (updateMask->GetBit(index))
+            uint32 appendValue = m_uint32Values[index];
+
+            if (GetTypeId() == TYPEID_UNIT)
             {
-                if (index == UNIT_NPC_FLAGS)
+                if (appendValue & UNIT_NPC_FLAG_TRAINER)
                 {
-                    uint32 appendValue = m_uint32Values[index];
-
-                    if (GetTypeId() == TYPEID_UNIT)
-                    {
-                        if (appendValue & UNIT_NPC_FLAG_TRAINER)
-                        {
-                            if (!((Creature*)this)->IsTrainerOf(target, false))
-                                appendValue &= ~UNIT_NPC_FLAG_TRAINER;
-                        }
-
-                        if (appendValue & UNIT_NPC_FLAG_STABLEMASTER)
-                        {
-                            if (target->getClass() != CLASS_HUNTER)
-                                appendValue &= ~UNIT_NPC_FLAG_STABLEMASTER;
-                        }
-
-                        if (appendValue & UNIT_NPC_FLAG_FLIGHTMASTER)
-                        {
-                            QuestRelationsMapBounds bounds = sObjectMgr.GetCreatureQuestRelationsMapBounds(((Creature*)this)->GetEntry());
-                            for (QuestRelationsMap::const_iterator itr = bounds.first; itr != bounds.second; ++itr)
-                            {
-                                Quest const* pQuest = sObjectMgr.GetQuestTemplate(itr->second);
-                                if (target->CanSeeStartQuest(pQuest))
-                                {
-                                    appendValue &= ~UNIT_NPC_FLAG_FLIGHTMASTER;
-                                    break;
-                                }
-                            }
-
-                            bounds = sObjectMgr.GetCreatureQuestInvolvedRelationsMapBounds(((Creature*)this)->GetEntry());
-                            for (QuestRelationsMap::const_iterator itr = bounds.first; itr != bounds.second; ++itr)
-                            {
-                                Quest const* pQuest = sObjectMgr.GetQuestTemplate(itr->second);
-                                if (target->CanRewardQuest(pQuest, false))
-                                {
-                                    appendValue &= ~UNIT_NPC_FLAG_FLIGHTMASTER;
-                                    break;
-                                }
-                            }
-                        }
-                    }
-
-                    *data << uint32(appendValue);
+                    if (!((Creature*)this)->IsTrainerOf(target, false))
+                        appendValue &= ~UNIT_NPC_FLAG_TRAINER;
                 }
-                // FIXME: Some values at server stored in float format but must be sent to client in uint32 format
-                else if (index >= UNIT_FIELD_BASEATTACKTIME && index <= UNIT_FIELD_RANGEDATTACKTIME)
+
+                if (appendValue & UNIT_NPC_FLAG_STABLEMASTER)
                 {
-                    // convert from float to uint32 and send
-                    *data << uint32(m_floatValues[index] < 0 ? 0 : m_floatValues[index]);
+                    if (target->getClass() != CLASS_HUNTER)
+                        appendValue &= ~UNIT_NPC_FLAG_STABLEMASTER;
                 }
 
-                // there are some float values which may be negative or can't get negative due to other checks
-                else if ((index >= PLAYER_FIELD_NEGSTAT0    && index <= PLAYER_FIELD_NEGSTAT4) ||
-                         (index >= PLAYER_FIELD_RESISTANCEBUFFMODSPOSITIVE  && index <= (PLAYER_FIELD_RESISTANCEBUFFMODSPOSITIVE + 6)) ||
-                         (index >= PLAYER_FIELD_RESISTANCEBUFFMODSNEGATIVE  && index <= (PLAYER_FIELD_RESISTANCEBUFFMODSNEGATIVE + 6)) ||
-                         (index >= PLAYER_FIELD_POSSTAT0    && index <= PLAYER_FIELD_POSSTAT4))
-                    *data << uint32(m_floatValues[index]);
-                // Video maker - hide unit name, etc ...
-                else if (index == UNIT_FIELD_FLAGS && target->HasOption(PLAYER_VIDEO_MODE) && target != this)
-                    *data << (m_uint32Values[index] | UNIT_FLAG_NOT_SELECTABLE);
-                // Gamemasters should be always able to select units and view auras
-                else if (index == UNIT_FIELD_FLAGS && target->isGameMaster())
-                    *data << ((m_uint32Values[index] | UNIT_FLAG_AURAS_VISIBLE) & ~UNIT_FLAG_NOT_SELECTABLE);
-                // hide lootable animation for unallowed players
-                else if (index == UNIT_DYNAMIC_FLAGS)
+                if (appendValue & UNIT_NPC_FLAG_FLIGHTMASTER)
                 {
-                    uint32 dynamicFlags = m_uint32Values[index];
-                    if (HasFlag(UNIT_DYNAMIC_FLAGS, UNIT_DYNFLAG_TRACK_UNIT))
-                        if (Unit const * unit = ToUnit())
-                        {
-                            Unit::AuraList auras = unit->GetAurasByType(SPELL_AURA_MOD_STALKED);
-                            if (std::find_if(auras.begin(), auras.end(),[target](Aura *a){
-                                return target->GetObjectGuid() == a->GetCasterGuid();
-                            }) == auras.end())
-                                dynamicFlags &= ~UNIT_DYNFLAG_TRACK_UNIT;
-                        }
-                    if (Creature const* creature = ToCreature())
+                    QuestRelationsMapBounds bounds = sObjectMgr.GetCreatureQuestRelationsMapBounds(((Creature*)this)->GetEntry());
+                    for (QuestRelationsMap::const_iterator itr = bounds.first; itr != bounds.second; ++itr)
                     {
-                        if (creature->HasLootRecipient())
+                        Quest const* pQuest = sObjectMgr.GetQuestTemplate(itr->second);
+                        if (target->CanSeeStartQuest(pQuest))
                         {
-                            if (creature->IsTappedBy(target))
-                                dynamicFlags |= (UNIT_DYNFLAG_TAPPED | UNIT_DYNFLAG_TAPPED_BY_PLAYER);
-                            else
-                            {
-                                dynamicFlags |= UNIT_DYNFLAG_TAPPED;
-                                dynamicFlags &= ~UNIT_DYNFLAG_TAPPED_BY_PLAYER;
-                            }
+                            appendValue &= ~UNIT_NPC_FLAG_FLIGHTMASTER;
+                            break;
                         }
-                        else
+                    }
+
+                    bounds = sObjectMgr.GetCreatureQuestInvolvedRelationsMapBounds(((Creature*)this)->GetEntry());
+                    for (QuestRelationsMap::const_iterator itr = bounds.first; itr != bounds.second; ++itr)
+                    {
+                        Quest const* pQuest = sObjectMgr.GetQuestTemplate(itr->second);
+                        if (target->CanRewardQuest(pQuest, false))
                         {
-                            dynamicFlags &= ~UNIT_DYNFLAG_TAPPED;
-                            dynamicFlags &= ~UNIT_DYNFLAG_TAPPED_BY_PLAYER;
+                            appendValue &= ~UNIT_NPC_FLAG_FLIGHTMASTER;
+                            break;
                         }
-
-                        if (!target->isAllowedToLoot(creature))
-                            dynamicFlags &= ~UNIT_DYNFLAG_LOOTABLE;
                     }
-                    *data << dynamicFlags;
                 }
-                // RAID ally-horde - Faction
-                else if (index == UNIT_FIELD_FACTIONTEMPLATE)
-                {
-                    Player* owner = ((Unit*)this)->GetCharmerOrOwnerPlayerOrPlayerItself();
-                    bool forceFriendly = false;
-                    if (owner)
-                    {
-                        FactionTemplateEntry const *ft1, *ft2;
-                        ft1 = owner->getFactionTemplateEntry();
-                        ft2 = target->getFactionTemplateEntry();
-                        if (ft1 && ft2 && !ft1->IsFriendlyTo(*ft2) && owner->IsInSameRaidWith(target))
-                            if (owner->IsInInterFactionMode() && target->IsInInterFactionMode())
-                                forceFriendly = true;
-                    }
-                    uint32 faction = m_uint32Values[index];
-                    if (forceFriendly)
-                        faction = target->getFaction();
+            }
 
-                    *data << uint32(faction);
-                }
-                // RAID ally-horde : pas de flag FFA
-                else if (index == PLAYER_FLAGS && (m_uint32Values[index] & PLAYER_FLAGS_FFA_PVP))
+            return appendValue;
+        }
+        // Video maker - hide unit name, etc ...
+        if (index == UNIT_FIELD_FLAGS && target->HasOption(PLAYER_VIDEO_MODE) && target != this)
+            return m_uint32Values[index] | UNIT_FLAG_NOT_SELECTABLE;
+        // Gamemasters should be always able to select units and view auras
+        if (index == UNIT_FIELD_FLAGS && target->isGameMaster())
+            return (m_uint32Values[index] | UNIT_FLAG_AURAS_VISIBLE) & ~UNIT_FLAG_NOT_SELECTABLE;
+        // hide lootable animation for unallowed players
+        if (index == UNIT_DYNAMIC_FLAGS)
+        {
+            uint32 dynamicFlags = m_uint32Values[index];
+            if (HasFlag(UNIT_DYNAMIC_FLAGS, UNIT_DYNFLAG_TRACK_UNIT))
+                if (Unit const * unit = ToUnit())
                 {
-                    Player* owner = ((Unit*)this)->GetCharmerOrOwnerPlayerOrPlayerItself();
-                    if (owner && owner != target && owner->IsInSameRaidWith(target))
-                        *data << uint32(m_uint32Values[index] & ~PLAYER_FLAGS_FFA_PVP);
-                    else
-                        *data << uint32(m_uint32Values[index]);
+                    Unit::AuraList auras = unit->GetAurasByType(SPELL_AURA_MOD_STALKED);
+                    if (std::find_if(auras.begin(), auras.end(),[target](Aura *a){
+                        return target->GetObjectGuid() == a->GetCasterGuid();
+                    }) == auras.end())
+                        dynamicFlags &= ~UNIT_DYNFLAG_TRACK_UNIT;
                 }
-                // Hide real health value. Send a percent instead.
-                else if (index == UNIT_FIELD_HEALTH || index == UNIT_FIELD_MAXHEALTH)
+            if (Creature const* creature = ToCreature())
+            {
+                if (creature->HasLootRecipient())
                 {
-                    Player* owner = ((Unit*)this)->GetCharmerOrOwnerPlayerOrPlayerItself();
-                    if (owner && owner->IsInSameRaidWith(target))
-                        *data << m_uint32Values[index];
-                    else // Hide
+                    if (creature->IsTappedBy(target))
+                        dynamicFlags |= (UNIT_DYNFLAG_TAPPED | UNIT_DYNFLAG_TAPPED_BY_PLAYER);
+                    else
                     {
-                        if (index == UNIT_FIELD_MAXHEALTH)
-                            *data << uint32(100);
-                        else
-                        {
-                            uint32 pct = 0;
-                            if (m_uint32Values[UNIT_FIELD_HEALTH])
-                            {
-                                pct = uint32((m_uint32Values[UNIT_FIELD_HEALTH] * 100.0f) / m_uint32Values[UNIT_FIELD_MAXHEALTH]);
-                                if (pct > 100)
-                                    pct = 100;
-                                if (!pct)
-                                    pct = 1;
-                            }
-                            *data << pct;
-                        }
+                        dynamicFlags |= UNIT_DYNFLAG_TAPPED;
+                        dynamicFlags &= ~UNIT_DYNFLAG_TAPPED_BY_PLAYER;
                     }
                 }
-                else if (target == this && (index == PLAYER_TRACK_CREATURES || index == PLAYER_TRACK_RESOURCES))
-                {
-                    //if (WardenInterface* base = target->GetSession()->GetWarden())
-                        //base->TrackingUpdateSent(index, m_uint32Values[index]);
-                    *data << m_uint32Values[index];
-                }
                 else
                 {
-                    // send in current format (float as float, uint32 as uint32)
-                    *data << m_uint32Values[index];
+                    dynamicFlags &= ~UNIT_DYNFLAG_TAPPED;
+                    dynamicFlags &= ~UNIT_DYNFLAG_TAPPED_BY_PLAYER;
                 }
+
+                if (!target->isAllowedToLoot(creature))
+                    dynamicFlags &= ~UNIT_DYNFLAG_LOOTABLE;
+            }
+            return dynamicFlags;
+        }
+        // RAID ally-horde - Faction
+        if (index == UNIT_FIELD_FACTIONTEMPLATE)
+        {
+            Player* owner = ((Unit*)this)->GetCharmerOrOwnerPlayerOrPlayerItself();
+            bool forceFriendly = false;
+            if (owner)
+            {
+                FactionTemplateEntry const *ft1, *ft2;
+                ft1 = owner->getFactionTemplateEntry();
+                ft2 = target->getFactionTemplateEntry();
+                if (ft1 && ft2 && !ft1->IsFriendlyTo(*ft2) && owner->IsInSameRaidWith(target))
+                    if (owner->IsInInterFactionMode() && target->IsInInterFactionMode())
+                        forceFriendly = true;
+            }
+            uint32 faction = m_uint32Values[index];
+            if (forceFriendly)
+                faction = target->getFaction();
+
+            return faction;
+        }
+        // RAID ally-horde : pas de flag FFA
+        if (index == PLAYER_FLAGS && (m_uint32Values[index] & PLAYER_FLAGS_FFA_PVP))
+        {
+            Player* owner = ((Unit*)this)->GetCharmerOrOwnerPlayerOrPlayerItself();
+            if (owner && owner != target && owner->IsInSameRaidWith(target))
+                return m_uint32Values[index] & ~PLAYER_FLAGS_FFA_PVP;
+            return m_uint32Values[index];
+        }
+        // Hide real health value. Send a percent instead.
+        if (index == UNIT_FIELD_HEALTH || index == UNIT_FIELD_MAXHEALTH)
+        {
+            Player* owner = ((Unit*)this)->GetCharmerOrOwnerPlayerOrPlayerItself();
+            if (owner && owner->IsInSameRaidWith(target))
+                return m_uint32Values[index];
+            // Hide
+            if (index == UNIT_FIELD_MAXHEALTH)
+                return 100;
+
+            uint32 pct = 0;
+            if (m_uint32Values[UNIT_FIELD_HEALTH])
+            {
+                pct = uint32((m_uint32Values[UNIT_FIELD_HEALTH] * 100.0f) / m_uint32Values[UNIT_FIELD_MAXHEALTH]);
+                if (pct > 100)
+                    pct = 100;
+                if (!pct)
+                    pct = 1;
             }
+            return pct;
         }
     }
     else if (isType(TYPEMASK_GAMEOBJECT))                   // gameobject case
     {
-        for (uint16 index = 0; index < m_valuesCount; ++index)
+        if (index == GAMEOBJECT_DYN_FLAGS)
         {
-            if (updateMask->GetBit(index))
+            if (!isActivateToQuest)
+                return 0;                                   // disable quest object
+
+            switch (((GameObject*)this)->GetGoType())
             {
-                // send in current format (float as float, uint32 as uint32)
-                if (index == GAMEOBJECT_DYN_FLAGS)
-                {
-                    if (IsActivateToQuest)
-                    {
-                        switch (((GameObject*)this)->GetGoType())
-                        {
-                            case GAMEOBJECT_TYPE_QUESTGIVER:
-                            case GAMEOBJECT_TYPE_CHEST:
-                            case GAMEOBJECT_TYPE_GENERIC:
-                            case GAMEOBJECT_TYPE_SPELL_FOCUS:
-                            case GAMEOBJECT_TYPE_GOOBER:
-                                *data << uint16(GO_DYNFLAG_LO_ACTIVATE);
-                                *data << uint16(0);
-                                break;
-                            default:
-                                *data << uint32(0);         // unknown, not happen.
-                                break;
-                        }
-                    }
-                    else
-                        *data << uint32(0);                 // disable quest object
-                }
-                else
-                    *data << m_uint32Values[index];         // other cases
+                case GAMEOBJECT_TYPE_QUESTGIVER:
+                case GAMEOBJECT_TYPE_CHEST:
+                case GAMEOBJECT_TYPE_GENERIC:
+                case GAMEOBJECT_TYPE_SPELL_FOCUS:
+                case GAMEOBJECT_TYPE_GOOBER:
+                    return GO_DYNFLAG_LO_ACTIVATE;          // low uint16, high uint16 is 0
+                default:
+                    return 0;                               // unknown, not happen.
             }
         }
     }
-    else                                                    // other objects case (no special index checks)
+    else if (index == CORPSE_FIELD_DYNAMIC_FLAGS)
     {
-        for (uint16 index = 0; index < m_valuesCount; ++index)
+        uint32 dynFlags = m_uint32Values[CORPSE_FIELD_DYNAMIC_FLAGS];
+        if (Corpse const* corpse = ToCorpse())
         {
-            if (updateMask->GetBit(index))
-            {
-                if (index == CORPSE_FIELD_DYNAMIC_FLAGS)
-                {
-                    uint32 dynFlags = m_uint32Values[CORPSE_FIELD_DYNAMIC_FLAGS];
-                    if (Corpse const* corpse = ToCorpse())
-                    {
-                        const Loot* loot = &corpse->loot;
-                        if (loot->isLooted()) // nothing to loot or everything looted.
-                            dynFlags &= ~CORPSE_DYNFLAG_LOOTABLE;
-                        if (dynFlags & CORPSE_DYNFLAG_LOOTABLE)
-                            if (corpse->IsFriendlyTo(target))
-                                dynFlags &= ~CORPSE_DYNFLAG_LOOTABLE;
-                    }
-                    *data << dynFlags;
-                }
-                else
-                    // send in current format (float as float, uint32 as uint32)
-                    *data << m_uint32Values[index];
-            }
+            const Loot* loot = &corpse->loot;
+            if (loot->isLooted()) // nothing to loot or everything looted.
+                dynFlags &= ~CORPSE_DYNFLAG_LOOTABLE;
+            if (dynFlags & CORPSE_DYNFLAG_LOOTABLE)
+                if (corpse->IsFriendlyTo(target))
+                    dynFlags &= ~CORPSE_DYNFLAG_LOOTABLE;
+        }
+        return dynFlags;
+    }
+
+    return GetUpdateFieldValue(index);
+}
+
+void Object::BuildValuesUpdate(uint8 updatetype, ByteBuffer * data, UpdateMask *updateMask, Player *target) const
+{
+    if (!target)
+        return;
+
+    _SetForcedUpdateBits(updatetype, updateMask, target);
+    bool IsActivateToQuest = _UpdateQuestActivation(target);
+
+    MANGOS_ASSERT(updateMask && updateMask->GetCount() == m_valuesCount);
+
+    *data << (uint8)updateMask->GetBlockCount();
+    data->append(updateMask->GetMask(), updateMask->GetLength());
+
+    for (uint16 index = 0; index < m_valuesCount; ++index)
+    {
+        if (updateMask->GetBit(index))
+        {
+            if (IsObserverDependentField(index))
+                *data << GetUpdateFieldValueFor(index, target, IsActivateToQuest);
+            else
+                *data << GetUpdateFieldValue(index);
         }
     }
 }
@@ -1059,7 +1113,7 @@ bool Object::PrintIndexError(uint32 index, bool set) const
     return false;
 }
 
-void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players)
+void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players, UpdateValuesCache* caches)
 {
     UpdateDataMapType::iterator iter = update_players.find(pl);
 
@@ -1070,7 +1124,10 @@ void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_play
         iter = p.first;
     }
 
-    BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
+    if (caches)
+        BuildValuesUpdateBlockForPlayer(&iter->second, iter->first, caches);
+    else
+        BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
 }
 
 void Object::AddToClientUpdateList()
@@ -1162,7 +1219,8 @@ void WorldObject::SetVisibilityModifier(float f)
 }
 
 WorldObject::WorldObject()
-    :   m_isActiveObject(false), m_currMap(nullptr), m_mapId(0), m_InstanceId(0), m_lootAndXPRangeModifier(0),
+    :   m_relocatedQueueSlot(0), m_movementQueueSlot(0), m_removeQueueSlot(0),
+        m_isActiveObject(false), m_currMap(nullptr), m_mapId(0), m_InstanceId(0), m_lootAndXPRangeModifier(0),
         m_visibilityModifier(DEFAULT_VISIBILITY_MODIFIER), m_creatureSummonCount(0), m_summonLimitAlert(0)
 {
     // Phasing
@@ -1716,6 +1774,7 @@ void WorldObject::SendMessageToSet(WorldPacket *data, bool /*bToSelf*/)
 struct MANGOS_DLL_DECL ObjectViewersDeliverer
 {
     WorldPacket* i_message;
+    SharedWorldPacket i_shared;
     WorldObject* i_sender;
     WorldObject* i_except;
     explicit ObjectViewersDeliverer(WorldObject* sender, WorldPacket *msg, WorldObject* except) : i_message(msg), i_sender(sender), i_except(except) {}
@@ -1725,7 +1784,7 @@ struct MANGOS_DLL_DECL ObjectViewersDeliverer
             if (Player* player = iter->getSource()->GetOwner())
                 if (player != i_except && player != i_sender)
                     if (player->IsInVisibleList_Unsafe(i_sender))
-                        player->GetSession()->SendPacket(i_message);
+                        player->GetSession()->SendPacket(i_message, &i_shared);
     }
     template<class SKIP> void Visit(GridRefManager<SKIP> &) {}
 };
@@ -2294,12 +2353,14 @@ struct WorldObjectChangeAccumulator
 {
     UpdateDataMapType &i_updateDatas;
     WorldObject &i_object;
+    // The same delta is serialized once for all the players around
+    UpdateValuesCache i_caches[MAX_UPDATE_VISIBILITY];
     WorldObjectChangeAccumulator(WorldObject &obj, UpdateDataMapType &d) : i_updateDatas(d), i_object(obj)
     {
         // send self fields changes in another way, otherwise
         // with new camera system when player's camera too far from player, camera wouldn't receive packets and changes from player
         if (i_object.isType(TYPEMASK_PLAYER))
-            i_object.BuildUpdateDataForPlayer((Player*)&i_object, i_updateDatas);
+            i_object.BuildUpdateDataForPlayer((Player*)&i_object, i_updateDatas, i_caches);
     }
 
     void Visit(CameraMapType &m)
@@ -2308,7 +2369,7 @@ struct WorldObjectChangeAccumulator
         {
             Player* owner = iter->getSource()->GetOwner();
             if (owner != &i_object && owner->IsInVisibleList_Unsafe(&i_object))
-                i_object.BuildUpdateDataForPlayer(owner, i_updateDatas);
+                i_object.BuildUpdateDataForPlayer(owner, i_updateDatas, i_caches);
         }
     }
 
@@ -291,6 +291,27 @@ inline ByteBuffer& operator>> (ByteBuffer& buf, MovementInfo& mi)
     return buf;
 }
 
+// The update mask of a values update only depends on whether the observer is
+// the object itself (players send more fields to themselves).
+enum UpdateValuesVisibility
+{
+    UPDATE_VISIBILITY_SELF                  = 0,
+    UPDATE_VISIBILITY_OTHER                 = 1,
+    MAX_UPDATE_VISIBILITY                   = 2
+};
+
+// UPDATETYPE_VALUES block serialized once and copied for every observer
+// with the same visibility. Fields depending on the observer (health, flags
+// for GMs, npc flags ...) are written as 0 and patched for each observer.
+struct UpdateValuesCache
+{
+    UpdateValuesCache() : built(false) {}
+
+    bool built;
+    ByteBuffer block;
+    std::vector<std::pair<uint32 /*offset*/, uint16 /*index*/> > observerFields;
+};
+
 enum ObjectDelayedAction
 {
     OBJECT_DELAYED_MARK_CLIENT_UPDATE       = 0x1,
@@ -359,12 +380,14 @@ class MANGOS_DLL_SPEC Object
         void ExecuteDelayedActions();
 
         void BuildValuesUpdateBlockForPlayer( UpdateData *data, Player *target ) const;
+        // Same result, but serializes the values once per visibility in 'caches' (MAX_UPDATE_VISIBILITY entries)
+        void BuildValuesUpdateBlockForPlayer( UpdateData *data, Player *target, UpdateValuesCache* caches ) const;
         void BuildOutOfRangeUpdateBlock( UpdateData *data ) const;
         void BuildMovementUpdateBlock( UpdateData * data, uint8 flags = 0 ) const;
 
         void BuildMovementUpdate(ByteBuffer * data, uint8 updateFlags) const;
         void BuildValuesUpdate(uint8 updatetype, ByteBuffer *data, UpdateMask *updateMask, Player *target ) const;
-        void BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players);
+        void BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players, UpdateValuesCache* caches = nullptr);
 
         void SendOutOfRangeUpdateToPlayer(Player* player);
 
@@ -595,6 +618,9 @@ class MANGOS_DLL_SPEC Object
         Pet* ToPet();
         virtual bool HasQuest(uint32 /* quest_id */) const { return false; }
         virtual bool HasInvolvedQuest(uint32 /* quest_id */) const { return false; }
+
+        // Indexes in the Map work queues, only meaningful while queued (see MapWorkQueue)
+        uint32 m_clientUpdateQueueSlot;
     protected:
 
         Object ( );
@@ -607,6 +633,13 @@ class MANGOS_DLL_SPEC Object
 
         virtual void _SetCreateBits(UpdateMask *updateMask, Player *target) const;
 
+        // Values update serialization helpers
+        void _SetForcedUpdateBits(uint8 updatetype, UpdateMask *updateMask, Player *target) const;
+        bool _UpdateQuestActivation(Player *target) const;
+        bool IsObserverDependentField(uint16 index) const;
+        uint32 GetUpdateFieldValue(uint16 index) const;
+        uint32 GetUpdateFieldValueFor(uint16 index, Player *target, bool isActivateToQuest) const;
+
         uint16 m_objectType;
 
         uint8 m_objectTypeId;
@@ -926,6 +959,11 @@ m_obj->m_updateTracker.Reset();
         uint32 GetCreatureSummonLimit() const { return m_creatureSummonLimit; }
         void SetCreatureSummonLimit(uint32 limit);
 
+        // Indexes in the Map work queues, only meaningful while queued (see MapWorkQueue)
+        uint32 m_relocatedQueueSlot;
+        uint32 m_movementQueueSlot;
+        uint32 m_removeQueueSlot;
+
     protected:
         explicit WorldObject();
 
@@ -85,6 +85,10 @@
 #include "GameEventMgr.h"
 #include "world/world_event_naxxramas.h"
 #include "world/world_event_wareffort.h"
+#include "Database/SqlBatchInsert.h"
+#include "PlayerSaveScheduler.h"
+
+#include <atomic>
 
 #define ZONE_UPDATE_INTERVAL (1*IN_MILLISECONDS)
 
@@ -456,6 +460,7 @@ Player::Player(WorldSession *session) : Unit(),
     // randomize first save time in range [CONFIG_UINT32_INTERVAL_SAVE] around [CONFIG_UINT32_INTERVAL_SAVE]
     // this must help in case next save after mass player load after server startup
     m_nextSave = urand(m_nextSave / 2, m_nextSave * 3 / 2);
+    m_saveWaitTime = 0;
 
     clearResurrectRequestData();
 
@@ -534,6 +539,10 @@ Player::Player(WorldSession *session) : Unit(),
     m_resetTalentsTime = 0;
     m_itemUpdateQueueBlocked = false;
 
+    m_saveRowsWritten = 0;
+    m_saveRowsDeleted = 0;
+    m_saveRowsSkipped = 0;
+
     m_stableSlots = 0;
 
     /////////////////// Instance System /////////////////////
@@ -1297,8 +1306,17 @@ void Player::Update(uint32 update_diff, uint32 p_time)
         if (update_diff >= m_nextSave)
         {
             // m_nextSave reseted in SaveToDB call
-            SaveToDB();
-            DETAIL_LOG("Player '%s' (GUID: %u) saved", GetName(), GetGUIDLow());
+            if (sPlayerSaveScheduler.RequestPeriodicSave(m_saveWaitTime))
+            {
+                SaveToDB();
+                DETAIL_LOG("Player '%s' (GUID: %u) saved", GetName(), GetGUIDLow());
+            }
+            else
+            {
+                // retry at next update
+                m_saveWaitTime += update_diff;
+                m_nextSave = 1;
+            }
         }
         else
             m_nextSave -= update_diff;
@@ -3764,6 +3782,13 @@ void Player::_LoadSpellCooldowns(QueryResult *result)
             time_t db_time  = (time_t)fields[2].GetUInt64();
             time_t db_cat_time = (time_t)fields[3].GetUInt64();
 
+            // as stored, even if not loaded
+            SpellCooldown& saved = m_savedSpellCooldowns[spell_id];
+            saved.end = db_time;
+            saved.cat = 0;
+            saved.categoryEnd = db_cat_time;
+            saved.itemid = item_id;
+
             SpellEntry const* spell = sSpellMgr.GetSpellEntry(spell_id);
 
             if (!spell)
@@ -3803,28 +3828,48 @@ void Player::_LoadSpellCooldowns(QueryResult *result)
 void Player::_SaveSpellCooldowns()
 {
     static SqlStatementID deleteSpellCooldown ;
-    static SqlStatementID insertSpellCooldown ;
-
-    SqlStatement stmt = CharacterDatabase.CreateStatement(deleteSpellCooldown, "DELETE FROM character_spell_cooldown WHERE guid = ?");
-    stmt.PExecute(GetGUIDLow());
 
     time_t curTime = time(NULL);
     time_t infTime = curTime + infinityCooldownDelayCheck;
 
+    SqlBatchInsert insert(CharacterDatabase, "INSERT INTO character_spell_cooldown (guid, spell, item, time, cattime) VALUES ",
+                          " ON DUPLICATE KEY UPDATE item = VALUES(item), time = VALUES(time), cattime = VALUES(cattime)");
+
     // remove outdated and save active
+    SpellCooldowns cooldowns;
     for (SpellCooldowns::iterator itr = m_spellCooldowns.begin(); itr != m_spellCooldowns.end();)
     {
         if (itr->second.end <= curTime)
             m_spellCooldowns.erase(itr++);
         else if (itr->second.end <= infTime)                // not save locked cooldowns, it will be reset or set at reload
         {
-            stmt = CharacterDatabase.CreateStatement(insertSpellCooldown, "INSERT INTO character_spell_cooldown (guid, spell, item, time, cattime) VALUES( ?, ?, ?, ?, ?)");
-            stmt.PExecute(GetGUIDLow(), itr->first, itr->second.itemid, uint64(itr->second.end), uint64(itr->second.categoryEnd));
+            cooldowns[itr->first] = itr->second;
+
+            SpellCooldowns::const_iterator saved = m_savedSpellCooldowns.find(itr->first);
+            if (saved != m_savedSpellCooldowns.end() && saved->second.end == itr->second.end &&
+                saved->second.categoryEnd == itr->second.categoryEnd && saved->second.itemid == itr->second.itemid)
+                ++m_saveRowsSkipped;
+            else
+                insert.AddRow("(%u, %u, %u, " UI64FMTD ", " UI64FMTD ")", GetGUIDLow(), itr->first, uint32(itr->second.itemid),
+                              uint64(itr->second.end), uint64(itr->second.categoryEnd));
             ++itr;
         }
         else
             ++itr;
     }
+    m_saveRowsWritten += insert.Flush();
+
+    SqlStatement stmt = CharacterDatabase.CreateStatement(deleteSpellCooldown, "DELETE FROM character_spell_cooldown WHERE guid = ? AND spell = ?");
+    for (SpellCooldowns::const_iterator itr = m_savedSpellCooldowns.begin(); itr != m_savedSpellCooldowns.end(); ++itr)
+    {
+        if (cooldowns.find(itr->first) == cooldowns.end())
+        {
+            stmt.PExecute(GetGUIDLow(), itr->first);
+            ++m_saveRowsDeleted;
+        }
+    }
+
+    m_savedSpellCooldowns.swap(cooldowns);
 }
 
 void Player::updateResetTalentsMultiplier()
@@ -15001,6 +15046,9 @@ void Player::_LoadAuras(QueryResult *result, uint32 timediff)
             s.remaintime = fields[12].GetInt32();
             s.effIndexMask = fields[13].GetUInt32();
 
+            // as stored, even if not loaded
+            m_savedAuras[s.GetKey()] = s;
+
             LoadAura(s, timediff);
         }
         while (result->NextRow());
@@ -15845,11 +15893,26 @@ void Player::_LoadGuild(QueryResult* result)
 /***                   SAVE SYSTEM                     ***/
 /*********************************************************/
 
+// Shared by all the map threads saving players
+static std::atomic<uint64> s_playerSaves(0);
+static std::atomic<uint64> s_playerSaveRowsWritten(0);
+static std::atomic<uint64> s_playerSaveRowsDeleted(0);
+static std::atomic<uint64> s_playerSaveRowsSkipped(0);
+
+void Player::GetSaveStats(PlayerSaveStats& stats)
+{
+    stats.saves = s_playerSaves;
+    stats.rowsWritten = s_playerSaveRowsWritten;
+    stats.rowsDeleted = s_playerSaveRowsDeleted;
+    stats.rowsSkipped = s_playerSaveRowsSkipped;
+}
+
 void Player::SaveToDB(bool online, bool force)
 {
     // we should assure this: ASSERT((m_nextSave != sWorld.getConfig(CONFIG_UINT32_INTERVAL_SAVE)));
     // delay auto save at any saves (manual, in code, or autosave)
     m_nextSave = sWorld.getConfig(CONFIG_UINT32_INTERVAL_SAVE);
+    m_saveWaitTime = 0;
 
     // Pas de sauvegarde des bots
     if (GetSession()->GetBot())
@@ -15867,6 +15930,10 @@ void Player::SaveToDB(bool online, bool force)
     //DEBUG_FILTER_LOG(LOG_FILTER_PLAYER_STATS, "The value of player %s at save: ", m_name.c_str());
     //outDebugStatsValues();
 
+    m_saveRowsWritten = 0;
+    m_saveRowsDeleted = 0;
+    m_saveRowsSkipped = 0;
+
     CharacterDatabase.BeginTransaction(GetGUIDLow());
 
     m_honorMgr.Update();
@@ -16015,6 +16082,7 @@ void Player::SaveToDB(bool online, bool force)
     uberInsert.addUInt32(GetWorldMask());
     uberInsert.addUInt32(customFlags);
     uberInsert.Execute();
+    ++m_saveRowsWritten;
 
     _SaveBGData();
     _SaveInventory();
@@ -16023,7 +16091,7 @@ void Player::SaveToDB(bool online, bool force)
     _SaveSpellCooldowns();
     _SaveAuras();
     _SaveSkills();
-    m_reputationMgr.SaveToDB();
+    m_saveRowsWritten += m_reputationMgr.SaveToDB();
     m_honorMgr.Save();
 
     // Systeme de phasing
@@ -16034,6 +16102,12 @@ void Player::SaveToDB(bool online, bool force)
 	_SaveVIPMemberInfo();
     CharacterDatabase.CommitTransaction();
 
+    s_playerSaves++;
+    s_playerSaveRowsWritten += m_saveRowsWritten;
+    s_playerSaveRowsDeleted += m_saveRowsDeleted;
+    s_playerSaveRowsSkipped += m_saveRowsSkipped;
+    DEBUG_LOG("Player %s saved: %u rows written, %u deleted, %u unchanged", GetName(), m_saveRowsWritten, m_saveRowsDeleted, m_saveRowsSkipped);
+
     // check if stats should only be saved on logout
     // save stats can be out of transaction
     if (m_session->isLogingOut() || !sWorld.getConfig(CONFIG_BOOL_STATS_SAVE_ONLY_ON_LOGOUT))
@@ -16075,47 +16149,53 @@ void Player::SaveGoldToDB()
 
 void Player::_SaveAuras()
 {
-    static SqlStatementID deleteAuras ;
-    static SqlStatementID insertAuras ;
-
-    SqlStatement stmt = CharacterDatabase.CreateStatement(deleteAuras, "DELETE FROM character_aura WHERE guid = ?");
-    stmt.PExecute(GetGUIDLow());
-
-    SpellAuraHolderMap const& auraHolders = GetSpellAuraHolderMap();
-
-    if (auraHolders.empty())
-        return;
-
-    stmt = CharacterDatabase.CreateStatement(insertAuras, "INSERT INTO character_aura (guid, caster_guid, item_guid, spell, stackcount, remaincharges, "
-            "basepoints0, basepoints1, basepoints2, periodictime0, periodictime1, periodictime2, maxduration, remaintime, effIndexMask) "
-            "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
+    static SqlStatementID deleteAura ;
 
+    AuraSaveMap auras;
     AuraSaveStruct s;
-    for (SpellAuraHolderMap::const_iterator itr = auraHolders.begin(); itr != auraHolders.end(); ++itr)
-    {
-        SpellAuraHolder *holder = itr->second;
+    for (SpellAuraHolderMap::const_iterator itr = GetSpellAuraHolderMap().begin(); itr != GetSpellAuraHolderMap().end(); ++itr)
+        if (SaveAura(itr->second, s))
+            auras.insert(AuraSaveMap::value_type(s.GetKey(), s));
 
-        if (!SaveAura(holder, s))
+    SqlStatement stmt = CharacterDatabase.CreateStatement(deleteAura, "DELETE FROM character_aura WHERE guid = ? AND caster_guid = ? AND item_guid = ? AND spell = ?");
+    for (AuraSaveMap::const_iterator itr = m_savedAuras.begin(); itr != m_savedAuras.end(); ++itr)
+    {
+        if (auras.find(itr->first) != auras.end())
             continue;
 
         stmt.addUInt32(GetGUIDLow());
-        stmt.addUInt64(s.caster_guid.GetRawValue());
-        stmt.addUInt32(s.item_lowguid);
-        stmt.addUInt32(s.spellid);
-        stmt.addUInt32(s.stackcount);
-        stmt.addUInt8(s.remaincharges);
+        stmt.addUInt64(std::get<0>(itr->first));
+        stmt.addUInt32(std::get<1>(itr->first));
+        stmt.addUInt32(std::get<2>(itr->first));
+        stmt.Execute();
+        ++m_saveRowsDeleted;
+    }
 
-        for (uint32 i = 0; i < MAX_EFFECT_INDEX; ++i)
-            stmt.addInt32(s.damage[i]);
+    SqlBatchInsert insert(CharacterDatabase, "INSERT INTO character_aura (guid, caster_guid, item_guid, spell, stackcount, remaincharges, "
+                          "basepoints0, basepoints1, basepoints2, periodictime0, periodictime1, periodictime2, maxduration, remaintime, effIndexMask) VALUES ",
+                          " ON DUPLICATE KEY UPDATE stackcount = VALUES(stackcount), remaincharges = VALUES(remaincharges), "
+                          "basepoints0 = VALUES(basepoints0), basepoints1 = VALUES(basepoints1), basepoints2 = VALUES(basepoints2), "
+                          "periodictime0 = VALUES(periodictime0), periodictime1 = VALUES(periodictime1), periodictime2 = VALUES(periodictime2), "
+                          "maxduration = VALUES(maxduration), remaintime = VALUES(remaintime), effIndexMask = VALUES(effIndexMask)");
 
-        for (uint32 i = 0; i < MAX_EFFECT_INDEX; ++i)
-            stmt.addUInt32(s.periodicTime[i]);
+    for (AuraSaveMap::const_iterator itr = auras.begin(); itr != auras.end(); ++itr)
+    {
+        AuraSaveMap::const_iterator saved = m_savedAuras.find(itr->first);
+        if (saved != m_savedAuras.end() && saved->second.IsSameRow(itr->second))
+        {
+            ++m_saveRowsSkipped;
+            continue;
+        }
 
-        stmt.addInt32(s.maxduration);
-        stmt.addInt32(s.remaintime);
-        stmt.addUInt32(s.effIndexMask);
-        stmt.Execute();
+        AuraSaveStruct const& aura = itr->second;
+        insert.AddRow("(%u, " UI64FMTD ", %u, %u, %u, %u, %i, %i, %i, %u, %u, %u, %i, %i, %u)",
+                      GetGUIDLow(), aura.caster_guid.GetRawValue(), aura.item_lowguid, aura.spellid, aura.stackcount, uint32(uint8(aura.remaincharges)),
+                      aura.damage[0], aura.damage[1], aura.damage[2], aura.periodicTime[0], aura.periodicTime[1], aura.periodicTime[2],
+                      aura.maxduration, aura.remaintime, aura.effIndexMask);
     }
+    m_saveRowsWritten += insert.Flush();
+
+    m_savedAuras.swap(auras);
 }
 
 bool Player::SaveAura(SpellAuraHolder* holder, AuraSaveStruct& saveStruct)
@@ -16199,6 +16279,7 @@ void Player::_SaveVIPMemberInfo()
 		stmtIns.addUInt32(0);
 	}
 	stmtIns.Execute();
+	++m_saveRowsWritten;
 }
 void Player::_SaveInventory()
 {
@@ -16303,11 +16384,14 @@ void Player::_SaveInventory()
             {
                 SqlStatement stmt = CharacterDatabase.CreateStatement(deleteInventory, "DELETE FROM character_inventory WHERE item = ?");
                 stmt.PExecute(item->GetGUIDLow());
+                ++m_saveRowsDeleted;
             }
             break;
             case ITEM_UNCHANGED:
                 break;
         }
+        if (item->GetState() == ITEM_NEW || item->GetState() == ITEM_CHANGED)
+            ++m_saveRowsWritten;
 
         item->SaveToDB();                                   // item have unchanged inventory record and can be save standalone
     }
@@ -16331,6 +16415,7 @@ void Player::_SaveQuestStatus()
             stmt.PExecute(GetGUIDLow(), i->first);
             mQuestStatus.erase(i);
             i = mQuestStatus.begin();
+            ++m_saveRowsDeleted;
             continue;
         }
         switch (i->second.uState)
@@ -16374,8 +16459,11 @@ void Player::_SaveQuestStatus()
             }
             break;
             case QUEST_UNCHANGED:
+                ++m_saveRowsSkipped;
                 break;
         };
+        if (i->second.uState != QUEST_UNCHANGED)
+            ++m_saveRowsWritten;
         i->second.uState = QUEST_UNCHANGED;
         ++i;
     }
@@ -16392,6 +16480,7 @@ void Player::_SaveSkills()
     {
         if (itr->second.uState == SKILL_UNCHANGED)
         {
+            ++m_saveRowsSkipped;
             ++itr;
             continue;
         }
@@ -16401,6 +16490,7 @@ void Player::_SaveSkills()
             SqlStatement stmt = CharacterDatabase.CreateStatement(delSkills, "DELETE FROM character_skills WHERE guid = ? AND skill = ?");
             stmt.PExecute(GetGUIDLow(), itr->first);
             mSkillStatus.erase(itr++);
+            ++m_saveRowsDeleted;
             continue;
         }
 
@@ -16428,6 +16518,7 @@ void Player::_SaveSkills()
                 break;
         };
         itr->second.uState = SKILL_UNCHANGED;
+        ++m_saveRowsWritten;
 
         ++itr;
     }
@@ -16436,19 +16527,21 @@ void Player::_SaveSkills()
 void Player::_SaveSpells()
 {
     static SqlStatementID delSpells ;
-    static SqlStatementID insSpells ;
 
     SqlStatement stmtDel = CharacterDatabase.CreateStatement(delSpells, "DELETE FROM character_spell WHERE guid = ? and spell = ?");
-    SqlStatement stmtIns = CharacterDatabase.CreateStatement(insSpells, "INSERT INTO character_spell (guid,spell,active,disabled) VALUES (?, ?, ?, ?)");
+    SqlBatchInsert insert(CharacterDatabase, "INSERT INTO character_spell (guid,spell,active,disabled) VALUES ",
+                          " ON DUPLICATE KEY UPDATE active = VALUES(active), disabled = VALUES(disabled)");
 
-    for (PlayerSpellMap::iterator itr = m_spells.begin(), next = m_spells.begin(); itr != m_spells.end();)
+    for (PlayerSpellMap::iterator itr = m_spells.begin(); itr != m_spells.end();)
     {
-        if (itr->second.state == PLAYERSPELL_REMOVED || itr->second.state == PLAYERSPELL_CHANGED)
-            stmtDel.PExecute(GetGUIDLow(), itr->first);
-
         // add only changed/new not dependent spells
         if (!itr->second.dependent && (itr->second.state == PLAYERSPELL_NEW || itr->second.state == PLAYERSPELL_CHANGED))
-            stmtIns.PExecute(GetGUIDLow(), itr->first, uint8(itr->second.active ? 1 : 0), uint8(itr->second.disabled ? 1 : 0));
+            insert.AddRow("(%u, %u, %u, %u)", GetGUIDLow(), itr->first, uint32(itr->second.active ? 1 : 0), uint32(itr->second.disabled ? 1 : 0));
+        else if (itr->second.state == PLAYERSPELL_REMOVED || itr->second.state == PLAYERSPELL_CHANGED)
+        {
+            stmtDel.PExecute(GetGUIDLow(), itr->first);
+            ++m_saveRowsDeleted;
+        }
 
         if (itr->second.state == PLAYERSPELL_REMOVED)
             m_spells.erase(itr++);
@@ -16457,8 +16550,8 @@ void Player::_SaveSpells()
             itr->second.state = PLAYERSPELL_UNCHANGED;
             ++itr;
         }
-
     }
+    m_saveRowsWritten += insert.Flush();
 }
 
 // save player stats -- only for external usage
@@ -20738,9 +20831,10 @@ void Player::InterruptSpellsWithCastItem(Item* item)
             }
 
     // Interrupt eventually delayed spells
-    auto i_Events = m_Events.GetEvents().begin();
-    for (; i_Events != m_Events.GetEvents().end(); ++i_Events)
-        if (SpellEvent* event = dynamic_cast<SpellEvent*>(i_Events->second))
+    std::vector<BasicEvent*> events;
+    m_Events.GetEvents(events);
+    for (BasicEvent* basicEvent : events)
+        if (SpellEvent* event = dynamic_cast<SpellEvent*>(basicEvent))
             if (event && event->GetSpell()->m_CastItem == item)
             {
                 event->GetSpell()->ClearCastItem();
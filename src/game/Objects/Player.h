@@ -47,6 +47,7 @@
 #include <string>
 #include <vector>
 #include <functional>
+#include <tuple>
 
 struct Mail;
 class Channel;
@@ -870,6 +871,32 @@ struct AuraSaveStruct
     int32 maxduration;
     int32 remaintime;
     uint32 effIndexMask;
+
+    // character_aura primary key, without the owner
+    typedef std::tuple<uint64, uint32, uint32> Key;
+    Key GetKey() const { return Key(caster_guid.GetRawValue(), item_lowguid, spellid); }
+
+    bool IsSameRow(AuraSaveStruct const& other) const
+    {
+        if (GetKey() != other.GetKey() || stackcount != other.stackcount || remaincharges != other.remaincharges ||
+            maxduration != other.maxduration || remaintime != other.remaintime || effIndexMask != other.effIndexMask)
+            return false;
+        for (int i = 0; i < MAX_EFFECT_INDEX; ++i)
+            if (damage[i] != other.damage[i] || periodicTime[i] != other.periodicTime[i])
+                return false;
+        return true;
+    }
+};
+
+typedef std::map<AuraSaveStruct::Key, AuraSaveStruct> AuraSaveMap;
+
+// Character saves since startup
+struct PlayerSaveStats
+{
+    uint64 saves;
+    uint64 rowsWritten;                                     // inserted or updated
+    uint64 rowsDeleted;
+    uint64 rowsSkipped;                                     // unchanged since the previous save
 };
 
 struct ScheduledTeleportData
@@ -1423,6 +1450,7 @@ class MANGOS_DLL_SPEC Player final: public Unit
 
         void SaveToDB(bool online = true, bool force = false);
         void SaveInventoryAndGoldToDB();                    // fast save function for item/money cheating preventing
+        static void GetSaveStats(PlayerSaveStats& stats);
         void SaveGoldToDB();
 
         static void SetUInt32ValueInArray(Tokens& data,uint16 index, uint32 value);
@@ -2334,6 +2362,7 @@ class MANGOS_DLL_SPEC Player final: public Unit
 
         Team m_team;
         uint32 m_nextSave;
+        uint32 m_saveWaitTime;                              // time the periodic save has been delayed by PlayerSaveScheduler
         uint32 m_atLoginFlags;
 
         Item* m_items[PLAYER_SLOTS_COUNT];
@@ -2342,6 +2371,16 @@ class MANGOS_DLL_SPEC Player final: public Unit
         std::vector<Item*> m_itemUpdateQueue;
         bool m_itemUpdateQueueBlocked;
 
+        // character_aura and character_spell_cooldown rows as of the last load / save,
+        // only rows differing from them are written
+        AuraSaveMap m_savedAuras;
+        SpellCooldowns m_savedSpellCooldowns;
+
+        // rows touched by the save in progress
+        uint32 m_saveRowsWritten;
+        uint32 m_saveRowsDeleted;
+        uint32 m_saveRowsSkipped;
+
         uint32 m_ExtraFlags;
         ObjectGuid m_curSelectionGuid;
 
@@ -354,7 +354,7 @@ void Unit::Update(uint32 update_diff, uint32 p_time)
     GetMotionMaster()->UpdateMotion(p_time);
     if (GetMotionMaster()->NeedsAsyncUpdate() && IsInWorld())
     {
-        if (sWorld.getConfig(CONFIG_UINT32_CONTINENTS_MOTIONUPDATE_THREADS) && GetMap()->IsContinent())
+        if (GetMap()->GetMotionUpdateThreads())
             GetMap()->AddUnitToMovementUpdate(this);
         else
             GetMotionMaster()->UpdateMotionAsync(p_time);
@@ -10518,9 +10518,10 @@ void Unit::InterruptSpellsCastedOnMe(bool killDelayed, bool interruptPositiveSpe
         if (!killDelayed)
             continue;
         // 2/ Interruption des sorts qui ne sont plus reference, mais dont il reste un event (ceux en parcours par exemple)
-        auto i_Events = (*iter)->m_Events.GetEvents().begin();
-        for (; i_Events != (*iter)->m_Events.GetEvents().end(); ++i_Events)
-            if (SpellEvent* event = dynamic_cast<SpellEvent*>(i_Events->second))
+        std::vector<BasicEvent*> events;
+        (*iter)->m_Events.GetEvents(events);
+        for (BasicEvent* basicEvent : events)
+            if (SpellEvent* event = dynamic_cast<SpellEvent*>(basicEvent))
                 if (event && event->GetSpell()->m_targets.getUnitTargetGuid() == GetObjectGuid())
                     if (event->GetSpell()->getState() != SPELL_STATE_FINISHED)
                         event->GetSpell()->cancel();
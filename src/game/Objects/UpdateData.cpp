@@ -28,6 +28,8 @@
 #include "World.h"
 #include "ObjectGuid.h"
 #include <zlib/zlib.h>
+#include <atomic>
+#include <mutex>
 
 #define MAX_UNCOMPRESSED_PACKET_SIZE 0x8000 // 32ko
 
@@ -66,44 +68,116 @@ void UpdateData::AddUpdateBlock(const ByteBuffer &block)
     ++it->blockCount;
 }
 
-void PacketCompressor::Compress(void* dst, uint32 *dst_size, void* src, int src_size)
+// Deflate state of a thread building update packets. Allocating and
+// initializing it costs ~256KB per packet, so it is kept for the thread
+// lifetime and only reset between packets.
+class DeflateContext
 {
-    z_stream c_stream;
-
-    c_stream.zalloc = (alloc_func)0;
-    c_stream.zfree = (free_func)0;
-    c_stream.opaque = (voidpf)0;
+    public:
+        DeflateContext() : m_initialized(false), m_level(0), m_strategy(0)
+        {
+            memset(&m_stream, 0, sizeof(m_stream));
+        }
+
+        ~DeflateContext()
+        {
+            if (m_initialized)
+                deflateEnd(&m_stream);
+        }
+
+        // Returns a stream ready for a new packet, or nullptr on failure
+        z_stream* Acquire(int level, int strategy)
+        {
+            if (m_initialized && (level != m_level || strategy != m_strategy))
+            {
+                // deflateParams flushes pending data, a fresh stream is simpler
+                deflateEnd(&m_stream);
+                m_initialized = false;
+            }
+
+            int z_res;
+            if (m_initialized)
+                z_res = deflateReset(&m_stream);
+            else
+            {
+                memset(&m_stream, 0, sizeof(m_stream));
+                z_res = deflateInit2(&m_stream, level, Z_DEFLATED, MAX_WBITS, 8, strategy);
+            }
+
+            if (z_res != Z_OK)
+            {
+                sLog.outError("Can't compress update packet (zlib: %s) Error code: %i (%s)", m_initialized ? "deflateReset" : "deflateInit2", z_res, zError(z_res));
+                if (m_initialized)
+                    deflateEnd(&m_stream);
+                m_initialized = false;
+                return nullptr;
+            }
+
+            m_initialized = true;
+            m_level = level;
+            m_strategy = strategy;
+            return &m_stream;
+        }
+
+    private:
+        z_stream m_stream;
+        bool m_initialized;
+        int m_level;
+        int m_strategy;
+};
+
+static thread_local DeflateContext s_deflateContext;
+
+#define COMPRESSION_SAMPLE_RATE     128     // keep one update buffer every N packets
+#define COMPRESSION_MAX_SAMPLES     32
+
+static std::mutex s_samplesLock;
+static std::vector<std::vector<uint8> > s_samples;
+static uint32 s_nextSample = 0;
+static std::atomic<uint32> s_compressedPackets(0);
+
+static void SampleUpdateBuffer(void const* src, int src_size)
+{
+    if (s_compressedPackets++ % COMPRESSION_SAMPLE_RATE)
+        return;
 
-    // default Z_BEST_SPEED (1)
-    int z_res = deflateInit(&c_stream, sWorld.getConfig(CONFIG_UINT32_COMPRESSION));
-    if (z_res != Z_OK)
-    {
-        sLog.outError("Can't compress update packet (zlib: deflateInit) Error code: %i (%s)", z_res, zError(z_res));
-        *dst_size = 0;
+    // Never stall a map thread for a benchmark sample
+    std::unique_lock<std::mutex> guard(s_samplesLock, std::try_to_lock);
+    if (!guard.owns_lock())
         return;
-    }
 
-    c_stream.next_out = (Bytef*)dst;
-    c_stream.avail_out = *dst_size;
-    c_stream.next_in = (Bytef*)src;
-    c_stream.avail_in = (uInt)src_size;
+    uint8 const* data = static_cast<uint8 const*>(src);
+    if (s_samples.size() < COMPRESSION_MAX_SAMPLES)
+        s_samples.emplace_back(data, data + src_size);
+    else
+        s_samples[s_nextSample].assign(data, data + src_size);
+    s_nextSample = (s_nextSample + 1) % COMPRESSION_MAX_SAMPLES;
+}
 
-    z_res = deflate(&c_stream, Z_NO_FLUSH);
-    if (z_res != Z_OK)
-    {
-        sLog.outError("Can't compress update packet (zlib: deflate) Error code: %i (%s)", z_res, zError(z_res));
-        *dst_size = 0;
-        return;
-    }
+void PacketCompressor::Compress(void* dst, uint32 *dst_size, void* src, int src_size)
+{
+    SampleUpdateBuffer(src, src_size);
 
-    if (c_stream.avail_in != 0)
+    // default Z_BEST_SPEED (1)
+    Compress(dst, dst_size, src, src_size, sWorld.getConfig(CONFIG_UINT32_COMPRESSION), sWorld.getConfig(CONFIG_UINT32_COMPRESSION_STRATEGY));
+}
+
+void PacketCompressor::Compress(void* dst, uint32 *dst_size, void* src, int src_size, int level, int strategy)
+{
+    z_stream* c_stream = s_deflateContext.Acquire(level, strategy);
+    if (!c_stream)
     {
-        sLog.outError("Can't compress update packet (zlib: deflate not greedy)");
         *dst_size = 0;
         return;
     }
 
-    z_res = deflate(&c_stream, Z_FINISH);
+    c_stream->next_out = (Bytef*)dst;
+    c_stream->avail_out = *dst_size;
+    c_stream->next_in = (Bytef*)src;
+    c_stream->avail_in = (uInt)src_size;
+
+    // dst is always compressBound(src_size) large, a single call is enough
+    int z_res = deflate(c_stream, Z_FINISH);
     if (z_res != Z_STREAM_END)
     {
         sLog.outError("Can't compress update packet (zlib: deflate should report Z_STREAM_END instead %i (%s)", z_res, zError(z_res));
@@ -111,15 +185,13 @@ void PacketCompressor::Compress(void* dst, uint32 *dst_size, void* src, int src_
         return;
     }
 
-    z_res = deflateEnd(&c_stream);
-    if (z_res != Z_OK)
-    {
-        sLog.outError("Can't compress update packet (zlib: deflateEnd) Error code: %i (%s)", z_res, zError(z_res));
-        *dst_size = 0;
-        return;
-    }
+    *dst_size = c_stream->total_out;
+}
 
-    *dst_size = c_stream.total_out;
+void PacketCompressor::GetSamples(std::vector<std::vector<uint8> >& samples)
+{
+    std::lock_guard<std::mutex> guard(s_samplesLock);
+    samples = s_samples;
 }
 
 bool UpdateData::BuildPacket(WorldPacket *packet, bool hasTransport)
@@ -63,7 +63,11 @@ class UpdatePacket
 class PacketCompressor
 {
     public:
+        // Uses the configured level and strategy. Sets *dst_size to 0 on failure.
         static void Compress(void* dst, uint32 *dst_size, void* src, int src_size);
+        static void Compress(void* dst, uint32 *dst_size, void* src, int src_size, int level, int strategy);
+        // Copy of the update buffers recently sampled from Compress, for benchmarks
+        static void GetSamples(std::vector<std::vector<uint8> >& samples);
 };
 
 class UpdateData
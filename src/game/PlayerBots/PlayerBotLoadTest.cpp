@@ -0,0 +1,591 @@
+/*
+ * Copyright (C) 2017 Light's Hope <https://lightshope.org>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Common.h"
+#include "Policies/SingletonImp.h"
+#include "PlayerBotLoadTest.h"
+#include "PlayerBotMgr.h"
+#include "PlayerBotAI.h"
+#include "AutoTestingMgr.h"
+#include "Config/Config.h"
+#include "World.h"
+#include "Chat.h"
+#include "Player.h"
+#include "Creature.h"
+#include "MapManager.h"
+#include "ObjectAccessor.h"
+#include "MotionMaster.h"
+#include "MoveSpline.h"
+#include "Cell.h"
+#include "Log.h"
+#include "Timer.h"
+
+#include <cstdio>
+#include <random>
+
+INSTANTIATE_SINGLETON_1(PlayerBotLoadTest);
+
+namespace
+{
+    struct LoadTestSite
+    {
+        uint32 mapId;
+        float x, y, z;
+        float minRadius, maxRadius;
+        uint32 team;                                        // 0: both factions
+    };
+
+    struct LoadTestProfileInfo
+    {
+        char const* name;
+        LoadTestSite sites[2];                              // bots are spread over the sites
+        uint32 sitesCount;
+    };
+
+    LoadTestProfileInfo const loadTestProfiles[MAX_LOADTEST_PROFILES] =
+    {
+        { "city",    { { 0, -8829.5f, 625.6f, 93.9f, 0.0f, 40.0f, ALLIANCE }, { 1, 1568.0f, -4405.87f, 8.13f, 0.0f, 60.0f, HORDE } }, 2 },
+        { "walkers", { { 0, -9464.0f, 62.0f, 56.0f, 0.0f, 40.0f, ALLIANCE }, { 1, 315.7f, -4743.4f, 10.0f, 0.0f, 40.0f, HORDE } }, 2 },
+        { "raid",    { { MAP_TESTING_ID, 0.0f, 0.0f, -144.6f, 12.0f, 25.0f, ALLIANCE } }, 1 },
+        { "bg",      { { 0, -13209.0f, 265.666f, 21.85f, 5.0f, 30.0f, 0 } }, 1 },
+    };
+
+    uint8 const loadTestClasses[] = { CLASS_WARRIOR, CLASS_MAGE, CLASS_ROGUE, CLASS_PRIEST };
+
+    uint8 GetLoadTestRace(uint32 team, uint8 class_)
+    {
+        if (team == ALLIANCE)
+            return RACE_HUMAN;
+        return (class_ == CLASS_WARRIOR || class_ == CLASS_ROGUE) ? RACE_ORC : RACE_UNDEAD;
+    }
+
+    char const* const mapUpdatePhaseNames[MAX_MAP_UPDATE_PHASES] =
+    {
+        "sessions", "players", "cells", "sendObjUpdates", "relocations", "players2", "barrierWait", "total"
+    };
+
+    enum
+    {
+        SPELL_FIREBALL      = 133,
+        SPELL_SMITE         = 585,
+        SPELL_LESSER_HEAL   = 2050,
+    };
+}
+
+// Every decision of the bot comes from its own seeded generator
+class LoadTestBotAI : public PlayerCreatorAI
+{
+    public:
+        LoadTestBotAI(LoadTestProfile profile, uint32 seed, uint8 race, uint8 class_, uint32 mapId, uint32 instanceId, float x, float y, float z, float o) :
+            PlayerCreatorAI(nullptr, race, class_, mapId, instanceId, x, y, z, o), m_profile(profile), m_rng(seed), m_actionTimer(0)
+        {
+        }
+
+        void OnPlayerLogin() override;
+        void UpdateAI(uint32 const diff) override;
+
+    private:
+        uint32 Rand(uint32 min, uint32 max) { return std::uniform_int_distribution<uint32>(min, max)(m_rng); }
+        float RandFloat(float min, float max) { return std::uniform_real_distribution<float>(min, max)(m_rng); }
+
+        void UpdateCityCrowd();
+        void UpdateWalker();
+        void UpdateFighter(Unit* target);
+
+        LoadTestProfile m_profile;
+        std::mt19937 m_rng;
+        uint32 m_actionTimer;
+};
+
+void LoadTestBotAI::OnPlayerLogin()
+{
+    if (m_profile == LOADTEST_PROFILE_RAID_COMBAT || m_profile == LOADTEST_PROFILE_BG_FIGHT)
+    {
+        me->GiveLevel(60);
+        // Nobody dies, the load stays the same during the whole test
+        me->SetGodMode(true);
+        if (m_profile == LOADTEST_PROFILE_BG_FIGHT)
+            me->SetFFAPvP(true);
+    }
+    // Do not have all the bots acting on the same tick
+    m_actionTimer = Rand(0, 2000);
+}
+
+void LoadTestBotAI::UpdateAI(uint32 const diff)
+{
+    PlayerBotAI::UpdateAI(diff);
+
+    if (!me || !me->IsInWorld() || me->IsBeingTeleported())
+        return;
+
+    if (m_actionTimer > diff)
+    {
+        m_actionTimer -= diff;
+        return;
+    }
+
+    switch (m_profile)
+    {
+        case LOADTEST_PROFILE_CITY_CROWD:
+            UpdateCityCrowd();
+            m_actionTimer = Rand(10000, 30000);
+            break;
+        case LOADTEST_PROFILE_RANDOM_WALKERS:
+            UpdateWalker();
+            m_actionTimer = Rand(3000, 10000);
+            break;
+        case LOADTEST_PROFILE_RAID_COMBAT:
+            UpdateFighter(me->GetMap()->GetCreature(sPlayerBotLoadTest.GetBossGuid()));
+            m_actionTimer = Rand(1000, 2000);
+            break;
+        case LOADTEST_PROFILE_BG_FIGHT:
+        {
+            Unit* target = me->getVictim();
+            if (!target || !target->isAlive())
+                target = me->SelectNearestTarget(40.0f);
+            UpdateFighter(target);
+            m_actionTimer = Rand(1000, 2000);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void LoadTestBotAI::UpdateCityCrowd()
+{
+    static uint32 const emotes[] = { EMOTE_ONESHOT_TALK, EMOTE_ONESHOT_BOW, EMOTE_ONESHOT_WAVE, EMOTE_ONESHOT_CHEER, EMOTE_ONESHOT_LAUGH };
+
+    if (Rand(0, 3))
+        me->HandleEmoteCommand(emotes[Rand(0, sizeof(emotes) / sizeof(emotes[0]) - 1)]);
+    else
+        me->SetFacingTo(RandFloat(0.0f, 2 * M_PI_F));
+}
+
+void LoadTestBotAI::UpdateWalker()
+{
+    if (!me->movespline->Finalized())
+        return;
+
+    // Random point around the spawn position, so that the bots stay in the area
+    float angle = RandFloat(0.0f, 2 * M_PI_F);
+    float dist = RandFloat(5.0f, 40.0f);
+    float x = _x + dist * cos(angle);
+    float y = _y + dist * sin(angle);
+    float z = _z;
+    if (me->GetMap()->GetWalkHitPosition(nullptr, me->GetPositionX(), me->GetPositionY(), me->GetPositionZ(), x, y, z))
+        me->GetMotionMaster()->MovePoint(0, x, y, z, MOVE_PATHFINDING);
+}
+
+void LoadTestBotAI::UpdateFighter(Unit* target)
+{
+    if (!target)
+        return;
+
+    bool caster = _class == CLASS_MAGE || _class == CLASS_PRIEST;
+    if (me->getVictim() != target)
+    {
+        me->Attack(target, !caster);
+        if (caster)
+            me->GetMotionMaster()->MoveChase(target, 25.0f);
+        else
+            me->GetMotionMaster()->MoveChase(target);
+    }
+
+    if (!caster || me->IsNonMeleeSpellCasted(false))
+        return;
+
+    // Mana is not what is measured
+    me->SetPower(POWER_MANA, me->GetMaxPower(POWER_MANA));
+
+    if (_class == CLASS_PRIEST && m_profile == LOADTEST_PROFILE_RAID_COMBAT && !Rand(0, 2))
+    {
+        if (Player* healed = me->GetMap()->GetPlayer(sPlayerBotLoadTest.GetBotGuid(Rand(0, sPlayerBotLoadTest.GetBotsCount() - 1))))
+        {
+            me->CastSpell(healed, SPELL_LESSER_HEAL, false);
+            return;
+        }
+    }
+
+    me->SetFacingToObject(target);
+    me->CastSpell(target, _class == CLASS_MAGE ? SPELL_FIREBALL : SPELL_SMITE, false);
+}
+
+PlayerBotLoadTest::PlayerBotLoadTest() :
+    m_state(LOADTEST_STATE_IDLE), m_profile(LOADTEST_PROFILE_CITY_CROWD), m_seed(0), m_botsCount(0), m_ticks(0), m_tick(0), m_timer(0),
+    m_stopWorld(false), m_raidMap(nullptr), m_measureStart(0), m_diffTotal(0), m_diffMax(0)
+{
+    /* Config */
+    m_confEnable        = false;
+    m_confProfile       = LOADTEST_PROFILE_RAID_COMBAT;
+    m_confBots          = 40;
+    m_confTicks         = 1200;
+    m_confWarmupTicks   = 200;
+    m_confSeed          = 1;
+    m_confSpawnTimeout  = 60000;
+    m_confBossEntry     = 12118;
+}
+
+void PlayerBotLoadTest::LoadConfig(bool reload)
+{
+    // The headless run stops the server: only started with the server, never by a config reload
+    if (!reload)
+        m_confEnable    = sConfig.GetBoolDefault("PlayerBot.LoadTest.Enable", false);
+    m_confBots          = sConfig.GetIntDefault("PlayerBot.LoadTest.Bots", 40);
+    m_confTicks         = sConfig.GetIntDefault("PlayerBot.LoadTest.Ticks", 1200);
+    m_confWarmupTicks   = sConfig.GetIntDefault("PlayerBot.LoadTest.WarmupTicks", 200);
+    m_confSeed          = sConfig.GetIntDefault("PlayerBot.LoadTest.Seed", 1);
+    m_confSpawnTimeout  = sConfig.GetIntDefault("PlayerBot.LoadTest.SpawnTimeout", 60000);
+    m_confBossEntry     = sConfig.GetIntDefault("PlayerBot.LoadTest.BossEntry", 12118);
+    m_confOutput        = sConfig.GetStringDefault("PlayerBot.LoadTest.Output", "loadtest.json");
+
+    std::string profile = sConfig.GetStringDefault("PlayerBot.LoadTest.Profile", "raid");
+    if (!FindProfile(profile.c_str(), m_confProfile))
+    {
+        sLog.outError("PlayerBot.LoadTest.Profile: unknown profile '%s', using 'raid'.", profile.c_str());
+        m_confProfile = LOADTEST_PROFILE_RAID_COMBAT;
+    }
+}
+
+char const* PlayerBotLoadTest::GetProfileName(LoadTestProfile profile)
+{
+    return profile < MAX_LOADTEST_PROFILES ? loadTestProfiles[profile].name : "unknown";
+}
+
+bool PlayerBotLoadTest::FindProfile(char const* name, LoadTestProfile& profile)
+{
+    for (uint32 i = 0; i < MAX_LOADTEST_PROFILES; ++i)
+    {
+        if (strcmp(name, loadTestProfiles[i].name) == 0)
+        {
+            profile = LoadTestProfile(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+ObjectGuid PlayerBotLoadTest::GetBotGuid(uint32 index) const
+{
+    return index < m_bots.size() ? ObjectGuid(HIGHGUID_PLAYER, m_bots[index]) : ObjectGuid();
+}
+
+bool PlayerBotLoadTest::Start(LoadTestProfile profile, uint32 bots, uint32 ticks, uint32 seed, bool stopWorld)
+{
+    if (m_state != LOADTEST_STATE_IDLE || profile >= MAX_LOADTEST_PROFILES || !bots || !ticks)
+        return false;
+
+    m_profile = profile;
+    m_botsCount = bots;
+    m_ticks = ticks;
+    m_seed = seed;
+    m_stopWorld = stopWorld;
+    m_tick = 0;
+    m_timer = 0;
+    m_bots.clear();
+    m_raidMap = nullptr;
+    m_bossGuid.Clear();
+
+    sLog.outString("[LoadTest] Starting '%s': %u bots, %u ticks, seed %u.", GetProfileName(m_profile), m_botsCount, m_ticks, m_seed);
+    SpawnBots();
+    m_state = LOADTEST_STATE_SPAWNING;
+    return true;
+}
+
+void PlayerBotLoadTest::Stop()
+{
+    if (m_state == LOADTEST_STATE_IDLE || m_state == LOADTEST_STATE_CLEANUP)
+        return;
+
+    sLog.outString("[LoadTest] '%s' stopped at tick %u.", GetProfileName(m_profile), m_tick);
+    Finish();
+}
+
+void PlayerBotLoadTest::SpawnBots()
+{
+    LoadTestProfileInfo const& info = loadTestProfiles[m_profile];
+    std::mt19937 rng(m_seed);
+
+    // Grids are loaded before computing the bots positions
+    Map* maps[2] = { nullptr, nullptr };
+    for (uint32 i = 0; i < info.sitesCount; ++i)
+    {
+        LoadTestSite const& site = info.sites[i];
+        maps[i] = sMapMgr.CreateTestMap(site.mapId, m_profile == LOADTEST_PROFILE_RAID_COMBAT, site.x, site.y);
+        maps[i]->LoadGrid(Cell(MaNGOS::ComputeCellPair(site.x, site.y)));
+    }
+    if (m_profile == LOADTEST_PROFILE_RAID_COMBAT)
+        m_raidMap = maps[0];
+
+    for (uint32 i = 0; i < m_botsCount; ++i)
+    {
+        LoadTestSite const& site = info.sites[i % info.sitesCount];
+        Map* map = maps[i % info.sitesCount];
+        uint32 team = site.team ? site.team : (i % 2 ? HORDE : ALLIANCE);
+        uint8 class_ = loadTestClasses[(i / info.sitesCount) % (sizeof(loadTestClasses) / sizeof(loadTestClasses[0]))];
+
+        float angle = std::uniform_real_distribution<float>(0.0f, 2 * M_PI_F)(rng);
+        float dist = std::uniform_real_distribution<float>(site.minRadius, site.maxRadius)(rng);
+        float x = site.x + dist * cos(angle);
+        float y = site.y + dist * sin(angle);
+        float z = map->GetHeight(x, y, site.z + 5.0f);
+        if (z <= INVALID_HEIGHT)
+            z = site.z;
+
+        // Facing the center of the site
+        LoadTestBotAI* ai = new LoadTestBotAI(m_profile, rng(), GetLoadTestRace(team, class_), class_, site.mapId, map->GetInstanceId(),
+                                              x, y, z, MapManager::NormalizeOrientation(angle + M_PI_F));
+        sPlayerBotMgr.addBot(ai);
+        m_bots.push_back(ai->botEntry->playerGUID);
+    }
+}
+
+void PlayerBotLoadTest::UpdateBoss()
+{
+    if (m_profile != LOADTEST_PROFILE_RAID_COMBAT || !m_raidMap)
+        return;
+
+    Creature* boss = m_bossGuid ? m_raidMap->GetCreature(m_bossGuid) : nullptr;
+    if (boss && boss->isAlive())
+        return;
+    if (boss)
+        boss->AddObjectToRemoveList();
+
+    LoadTestSite const& site = loadTestProfiles[m_profile].sites[0];
+    if (Creature* summon = m_raidMap->SummonCreature(m_confBossEntry, site.x, site.y, site.z, 0.0f, TEMPSUMMON_MANUAL_DESPAWN, 0, true))
+        m_bossGuid = summon->GetObjectGuid();
+    else
+    {
+        sLog.outError("[LoadTest] Unable to summon the boss (entry %u), stopping.", m_confBossEntry);
+        Stop();
+    }
+}
+
+uint32 PlayerBotLoadTest::CountBotsInWorld() const
+{
+    uint32 count = 0;
+    for (uint32 guid : m_bots)
+        if (ObjectAccessor::FindPlayer(ObjectGuid(HIGHGUID_PLAYER, guid)))
+            ++count;
+    return count;
+}
+
+void PlayerBotLoadTest::BeginMeasure()
+{
+    // Map::Update phases are measured from now on
+    for (auto const& itr : sMapMgr.Maps())
+        itr.second->ResetUpdatePhaseStats();
+
+    sLog.outString("[LoadTest] Measuring %u ticks.", m_ticks);
+    m_state = LOADTEST_STATE_MEASURING;
+    m_tick = 0;
+    m_diffTotal = 0;
+    m_diffMax = 0;
+    m_measureStart = WorldTimer::getMSTime();
+}
+
+void PlayerBotLoadTest::Update(uint32 diff)
+{
+    // Headless run, started once the world is up
+    if (m_confEnable)
+    {
+        m_confEnable = false;
+        Start(m_confProfile, m_confBots, m_confTicks, m_confSeed, true);
+    }
+
+    switch (m_state)
+    {
+        case LOADTEST_STATE_SPAWNING:
+        {
+            UpdateBoss();
+            uint32 inWorld = CountBotsInWorld();
+            m_timer += diff;
+            if (inWorld < m_bots.size() && m_timer < m_confSpawnTimeout)
+                return;
+            if (inWorld < m_bots.size())
+                sLog.outError("[LoadTest] Only %u/%u bots in world after %ums, starting anyway.", inWorld, uint32(m_bots.size()), m_timer);
+            sLog.outString("[LoadTest] %u bots in world, warming up for %u ticks.", inWorld, m_confWarmupTicks);
+            m_state = LOADTEST_STATE_WARMUP;
+            m_tick = 0;
+            if (!m_confWarmupTicks)
+                BeginMeasure();
+            return;
+        }
+        case LOADTEST_STATE_WARMUP:
+            UpdateBoss();
+            if (++m_tick >= m_confWarmupTicks)
+                BeginMeasure();
+            return;
+        case LOADTEST_STATE_MEASURING:
+            UpdateBoss();
+            // Called after the maps update: this tick is part of the measure
+            m_diffTotal += diff;
+            if (diff > m_diffMax)
+                m_diffMax = diff;
+            if (++m_tick < m_ticks)
+                return;
+            WriteReport();
+            Finish();
+            return;
+        case LOADTEST_STATE_CLEANUP:
+            m_timer += diff;
+            if (m_raidMap->HavePlayers() && m_timer < m_confSpawnTimeout)
+                return;
+            EndCleanup();
+            return;
+        default:
+            return;
+    }
+}
+
+void PlayerBotLoadTest::WriteReport()
+{
+    uint32 duration = WorldTimer::getMSTimeDiffToNow(m_measureStart);
+    sLog.outString("[LoadTest] '%s' done: %u ticks in %ums (avg %.2fms, max %ums).",
+                   GetProfileName(m_profile), m_ticks, duration, double(m_diffTotal) / m_ticks, m_diffMax);
+
+    FILE* file = fopen(m_confOutput.c_str(), "w");
+    if (!file)
+    {
+        sLog.outError("[LoadTest] Unable to write the report to '%s'.", m_confOutput.c_str());
+        return;
+    }
+
+    fprintf(file, "{\n");
+    fprintf(file, "  \"profile\": \"%s\",\n", GetProfileName(m_profile));
+    fprintf(file, "  \"seed\": %u,\n", m_seed);
+    fprintf(file, "  \"bots\": %u,\n", m_botsCount);
+    fprintf(file, "  \"botsInWorld\": %u,\n", CountBotsInWorld());
+    fprintf(file, "  \"warmupTicks\": %u,\n", m_confWarmupTicks);
+    fprintf(file, "  \"ticks\": %u,\n", m_ticks);
+    fprintf(file, "  \"world\": { \"durationMs\": %u, \"tickAvgMs\": %.3f, \"tickMaxMs\": %u },\n",
+            duration, double(m_diffTotal) / m_ticks, m_diffMax);
+    fprintf(file, "  \"maps\": [");
+
+    bool first = true;
+    for (auto const& itr : sMapMgr.Maps())
+    {
+        Map* map = itr.second;
+        MapUpdatePhaseStats const& stats = map->GetUpdatePhaseStats();
+        if (!stats.updates)
+            continue;
+
+        fprintf(file, "%s\n    { \"map\": %u, \"instance\": %u, \"players\": %u, \"updates\": %u, \"phases\": {",
+                first ? "" : ",", map->GetId(), map->GetInstanceId(), map->GetPlayersCountExceptGMs(), stats.updates);
+        for (uint32 phase = 0; phase < MAX_MAP_UPDATE_PHASES; ++phase)
+            fprintf(file, "%s\n      \"%s\": { \"totalMs\": " UI64FMTD ", \"avgMs\": %.3f, \"maxMs\": %u }",
+                    phase ? "," : "", mapUpdatePhaseNames[phase], stats.total[phase], double(stats.total[phase]) / stats.updates, stats.max[phase]);
+        fprintf(file, "\n    } }");
+        first = false;
+    }
+
+    fprintf(file, "\n  ]\n}\n");
+    fclose(file);
+    sLog.outString("[LoadTest] Report written to '%s'.", m_confOutput.c_str());
+}
+
+void PlayerBotLoadTest::Finish()
+{
+    // Logged out at their next session update
+    for (uint32 guid : m_bots)
+        sPlayerBotMgr.deleteBot(guid);
+    m_bots.clear();
+
+    if (m_raidMap && m_bossGuid)
+        if (Creature* boss = m_raidMap->GetCreature(m_bossGuid))
+            boss->AddObjectToRemoveList();
+    m_bossGuid.Clear();
+
+    // The raid instance is deleted once the bots are out of it
+    if (m_raidMap)
+    {
+        m_state = LOADTEST_STATE_CLEANUP;
+        m_timer = 0;
+        return;
+    }
+
+    EndCleanup();
+}
+
+void PlayerBotLoadTest::EndCleanup()
+{
+    if (m_raidMap)
+    {
+        if (m_raidMap->HavePlayers())
+            sLog.outError("[LoadTest] Players still in the raid map %u (instance %u) after %ums, map kept.",
+                          m_raidMap->GetId(), m_raidMap->GetInstanceId(), m_timer);
+        else
+            sMapMgr.DeleteTestMap(m_raidMap);
+    }
+    m_raidMap = nullptr;
+    m_state = LOADTEST_STATE_IDLE;
+
+    if (m_stopWorld)
+        World::StopNow(SHUTDOWN_EXIT_CODE);
+}
+
+bool ChatHandler::HandleBotLoadTestCommand(char* args)
+{
+    static char const* const stateNames[] = { "idle", "spawning", "warmup", "measuring", "cleanup" };
+
+    if (!*args)
+    {
+        if (sPlayerBotLoadTest.GetState() == LOADTEST_STATE_IDLE)
+            SendSysMessage("No load test running. Usage: .bot loadtest <city|walkers|raid|bg> [bots] [ticks] [seed] | stop");
+        else
+            PSendSysMessage("Load test '%s': %u bots, %s, tick %u/%u",
+                            PlayerBotLoadTest::GetProfileName(sPlayerBotLoadTest.GetProfile()), sPlayerBotLoadTest.GetBotsCount(),
+                            stateNames[sPlayerBotLoadTest.GetState()], sPlayerBotLoadTest.GetTick(), sPlayerBotLoadTest.GetTicks());
+        return true;
+    }
+
+    char* profileName = ExtractLiteralArg(&args);
+    if (!profileName)
+        return false;
+
+    if (strcmp(profileName, "stop") == 0)
+    {
+        sPlayerBotLoadTest.Stop();
+        SendSysMessage("Load test stopped.");
+        return true;
+    }
+
+    LoadTestProfile profile;
+    if (!PlayerBotLoadTest::FindProfile(profileName, profile))
+    {
+        PSendSysMessage("Unknown load test profile '%s' (city, walkers, raid, bg).", profileName);
+        SetSentErrorMessage(true);
+        return false;
+    }
+
+    uint32 bots, ticks, seed;
+    if (!ExtractOptUInt32(&args, bots, sPlayerBotLoadTest.GetDefaultBotsCount()) ||
+        !ExtractOptUInt32(&args, ticks, sPlayerBotLoadTest.GetDefaultTicks()) ||
+        !ExtractOptUInt32(&args, seed, sPlayerBotLoadTest.GetDefaultSeed()))
+        return false;
+
+    if (!sPlayerBotLoadTest.Start(profile, bots, ticks, seed, false))
+    {
+        SendSysMessage("A load test is already running.");
+        SetSentErrorMessage(true);
+        return false;
+    }
+
+    PSendSysMessage("Load test '%s' started: %u bots, %u ticks, seed %u.", PlayerBotLoadTest::GetProfileName(profile), bots, ticks, seed);
+    return true;
+}
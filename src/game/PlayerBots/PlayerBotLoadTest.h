@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2017 Light's Hope <https://lightshope.org>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _PLAYERBOTLOADTEST_H
+#define _PLAYERBOTLOADTEST_H
+
+#include "Common.h"
+#include "Policies/Singleton.h"
+#include "ObjectGuid.h"
+
+#include <vector>
+
+class Map;
+
+enum LoadTestProfile
+{
+    LOADTEST_PROFILE_CITY_CROWD,                            // idle players in the capitals
+    LOADTEST_PROFILE_RANDOM_WALKERS,                        // players walking around Goldshire and Razor Hill
+    LOADTEST_PROFILE_RAID_COMBAT,                           // raid fighting a boss on an instanced test map
+    LOADTEST_PROFILE_BG_FIGHT,                              // both factions fighting in the Gurubashi arena
+    MAX_LOADTEST_PROFILES
+};
+
+enum LoadTestState
+{
+    LOADTEST_STATE_IDLE,
+    LOADTEST_STATE_SPAWNING,                                // waiting for the bots to be in world
+    LOADTEST_STATE_WARMUP,
+    LOADTEST_STATE_MEASURING,
+    LOADTEST_STATE_CLEANUP                                  // waiting for the bots to leave the raid map
+};
+
+/*
+ * Reproducible load test: spawns bots of a behavior profile from a fixed
+ * seed, lets them settle, then runs a fixed number of world ticks and writes
+ * the Map::Update phase timings of every map as JSON.
+ * Started at server start (PlayerBot.LoadTest.Enable, the server stops when
+ * done) or with .bot loadtest.
+ */
+class PlayerBotLoadTest
+{
+    public:
+        PlayerBotLoadTest();
+
+        void LoadConfig(bool reload);
+        void Update(uint32 diff);
+
+        bool Start(LoadTestProfile profile, uint32 bots, uint32 ticks, uint32 seed, bool stopWorld);
+        void Stop();
+
+        LoadTestState GetState() const { return m_state; }
+        LoadTestProfile GetProfile() const { return m_profile; }
+        uint32 GetTick() const { return m_tick; }
+        uint32 GetTicks() const { return m_ticks; }
+        uint32 GetBotsCount() const { return m_bots.size(); }
+        uint32 GetDefaultBotsCount() const { return m_confBots; }
+        uint32 GetDefaultTicks() const { return m_confTicks; }
+        uint32 GetDefaultSeed() const { return m_confSeed; }
+
+        // Bot AIs helpers
+        ObjectGuid GetBossGuid() const { return m_bossGuid; }
+        ObjectGuid GetBotGuid(uint32 index) const;
+
+        static char const* GetProfileName(LoadTestProfile profile);
+        static bool FindProfile(char const* name, LoadTestProfile& profile);
+
+    private:
+        void SpawnBots();
+        void UpdateBoss();
+        uint32 CountBotsInWorld() const;
+        void BeginMeasure();
+        void WriteReport();
+        void Finish();
+        void EndCleanup();
+
+        LoadTestState m_state;
+        LoadTestProfile m_profile;
+        uint32 m_seed;
+        uint32 m_botsCount;
+        uint32 m_ticks;
+        uint32 m_tick;
+        uint32 m_timer;
+        bool m_stopWorld;
+
+        std::vector<uint32> m_bots;                         // player low guids
+        Map* m_raidMap;
+        ObjectGuid m_bossGuid;
+
+        uint32 m_measureStart;
+        uint64 m_diffTotal;
+        uint32 m_diffMax;
+
+        /* Config */
+        bool m_confEnable;
+        LoadTestProfile m_confProfile;
+        uint32 m_confBots;
+        uint32 m_confTicks;
+        uint32 m_confWarmupTicks;
+        uint32 m_confSeed;
+        uint32 m_confSpawnTimeout;
+        uint32 m_confBossEntry;
+        std::string m_confOutput;
+};
+
+#define sPlayerBotLoadTest MaNGOS::Singleton<PlayerBotLoadTest>::Instance()
+#endif
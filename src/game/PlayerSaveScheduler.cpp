@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2017 Light's Hope <https://lightshope.org>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "PlayerSaveScheduler.h"
+#include "Database/DatabaseEnv.h"
+#include "World.h"
+#include "Policies/SingletonImp.h"
+
+INSTANTIATE_SINGLETON_1(PlayerSaveScheduler);
+
+PlayerSaveScheduler::PlayerSaveScheduler() : m_budget(0), m_credit(0),
+    m_periodicSaves(0), m_forcedSaves(0), m_deferredSaves(0), m_throttledTicks(0)
+{
+}
+
+void PlayerSaveScheduler::Update(uint32 diff)
+{
+    uint32 maxQueueSize = sWorld.getConfig(CONFIG_UINT32_PLAYER_SAVE_MAX_QUEUE_SIZE);
+    if (maxQueueSize && CharacterDatabase.GetDelayQueueSize() > maxQueueSize)
+    {
+        m_budget = 0;
+        m_credit = 0;
+        ++m_throttledTicks;
+        return;
+    }
+
+    uint32 interval = sWorld.getConfig(CONFIG_UINT32_INTERVAL_SAVE);
+    uint32 players = sWorld.GetActiveSessionCount();
+    if (!interval || !players)
+        return;
+
+    // 25% margin over the mean save rate, timers are not perfectly spread
+    m_credit += uint64(players) * diff * 5 / 4;
+    int32 granted = int32(m_credit / interval);
+    m_credit %= interval;
+
+    // unused saves do not add up, a full budget is one second of saves
+    int32 maxBudget = std::max(1, int32(uint64(players) * IN_MILLISECONDS * 5 / 4 / interval));
+    m_budget = std::min(m_budget + granted, maxBudget);
+}
+
+bool PlayerSaveScheduler::RequestPeriodicSave(uint32 waitedMs)
+{
+    if (waitedMs >= sWorld.getConfig(CONFIG_UINT32_INTERVAL_SAVE))
+    {
+        ++m_forcedSaves;
+        return true;
+    }
+
+    int32 budget = m_budget;
+    while (budget > 0)
+    {
+        if (m_budget.compare_exchange_weak(budget, budget - 1))
+        {
+            ++m_periodicSaves;
+            return true;
+        }
+    }
+
+    ++m_deferredSaves;
+    return false;
+}
+
+void PlayerSaveScheduler::GetStats(PlayerSaveSchedulerStats& stats) const
+{
+    stats.periodicSaves = m_periodicSaves;
+    stats.forcedSaves = m_forcedSaves;
+    stats.deferredSaves = m_deferredSaves;
+    stats.throttledTicks = m_throttledTicks;
+    stats.budget = m_budget;
+}
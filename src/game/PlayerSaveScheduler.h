@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2017 Light's Hope <https://lightshope.org>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_PLAYERSAVESCHEDULER_H
+#define MANGOS_PLAYERSAVESCHEDULER_H
+
+#include "Common.h"
+#include "Policies/Singleton.h"
+#include <atomic>
+
+struct PlayerSaveSchedulerStats
+{
+    uint64 periodicSaves;
+    uint64 forcedSaves;                                     // waited a whole save interval
+    uint64 deferredSaves;                                   // retried at a later update
+    uint64 throttledTicks;                                  // world ticks without saves because of the DB queue
+    int32 budget;
+};
+
+/*
+ * Rate limit of the periodic player saves.
+ *
+ * Each world tick allows enough saves to save every online player once per
+ * PlayerSave.Interval (with some margin), so that saves are spread evenly instead
+ * of coming in waves after a mass login. No save is allowed while the character
+ * database async queue is longer than PlayerSave.MaxQueueSize.
+ * A save waiting for more than a save interval is done anyway.
+ * Other saves (logout, trade, mail ...) call Player::SaveToDB directly and are never delayed.
+ */
+class PlayerSaveScheduler
+{
+    public:
+        PlayerSaveScheduler();
+
+        // World thread
+        void Update(uint32 diff);
+
+        // Map threads, when the player save timer expires. False if the save has to be retried later.
+        bool RequestPeriodicSave(uint32 waitedMs);
+
+        void GetStats(PlayerSaveSchedulerStats& stats) const;
+
+    private:
+        std::atomic<int32> m_budget;
+        uint64 m_credit;                                    // players * ms not converted to saves yet
+
+        std::atomic<uint64> m_periodicSaves;
+        std::atomic<uint64> m_forcedSaves;
+        std::atomic<uint64> m_deferredSaves;
+        std::atomic<uint64> m_throttledTicks;
+};
+
+#define sPlayerSaveScheduler MaNGOS::Singleton<PlayerSaveScheduler>::Instance()
+
+#endif
@@ -24,6 +24,7 @@
 #include "Player.h"
 #include "WorldPacket.h"
 #include "ObjectMgr.h"
+#include "Database/SqlBatchInsert.h"
 
 const int32 ReputationMgr::PointsInRank[MAX_REPUTATION_RANK] = {36000, 3000, 3000, 3000, 6000, 12000, 21000, 1000};
 
@@ -434,21 +435,18 @@ void ReputationMgr::LoadFromDB(QueryResult *result)
     }
 }
 
-void ReputationMgr::SaveToDB()
+uint32 ReputationMgr::SaveToDB()
 {
-    static SqlStatementID delRep ;
-    static SqlStatementID insRep ;
-
-    SqlStatement stmtDel = CharacterDatabase.CreateStatement(delRep, "DELETE FROM character_reputation WHERE guid = ? AND faction=?");
-    SqlStatement stmtIns = CharacterDatabase.CreateStatement(insRep, "INSERT INTO character_reputation (guid,faction,standing,flags) VALUES (?, ?, ?, ?)");
+    SqlBatchInsert insert(CharacterDatabase, "INSERT INTO character_reputation (guid,faction,standing,flags) VALUES ",
+                          " ON DUPLICATE KEY UPDATE standing = VALUES(standing), flags = VALUES(flags)");
 
     for (FactionStateList::iterator itr = m_factions.begin(); itr != m_factions.end(); ++itr)
     {
         if (itr->second.needSave)
         {
-            stmtDel.PExecute(m_player->GetGUIDLow(), itr->second.ID);
-            stmtIns.PExecute(m_player->GetGUIDLow(), itr->second.ID, itr->second.Standing, itr->second.Flags);
+            insert.AddRow("(%u, %u, %i, %u)", m_player->GetGUIDLow(), itr->second.ID, itr->second.Standing, uint32(itr->second.Flags));
             itr->second.needSave = false;
         }
     }
+    return insert.Flush();
 }
@@ -63,7 +63,7 @@ class ReputationMgr
         explicit ReputationMgr(Player* owner) : m_player(owner) {}
         ~ReputationMgr() {}
 
-        void SaveToDB();
+        uint32 SaveToDB();                                  // returns saved factions count
         void LoadFromDB(QueryResult *result);
     public:                                                 // statics
         static const int32 PointsInRank[MAX_REPUTATION_RANK];
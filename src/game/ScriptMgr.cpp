@@ -962,6 +962,19 @@ uint32 ScriptMgr::GetScriptId(const char *name) const
     return uint32(itr - m_scriptNames.begin());
 }
 
+uint32 ScriptMgr::GetScriptNamesHash() const
+{
+    // FNV-1a
+    uint32 hash = 2166136261u;
+    for (auto const& name : m_scriptNames)
+    {
+        for (char c : name)
+            hash = (hash ^ uint8(c)) * 16777619u;
+        hash *= 16777619u;                                  // names separator
+    }
+    return hash;
+}
+
 uint32 ScriptMgr::GetAreaTriggerScriptId(uint32 triggerId) const
 {
     AreaTriggerScriptMap::const_iterator itr = m_AreaTriggerScripts.find(triggerId);
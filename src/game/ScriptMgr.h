@@ -792,6 +792,7 @@ class ScriptMgr
         const char* GetScriptName(uint32 id) const { return id < m_scriptNames.size() ? m_scriptNames[id].c_str() : ""; }
         uint32 GetScriptId(const char *name) const;
         uint32 GetScriptIdsCount() const { return m_scriptNames.size(); }
+        uint32 GetScriptNamesHash() const;
         
         void Initialize();
         void LoadDatabase();
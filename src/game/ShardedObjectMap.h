@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2017 Light's Hope <https://lightshope.org>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_SHARDEDOBJECTMAP_H
+#define MANGOS_SHARDEDOBJECTMAP_H
+
+#include "Platform/Define.h"
+#include "Utilities/UnorderedMapSet.h"
+#include <shared_mutex>
+#include <mutex>
+#include <vector>
+
+/*
+ * Key -> T* hash map split in independently locked shards.
+ *
+ * Object lookups come from every map update thread and every network thread
+ * at once, so a single lock over the whole container serializes them all on
+ * the same cache line. Each shard here has its own reader/writer lock and sits
+ * on its own cache line: lookups only contend when they hash to the same
+ * shard, and inserts/removes only block that shard.
+ *
+ * There is no iterator: GetAll copies the values shard after shard, nothing
+ * is locked once it returns. As before, callers must not keep pointers across
+ * a world update.
+ */
+template <class Key, class T, class Hash = std::hash<Key> >
+class ShardedObjectMap
+{
+    public:
+        static uint32 const SHARD_COUNT = 16;           // power of 2
+
+        void Insert(Key const& key, T* obj)
+        {
+            Shard& shard = GetShard(key);
+            std::unique_lock<std::shared_timed_mutex> guard(shard.lock);
+            shard.objects[key] = obj;
+        }
+
+        void Remove(Key const& key)
+        {
+            Shard& shard = GetShard(key);
+            std::unique_lock<std::shared_timed_mutex> guard(shard.lock);
+            shard.objects.erase(key);
+        }
+
+        T* Find(Key const& key) const
+        {
+            Shard const& shard = GetShard(key);
+            std::shared_lock<std::shared_timed_mutex> guard(shard.lock);
+            typename MapType::const_iterator itr = shard.objects.find(key);
+            return itr != shard.objects.end() ? itr->second : nullptr;
+        }
+
+        void GetAll(std::vector<T*>& objects) const
+        {
+            for (Shard const& shard : m_shards)
+            {
+                std::shared_lock<std::shared_timed_mutex> guard(shard.lock);
+                for (typename MapType::const_iterator itr = shard.objects.begin(); itr != shard.objects.end(); ++itr)
+                    objects.push_back(itr->second);
+            }
+        }
+
+        // Not a snapshot, shards are counted one after the other
+        uint32 Size() const
+        {
+            uint32 count = 0;
+            for (Shard const& shard : m_shards)
+            {
+                std::shared_lock<std::shared_timed_mutex> guard(shard.lock);
+                count += shard.objects.size();
+            }
+            return count;
+        }
+
+    private:
+        typedef UNORDERED_MAP<Key, T*, Hash> MapType;
+
+        struct alignas(64) Shard
+        {
+            mutable std::shared_timed_mutex lock;
+            MapType objects;
+        };
+
+        Shard& GetShard(Key const& key) { return m_shards[ShardIndex(key)]; }
+        Shard const& GetShard(Key const& key) const { return m_shards[ShardIndex(key)]; }
+
+        static uint32 ShardIndex(Key const& key)
+        {
+            // Low guid counters are sequential, mix the upper bits in too
+            size_t h = Hash()(key);
+            h ^= h >> 16;
+            return uint32(h * 0x9E3779B1u >> 8) & (SHARD_COUNT - 1);
+        }
+
+        Shard m_shards[SHARD_COUNT];
+};
+
+#endif
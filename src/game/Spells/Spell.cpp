@@ -346,6 +346,8 @@ Spell::Spell(Unit* caster, SpellEntry const *info, bool triggered, ObjectGuid or
     CleanupTargetList();
 }
 
+DEFINE_POOLED_ALLOCATOR(Spell)
+
 Spell::~Spell()
 {
     m_destroyed = true;
@@ -30,6 +30,7 @@
 #include "LootMgr.h"
 #include "Unit.h"
 #include "Player.h"
+#include "Utilities/ObjectPool.h"
 
 #ifdef USE_STANDARD_MALLOC
 #include <vector>
@@ -328,6 +329,8 @@ class Spell
         Spell(Unit* caster, SpellEntry const *info, bool triggered, ObjectGuid originalCasterGUID = ObjectGuid(), SpellEntry const* triggeredBy = NULL, Unit* victim = NULL, SpellEntry const* triggeredByParent = NULL);
         ~Spell();
 
+        DECLARE_POOLED_ALLOCATOR(Spell);
+
         void prepare(SpellCastTargets targets, Aura* triggeredByAura = nullptr);
         void prepare(Aura* triggeredByAura = nullptr);
 
@@ -384,6 +384,8 @@ bool SpellAuraHolder::IsMoreImportantDebuffThan(SpellAuraHolder* other) const
     return m_debuffLimitScore > other->m_debuffLimitScore;
 }
 
+DEFINE_POOLED_ALLOCATOR(Aura)
+
 Aura::~Aura()
 {
 }
@@ -6475,6 +6477,8 @@ void Aura::HandleAuraSafeFall(bool Apply, bool Real)
     // implemented in WorldSession::HandleMovementOpcodes
 }
 
+DEFINE_POOLED_ALLOCATOR(SpellAuraHolder)
+
 SpellAuraHolder::~SpellAuraHolder()
 {
     // note: auras in delete list won't be affected since they clear themselves from holder when adding to deletedAuraslist
@@ -25,6 +25,7 @@
 #include "SpellAuraDefines.h"
 #include "DBCEnums.h"
 #include "ObjectGuid.h"
+#include "Utilities/ObjectPool.h"
 
 struct Modifier
 {
@@ -200,6 +201,8 @@ class MANGOS_DLL_SPEC SpellAuraHolder
         bool IsTriggered() const { return m_spellTriggered; }
 
         ~SpellAuraHolder();
+
+        DECLARE_POOLED_ALLOCATOR(SpellAuraHolder);
     private:
         void UpdateAuraApplication();                       // called at charges or stack changes
 
@@ -393,6 +396,8 @@ class MANGOS_DLL_SPEC Aura
 
         virtual ~Aura();
 
+        DECLARE_POOLED_ALLOCATOR(Aura);
+
         void SetModifier(AuraType t, int32 a, uint32 pt, int32 miscValue);
         Modifier*       GetModifier()       { return &m_modifier; }
         Modifier const* GetModifier() const { return &m_modifier; }
@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2017 Light's Hope <https://lightshope.org>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "StartupLoader.h"
+#include "Database/DatabaseEnv.h"
+#include "Log.h"
+#include "ProgressBar.h"
+
+#include <chrono>
+#include <thread>
+
+void StartupLoader::Add(char const* name, Task const& task, std::initializer_list<char const*> dependencies)
+{
+    uint32 index = m_entries.size();
+    m_entries.push_back(Entry());
+    Entry& entry = m_entries.back();
+    entry.name = name;
+    entry.task = task;
+    entry.pendingDependencies = 0;
+    entry.durationMs = 0;
+
+    for (char const* dependency : dependencies)
+    {
+        bool found = false;
+        for (uint32 i = 0; i < index; ++i)
+        {
+            if (m_entries[i].name == dependency)
+            {
+                m_entries[i].dependents.push_back(index);
+                ++entry.pendingDependencies;
+                found = true;
+                break;
+            }
+        }
+        MANGOS_ASSERT(found && "StartupLoader: dependency must be added before");
+    }
+}
+
+void StartupLoader::RunEntry(Entry& entry)
+{
+    auto begin = std::chrono::steady_clock::now();
+    entry.task();
+    entry.durationMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - begin).count();
+}
+
+void StartupLoader::Run(uint32 threads)
+{
+    if (threads <= 1)
+    {
+        for (auto& entry : m_entries)
+            RunEntry(entry);
+        return;
+    }
+
+    for (uint32 i = 0; i < m_entries.size(); ++i)
+        if (!m_entries[i].pendingDependencies)
+            m_ready.push_back(i);
+
+    // bars of concurrent loaders would overwrite each other
+    bool showBars = BarGoLink::GetOutputState();
+    BarGoLink::SetOutputState(false);
+
+    std::vector<std::thread> workers;
+    for (uint32 i = 1; i < threads; ++i)
+    {
+        workers.emplace_back([this]()
+        {
+            // Each loader thread queries on its own connection, the pool is sized for the world thread
+            WorldDatabase.ThreadStart();
+            if (!WorldDatabase.OpenThreadConnection())
+                sLog.outError("StartupLoader: unable to open a world database connection, sharing the pool.");
+            Work();
+            WorldDatabase.CloseThreadConnection();
+            WorldDatabase.ThreadEnd();
+        });
+    }
+    Work();
+
+    for (auto& worker : workers)
+        worker.join();
+
+    BarGoLink::SetOutputState(showBars);
+}
+
+void StartupLoader::Work()
+{
+    std::unique_lock<std::mutex> lock(m_lock);
+    while (true)
+    {
+        m_taskReady.wait(lock, [this]() { return !m_ready.empty() || m_finished == m_entries.size(); });
+        if (m_ready.empty())
+            return;
+
+        uint32 index = m_ready.front();
+        m_ready.pop_front();
+
+        lock.unlock();
+        RunEntry(m_entries[index]);
+        lock.lock();
+
+        ++m_finished;
+        for (uint32 dependent : m_entries[index].dependents)
+            if (!--m_entries[dependent].pendingDependencies)
+                m_ready.push_back(dependent);
+
+        m_taskReady.notify_all();
+    }
+}
+
+void StartupLoader::PrintTimings() const
+{
+    std::vector<Entry const*> sorted;
+    uint32 totalMs = 0;
+    for (auto& entry : m_entries)
+    {
+        sorted.push_back(&entry);
+        totalMs += entry.durationMs;
+    }
+    std::stable_sort(sorted.begin(), sorted.end(), [](Entry const* a, Entry const* b) { return a->durationMs > b->durationMs; });
+
+    sLog.outString("Loaders timings (%u ms in total):", totalMs);
+    for (Entry const* entry : sorted)
+        sLog.outString("%8u ms  %s", entry->durationMs, entry->name.c_str());
+    sLog.outString();
+}
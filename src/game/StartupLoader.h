@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2017 Light's Hope <https://lightshope.org>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_STARTUPLOADER_H
+#define MANGOS_STARTUPLOADER_H
+
+#include "Common.h"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+
+/*
+ * Startup data loaders as a dependency graph.
+ *
+ * A task only depends on tasks added before it, so the declaration order is
+ * always a valid sequential order (used with a single thread). With more threads
+ * a task starts as soon as all its dependencies are done. Tasks writing the same
+ * data (eg. quests flags) must depend on each other, even if the order does not matter.
+ */
+class StartupLoader
+{
+    public:
+        typedef std::function<void()> Task;
+
+        StartupLoader() : m_finished(0) {}
+
+        void Add(char const* name, Task const& task, std::initializer_list<char const*> dependencies = {});
+
+        // Blocks until every task is done. threads <= 1 runs them in the calling thread.
+        void Run(uint32 threads);
+
+        // Loaders sorted by time taken
+        void PrintTimings() const;
+
+    private:
+        struct Entry
+        {
+            std::string name;
+            Task task;
+            std::vector<uint32> dependents;
+            uint32 pendingDependencies;
+            uint32 durationMs;
+        };
+
+        void RunEntry(Entry& entry);
+        void Work();
+
+        std::vector<Entry> m_entries;
+
+        std::mutex m_lock;
+        std::condition_variable m_taskReady;
+        std::deque<uint32> m_ready;
+        uint32 m_finished;
+};
+
+#endif
@@ -68,6 +68,8 @@ HostileReference::HostileReference(Unit* pUnit, ThreatManager *pThreatManager, f
     iUnitGuid = pUnit->GetObjectGuid();
     iOnline = true;
     iAccessible = true;
+    iSortedThreat = pThreat;
+    iResortPending = false;
 }
 
 //============================================================
@@ -198,6 +200,11 @@ Unit* HostileReference::getSourceUnit()
     return (getSource()->getOwner());
 }
 
+bool ThreatRefOrder::operator()(HostileReference const* lhs, HostileReference const* rhs) const
+{
+    return lhs->iSortedThreat > rhs->iSortedThreat;         // reverse sorting
+}
+
 //============================================================
 //================ ThreatContainer ===========================
 //============================================================
@@ -210,6 +217,69 @@ void ThreatContainer::clearReferences()
         delete(*i);
     }
     iThreatList.clear();
+    iThreatIndex.clear();
+    iRefsByTarget.clear();
+    iResortQueue.clear();
+}
+
+//============================================================
+
+void ThreatContainer::place(HostileReference* pRef, bool pNewNode)
+{
+    // equal threats keep their order: the reference goes after the ones already there
+    pRef->iIndexPosition = iThreatIndex.insert(pRef);
+
+    ThreatRefIndex::iterator next = pRef->iIndexPosition;
+    ++next;
+    ThreatList::iterator listNext = next == iThreatIndex.end() ? iThreatList.end() : (*next)->iListPosition;
+
+    // splice keeps the node, so iterators held by callers walking the list stay valid
+    if (pNewNode)
+        pRef->iListPosition = iThreatList.insert(listNext, pRef);
+    else if (listNext != pRef->iListPosition)
+        iThreatList.splice(listNext, iThreatList, pRef->iListPosition);
+}
+
+//============================================================
+
+void ThreatContainer::addReference(HostileReference* pHostileReference)
+{
+    if (!iRefsByTarget.insert(std::make_pair(pHostileReference->getUnitGuid(), pHostileReference)).second)
+        return;
+
+    pHostileReference->iSortedThreat = pHostileReference->getThreat();
+    pHostileReference->iResortPending = false;
+    place(pHostileReference, true);
+}
+
+//============================================================
+
+void ThreatContainer::remove(HostileReference* pRef)
+{
+    UNORDERED_MAP<ObjectGuid, HostileReference*>::iterator itr = iRefsByTarget.find(pRef->getUnitGuid());
+    if (itr == iRefsByTarget.end() || itr->second != pRef)
+        return;
+
+    iRefsByTarget.erase(itr);
+    iThreatIndex.erase(pRef->iIndexPosition);
+    iThreatList.erase(pRef->iListPosition);
+
+    if (pRef->iResortPending)
+    {
+        iResortQueue.erase(std::find(iResortQueue.begin(), iResortQueue.end(), pRef));
+        pRef->iResortPending = false;
+    }
+}
+
+//============================================================
+
+void ThreatContainer::threatChanged(HostileReference* pRef)
+{
+    if (pRef->iResortPending)
+        return;
+
+    pRef->iResortPending = true;
+    iResortQueue.push_back(pRef);
 }
 
 //============================================================
@@ -219,18 +289,8 @@ HostileReference* ThreatContainer::getReferenceByTarget(Unit* pVictim)
     if (!pVictim)
         return nullptr;
 
-    HostileReference* result = nullptr;
-    ObjectGuid guid = pVictim->GetObjectGuid();
-    for (ThreatList::const_iterator i = iThreatList.begin(); i != iThreatList.end(); ++i)
-    {
-        if ((*i)->getUnitGuid() == guid)
-        {
-            result = (*i);
-            break;
-        }
-    }
-
-    return result;
+    UNORDERED_MAP<ObjectGuid, HostileReference*>::const_iterator itr = iRefsByTarget.find(pVictim->GetObjectGuid());
+    return itr != iRefsByTarget.end() ? itr->second : nullptr;
 }
 
 //============================================================
@@ -264,21 +324,22 @@ void ThreatContainer::modifyThreatPercent(Unit *pVictim, int32 pPercent)
 }
 
 //============================================================
-
-bool HostileReferenceSortPredicate(const HostileReference* lhs, const HostileReference* rhs)
-{
-    // std::list::sort ordering predicate must be: (Pred(x,y)&&Pred(y,x))==false
-    return lhs->getThreat() > rhs->getThreat();             // reverse sorting
-}
-
-//============================================================
-// Check if the list is dirty and sort if necessary
+// Move the references whose threat changed since the last update, the others are still in order
 
 void ThreatContainer::update()
 {
-    if (iDirty && iThreatList.size() > 1)
-        iThreatList.sort(HostileReferenceSortPredicate);
-    iDirty = false;
+    for (std::vector<HostileReference*>::const_iterator itr = iResortQueue.begin(); itr != iResortQueue.end(); ++itr)
+    {
+        HostileReference* ref = *itr;
+        ref->iResortPending = false;
+        if (ref->iSortedThreat == ref->getThreat())
+            continue;
+
+        iThreatIndex.erase(ref->iIndexPosition);
+        ref->iSortedThreat = ref->getThreat();
+        place(ref, false);
+    }
+    iResortQueue.clear();
 }
 
 //============================================================
@@ -513,35 +574,29 @@ void ThreatManager::processThreatEvent(ThreatRefStatusChangeEvent* threatRefStat
     switch (threatRefStatusChangeEvent->getType())
     {
         case UEV_THREAT_REF_THREAT_CHANGE:
-            if ((getCurrentVictim() == hostileReference && threatRefStatusChangeEvent->getFValue() < 0.0f) ||
-                    (getCurrentVictim() != hostileReference && threatRefStatusChangeEvent->getFValue() > 0.0f))
-                setDirty(true);                             // the order in the threat list might have changed
+            // the order in the threat list might have changed
+            if (hostileReference->isOnline())
+                iThreatContainer.threatChanged(hostileReference);
+            else
+                iThreatOfflineContainer.threatChanged(hostileReference);
             break;
         case UEV_THREAT_REF_ONLINE_STATUS:
             if (!hostileReference->isOnline())
             {
                 if (hostileReference == getCurrentVictim())
-                {
                     setCurrentVictim(nullptr);
-                    setDirty(true);
-                }
                 iThreatContainer.remove(hostileReference);
                 iThreatOfflineContainer.addReference(hostileReference);
             }
             else
             {
-                if (getCurrentVictim() && hostileReference->getThreat() > (1.1f * getCurrentVictim()->getThreat()))
-                    setDirty(true);
-                iThreatContainer.addReference(hostileReference);
                 iThreatOfflineContainer.remove(hostileReference);
+                iThreatContainer.addReference(hostileReference);
             }
             break;
         case UEV_THREAT_REF_REMOVE_FROM_LIST:
             if (hostileReference == getCurrentVictim())
-            {
                 setCurrentVictim(nullptr);
-                setDirty(true);
-            }
             if (hostileReference->isOnline())
                 iThreatContainer.remove(hostileReference);
             else
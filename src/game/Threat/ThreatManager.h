@@ -28,6 +28,8 @@
 #include "UnitEvents.h"
 #include "ObjectGuid.h"
 #include <list>
+#include <set>
+#include <vector>
 
 //==============================================================
 
@@ -35,6 +37,17 @@ class Unit;
 class Creature;
 class ThreatManager;
 class SpellEntry;
+class HostileReference;
+
+typedef std::list<HostileReference*> ThreatList;
+
+// Orders references by the threat they were last sorted with, highest first
+struct ThreatRefOrder
+{
+    bool operator()(HostileReference const* lhs, HostileReference const* rhs) const;
+};
+
+typedef std::multiset<HostileReference*, ThreatRefOrder> ThreatRefIndex;
 
 //==============================================================
 // Class to calculate the real threat based
@@ -120,6 +133,9 @@ class MANGOS_DLL_SPEC HostileReference : public Reference<Unit, ThreatManager>
         // Tell our refFrom (source) object, that the link is cut (Target destroyed)
         void sourceObjectDestroyLink() override;
     private:
+        friend class ThreatContainer;
+        friend struct ThreatRefOrder;
+
         // Inform the source, that the status of that reference was changed
         void fireStatusChanged(ThreatRefStatusChangeEvent& pThreatRefStatusChangeEvent);
 
@@ -129,27 +145,37 @@ class MANGOS_DLL_SPEC HostileReference : public Reference<Unit, ThreatManager>
         ObjectGuid iUnitGuid;
         bool iOnline;
         bool iAccessible;
+
+        // position in the container holding the reference, only valid while it is in one
+        ThreatList::iterator iListPosition;
+        ThreatRefIndex::iterator iIndexPosition;
+        float iSortedThreat;                                // threat value the reference is sorted with
+        bool iResortPending;                                // threat changed since the last container update
 };
 
 //==============================================================
-class ThreatManager;
-
-typedef std::list<HostileReference*> ThreatList;
 
 class MANGOS_DLL_SPEC ThreatContainer
 {
-    ThreatList iThreatList;
-    bool iDirty;
+    ThreatList iThreatList;                                 // sorted by threat, at each update()
+    ThreatRefIndex iThreatIndex;                            // same order, finds the list position of a new threat value
+    UNORDERED_MAP<ObjectGuid, HostileReference*> iRefsByTarget;
+    std::vector<HostileReference*> iResortQueue;            // references whose threat changed since the last update()
+
+    // Insert the reference at its sorted position, or move its list node there
+    void place(HostileReference* pRef, bool pNewNode);
 protected:
     friend class ThreatManager;
 
-    void remove(HostileReference* pRef) { iThreatList.remove(pRef); }
-    void addReference(HostileReference* pHostileReference) { iThreatList.push_back(pHostileReference); }
+    void remove(HostileReference* pRef);
+    void addReference(HostileReference* pHostileReference);
     void clearReferences();
-    // Sort the list if necessary
+    // Queue the reference to be moved to its new place at the next update
+    void threatChanged(HostileReference* pRef);
+    // Move the references whose threat changed to their place in the list
     void update();
 public:
-    ThreatContainer() { iDirty = false; }
+    ThreatContainer() {}
     ~ThreatContainer() { clearReferences(); }
 
     HostileReference* addThreat(Unit* pVictim, float pThreat);
@@ -158,10 +184,6 @@ public:
 
     HostileReference* selectNextVictim(Creature* pAttacker, HostileReference* pCurrentVictim);
 
-    void setDirty(bool pDirty) { iDirty = pDirty; }
-
-    bool isDirty() const { return iDirty; }
-
     bool empty() const { return(iThreatList.empty()); }
 
     HostileReference* getMostHated() { return iThreatList.empty() ? NULL : iThreatList.front(); }
@@ -210,8 +232,6 @@ public:
 
     void setCurrentVictim(HostileReference* pHostileReference);
 
-    void setDirty(bool pDirty) { iThreatContainer.setDirty(pDirty); }
-
     // Don't must be used for explicit modify threat values in iterator return pointers
     ThreatList const& getThreatList() const { return iThreatContainer.getThreatList(); }
 private:
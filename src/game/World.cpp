@@ -70,6 +70,7 @@
 #include "AutoTesting/AutoTestingMgr.h"
 #include "Transports/TransportMgr.h"
 #include "PlayerBotMgr.h"
+#include "PlayerBotLoadTest.h"
 #include "ProgressBar.h"
 #include "ZoneScriptMgr.h"
 #include "CharacterDatabaseCache.h"
@@ -83,6 +84,8 @@
 #include "Anticheat/Anticheat.h"
 #include "AuraRemovalMgr.h"
 #include "InstanceStatistics.h"
+#include "StartupLoader.h"
+#include "PlayerSaveScheduler.h"
 
 #include <chrono>
 
@@ -570,11 +573,13 @@ void World::LoadConfigSettings(bool reload)
 
     ///- Read other configuration items from the config file
     setConfigMinMax(CONFIG_UINT32_COMPRESSION, "Compression", 1, 1, 9);
+    setConfigMinMax(CONFIG_UINT32_COMPRESSION_STRATEGY, "Compression.Strategy", 0, 0, 3);
     setConfig(CONFIG_BOOL_ADDON_CHANNEL, "AddonChannel", true);
     setConfig(CONFIG_BOOL_CLEAN_CHARACTER_DB, "CleanCharacterDB", true);
     setConfig(CONFIG_BOOL_GRID_UNLOAD, "GridUnload", true);
     setConfig(CONFIG_BOOL_CLEANUP_TERRAIN, "CleanupTerrain", true);
     setConfigPos(CONFIG_UINT32_INTERVAL_SAVE, "PlayerSave.Interval", 15 * MINUTE * IN_MILLISECONDS);
+    setConfig(CONFIG_UINT32_PLAYER_SAVE_MAX_QUEUE_SIZE, "PlayerSave.MaxQueueSize", 0);
     setConfigMinMax(CONFIG_UINT32_MIN_LEVEL_STAT_SAVE, "PlayerSave.Stats.MinLevel", 0, 0, MAX_LEVEL);
     setConfig(CONFIG_BOOL_STATS_SAVE_ONLY_ON_LOGOUT, "PlayerSave.Stats.SaveOnlyOnLogout", true);
 
@@ -884,6 +889,9 @@ void World::LoadConfigSettings(bool reload)
         sLog.outString("Using DataDir %s", m_dataPath.c_str());
     }
 
+    SQLStorageBase::SetSnapshotDirectory(sConfig.GetStringDefault("WorldDatabase.SnapshotDir", ""),
+                                         sConfig.GetIntDefault("WorldDatabase.SnapshotKey", 0) == 1 ? SNAPSHOT_KEY_CHECKSUM : SNAPSHOT_KEY_VERSION);
+
     setConfig(CONFIG_BOOL_VMAP_INDOOR_CHECK, "vmap.enableIndoorCheck", true);
     bool enableLOS = sConfig.GetBoolDefault("vmap.enableLOS", false);
     bool enableHeight = sConfig.GetBoolDefault("vmap.enableHeight", false);
@@ -938,6 +946,7 @@ void World::LoadNostalriusConfig(bool reload)
 
     // Bots
     sPlayerBotMgr.LoadConfig();
+    sPlayerBotLoadTest.LoadConfig(reload);
 
     m_configNostalrius[CONFIG_PHASE_MAIL]                 = sConfig.GetIntDefault("Phase.Allow.Mail",      0);
     m_configNostalrius[CONFIG_PHASE_ITEM]                 = sConfig.GetIntDefault("Phase.Allow.Item",      0);
@@ -989,9 +998,14 @@ void World::LoadNostalriusConfig(bool reload)
     setConfig(CONFIG_UINT32_PERFLOG_SLOW_MAP_PACKETS,           "PerformanceLog.SlowMapPackets", 60);
     setConfig(CONFIG_UINT32_PERFLOG_SLOW_SESSIONS_UPDATE,       "PerformanceLog.SlowSessionsUpdate", 0);
     setConfig(CONFIG_UINT32_PERFLOG_SLOW_PACKET_BCAST,          "PerformanceLog.SlowPacketBroadcast", 0);
-    setConfig(CONFIG_UINT32_CONTINENTS_MOTIONUPDATE_THREADS,                "Continents.MotionUpdate.Threads", 0);
+    setConfigMinMax(CONFIG_UINT32_CONTINENTS_MOTIONUPDATE_THREADS,          "Continents.MotionUpdate.Threads", 0, 0, 20);
+    setConfigMinMax(CONFIG_UINT32_INSTANCES_MOTIONUPDATE_THREADS,           "Instances.MotionUpdate.Threads", 0, 0, 20);
     setConfig(CONFIG_BOOL_TERRAIN_PRELOAD_CONTINENTS,                   "Terrain.Preload.Continents", 1);
     setConfig(CONFIG_BOOL_TERRAIN_PRELOAD_INSTANCES,                    "Terrain.Preload.Instances", 1);
+    setConfig(CONFIG_BOOL_TERRAIN_MMAP,                                 "Terrain.MMap", 0);
+    setConfig(CONFIG_BOOL_GRID_PREFETCH,                                "GridPrefetch.Enable", 0);
+    setConfigMinMax(CONFIG_UINT32_GRID_PREFETCH_LOOKAHEAD,              "GridPrefetch.Lookahead", 10000, 1000, 60000);
+    setConfigMinMax(CONFIG_UINT32_GRID_PREFETCH_GRIDS_PER_TICK,         "GridPrefetch.GridsPerTick", 1, 1, 16);
     setConfig(CONFIG_UINT32_LOG_MONEY_TRADES_TRESHOLD,                  "LogMoneyTreshold", 10000);
     setConfig(CONFIG_FLOAT_DYN_RESPAWN_CHECK_RANGE,                     "DynamicRespawn.Range", -1.0f);
     setConfig(CONFIG_FLOAT_DYN_RESPAWN_MAX_REDUCTION_RATE,              "DynamicRespawn.MaxReductionRate", 0.0f);
@@ -1035,6 +1049,7 @@ void World::LoadNostalriusConfig(bool reload)
     setConfig(CONFIG_UINT32_AV_MIN_PLAYERS_IN_QUEUE,                    "Alterac.MinPlayersInQueue", 0);
     setConfig(CONFIG_UINT32_AV_INITIAL_MAX_PLAYERS,                     "Alterac.InitMaxPlayers", 0);
     setConfigMinMax(CONFIG_UINT32_ASYNC_TASKS_THREADS_COUNT,            "AsyncTasks.Threads", 1, 1, 20);
+    setConfigMinMax(CONFIG_UINT32_STARTUP_LOADER_THREADS,               "Startup.LoaderThreads", 0, 0, 16);
     setConfig(CONFIG_UINT32_CORPSES_UPDATE_MINUTES,                     "Corpses.UpdateMinutes", 20);
     setConfig(CONFIG_UINT32_BONES_EXPIRE_MINUTES,                       "Bones.ExpireMinutes", 60);
     setConfig(CONFIG_BOOL_CONTINENTS_INSTANCIATE,                       "Continents.Instanciate", false);
@@ -1232,272 +1247,454 @@ void World::SetInitialWorldSettings()
     sObjectMgr.SetHighestGuids();                           // must be after packing instances
     sLog.outString();
 
-    sLog.outString("Loading Broadcast Texts...");
-    sObjectMgr.LoadBroadcastTexts();
-
-    sLog.outString("Loading Page Texts...");
-    sObjectMgr.LoadPageTexts();
+    ///- Optional text/binary result sets measure, before the loaders below share the world database connections
+    if (sConfig.GetBoolDefault("WorldDatabase.LoadBenchmark", false))
+        sObjectMgr.CompareSpawnLoadModes();
 
-    sLog.outString("Loading Game Object Templates...");     // must be after LoadPageTexts
-    sObjectMgr.LoadGameobjectInfo();
+    ///- Static data loaders. Each one only runs once the loaders it needs are done,
+    ///- and Startup.LoaderThreads of them can run at the same time.
+    StartupLoader loader;
 
-    if (!isMapServer)
+    loader.Add("BroadcastTexts", []()
     {
-        sLog.outString("Loading Transport templates...");
-        sTransportMgr->LoadTransportTemplates();
-    }
-
-    sLog.outString("Loading Spell Chain Data...");
-    sSpellMgr.LoadSpellChains();
-
-    sLog.outString("Loading Spell Elixir types...");
-    sSpellMgr.LoadSpellElixirs();
+        sLog.outString("Loading Broadcast Texts...");
+        sObjectMgr.LoadBroadcastTexts();
+    });
 
-    sLog.outString("Loading Spell Facing Flags...");
-    sSpellMgr.LoadFacingCasterFlags();
-
-    sLog.outString("Loading Spell Learn Skills...");
-    sSpellMgr.LoadSpellLearnSkills();                       // must be after LoadSpellChains
-
-    sLog.outString("Loading Spell Learn Spells...");
-    sSpellMgr.LoadSpellLearnSpells();
+    loader.Add("PageTexts", []()
+    {
+        sLog.outString("Loading Page Texts...");
+        sObjectMgr.LoadPageTexts();
+    });
 
-    sLog.outString("Loading Spell Proc Event conditions...");
-    sSpellMgr.LoadSpellProcEvents();
+    loader.Add("GameobjectInfo", []()
+    {
+        sLog.outString("Loading Game Object Templates...");
+        sObjectMgr.LoadGameobjectInfo();
+    }, { "PageTexts" });
 
-    sLog.outString("Loading Spell Bonus Data...");
-    sSpellMgr.LoadSpellBonuses();
+    if (!isMapServer)
+    {
+        loader.Add("TransportTemplates", []()
+        {
+            sLog.outString("Loading Transport templates...");
+            sTransportMgr->LoadTransportTemplates();
+        }, { "GameobjectInfo" });
+    }
 
-    sLog.outString("Loading Spell Proc Item Enchant...");
-    sSpellMgr.LoadSpellProcItemEnchant();                   // must be after LoadSpellChains
+    // SpellMgr loaders share a lot of containers, keep them in a single chain
+    loader.Add("SpellChains", []()
+    {
+        sLog.outString("Loading Spell Chain Data...");
+        sSpellMgr.LoadSpellChains();
+    });
 
-    sLog.outString("Loading Aggro Spells Definitions...");
-    sSpellMgr.LoadSpellThreats();
+    loader.Add("SpellElixirs", []()
+    {
+        sLog.outString("Loading Spell Elixir types...");
+        sSpellMgr.LoadSpellElixirs();
+    }, { "SpellChains" });
 
-    sLog.outString("Loading NPC Texts...");
-    sObjectMgr.LoadNPCText();
+    loader.Add("SpellFacingFlags", []()
+    {
+        sLog.outString("Loading Spell Facing Flags...");
+        sSpellMgr.LoadFacingCasterFlags();
+    }, { "SpellElixirs" });
 
-    sLog.outString("Loading Item Random Enchantments Table...");
-    LoadRandomEnchantmentsTable();
+    loader.Add("SpellLearnSkills", []()
+    {
+        sLog.outString("Loading Spell Learn Skills...");
+        sSpellMgr.LoadSpellLearnSkills();
+    }, { "SpellFacingFlags" });
 
-    sLog.outString("Loading Items...");                     // must be after LoadRandomEnchantmentsTable and LoadPageTexts
-    sObjectMgr.LoadItemPrototypes();
+    loader.Add("SpellLearnSpells", []()
+    {
+        sLog.outString("Loading Spell Learn Spells...");
+        sSpellMgr.LoadSpellLearnSpells();
+    }, { "SpellLearnSkills" });
 
-    sLog.outString("Loading Item Texts...");
-    sObjectMgr.LoadItemTexts();
+    loader.Add("SpellProcEvents", []()
+    {
+        sLog.outString("Loading Spell Proc Event conditions...");
+        sSpellMgr.LoadSpellProcEvents();
+    }, { "SpellLearnSpells" });
 
-    sLog.outString("Loading Creature Model Based Info Data...");
-    sObjectMgr.LoadCreatureModelInfo();
+    loader.Add("SpellBonuses", []()
+    {
+        sLog.outString("Loading Spell Bonus Data...");
+        sSpellMgr.LoadSpellBonuses();
+    }, { "SpellProcEvents" });
 
-    sLog.outString("Loading Equipment templates...");
-    sObjectMgr.LoadEquipmentTemplates();
+    loader.Add("SpellProcItemEnchant", []()
+    {
+        sLog.outString("Loading Spell Proc Item Enchant...");
+        sSpellMgr.LoadSpellProcItemEnchant();
+    }, { "SpellBonuses" });
 
-    sLog.outString("Loading Creature spells...");
-    sObjectMgr.LoadCreatureSpells();
+    loader.Add("SpellThreats", []()
+    {
+        sLog.outString("Loading Aggro Spells Definitions...");
+        sSpellMgr.LoadSpellThreats();
+    }, { "SpellProcItemEnchant" });
 
-    sLog.outString("Loading Creature templates...");
-    sObjectMgr.LoadCreatureTemplates();
+    loader.Add("NPCText", []()
+    {
+        sLog.outString("Loading NPC Texts...");
+        sObjectMgr.LoadNPCText();
+    }, { "BroadcastTexts" });
 
-    sLog.outString("Loading SpellsScriptTarget...");
-    sSpellMgr.LoadSpellScriptTarget();                      // must be after LoadCreatureTemplates and LoadGameobjectInfo
+    loader.Add("RandomEnchantments", []()
+    {
+        sLog.outString("Loading Item Random Enchantments Table...");
+        LoadRandomEnchantmentsTable();
+    });
 
-    sLog.outString("Loading ItemRequiredTarget...");
-    sObjectMgr.LoadItemRequiredTarget();
+    loader.Add("ItemPrototypes", []()
+    {
+        sLog.outString("Loading Items...");
+        sObjectMgr.LoadItemPrototypes();
+    }, { "RandomEnchantments", "PageTexts" });
 
-    sLog.outString("Loading Reputation Reward Rates...");
-    sObjectMgr.LoadReputationRewardRate();
+    loader.Add("ItemTexts", []()
+    {
+        sLog.outString("Loading Item Texts...");
+        sObjectMgr.LoadItemTexts();
+    });
 
-    sLog.outString("Loading Creature Reputation OnKill Data...");
-    sObjectMgr.LoadReputationOnKill();
+    loader.Add("CreatureModelInfo", []()
+    {
+        sLog.outString("Loading Creature Model Based Info Data...");
+        sObjectMgr.LoadCreatureModelInfo();
+    });
 
-    sLog.outString("Loading Reputation Spillover Data...");
-    sObjectMgr.LoadReputationSpilloverTemplate();
+    loader.Add("EquipmentTemplates", []()
+    {
+        sLog.outString("Loading Equipment templates...");
+        sObjectMgr.LoadEquipmentTemplates();
+    }, { "ItemPrototypes" });
 
-    sLog.outString("Loading Points Of Interest Data...");
-    sObjectMgr.LoadPointsOfInterest();
+    loader.Add("CreatureSpells", []()
+    {
+        sLog.outString("Loading Creature spells...");
+        sObjectMgr.LoadCreatureSpells();
+    }, { "SpellThreats" });
 
-    sLog.outString("Loading Pet Create Spells...");
-    sObjectMgr.LoadPetCreateSpells();
+    loader.Add("CreatureTemplates", []()
+    {
+        sLog.outString("Loading Creature templates...");
+        sObjectMgr.LoadCreatureTemplates();
+    }, { "CreatureModelInfo", "EquipmentTemplates", "CreatureSpells" });
 
-    sLog.outString("Loading Creature Data...");
-    sObjectMgr.LoadCreatures();
+    loader.Add("SpellScriptTarget", []()
+    {
+        sLog.outString("Loading SpellsScriptTarget...");
+        sSpellMgr.LoadSpellScriptTarget();
+    }, { "SpellThreats", "CreatureTemplates", "GameobjectInfo" });
 
-    sLog.outString("Loading Creature Addon Data...");
-    sLog.outString();
-    sObjectMgr.LoadCreatureAddons();                        // must be after LoadCreatureTemplates() and LoadCreatures()
-    sLog.outString(">>> Creature Addon Data loaded");
-    sLog.outString();
+    loader.Add("ItemRequiredTarget", []()
+    {
+        sLog.outString("Loading ItemRequiredTarget...");
+        sObjectMgr.LoadItemRequiredTarget();
+    }, { "ItemPrototypes", "CreatureTemplates", "SpellScriptTarget" });
 
-    sLog.outString("Loading Creature Groups ...");
-    sCreatureGroupsManager->Load();
+    loader.Add("ReputationRewardRate", []()
+    {
+        sLog.outString("Loading Reputation Reward Rates...");
+        sObjectMgr.LoadReputationRewardRate();
+    });
 
-    sLog.outString("Loading Gameobject Data...");
-    sObjectMgr.LoadGameobjects();
+    loader.Add("ReputationOnKill", []()
+    {
+        sLog.outString("Loading Creature Reputation OnKill Data...");
+        sObjectMgr.LoadReputationOnKill();
+    }, { "CreatureTemplates" });
 
-    sLog.outString("Loading Gameobject Requirements...");
-    sObjectMgr.LoadGameobjectsRequirements();
+    loader.Add("ReputationSpillover", []()
+    {
+        sLog.outString("Loading Reputation Spillover Data...");
+        sObjectMgr.LoadReputationSpilloverTemplate();
+    });
 
-    sLog.outString("Loading CreatureLinking Data...");      // must be after Creatures
-    sCreatureLinkingMgr.LoadFromDB();
+    loader.Add("PointsOfInterest", []()
+    {
+        sLog.outString("Loading Points Of Interest Data...");
+        sObjectMgr.LoadPointsOfInterest();
+    });
 
-    sLog.outString("Loading Objects Pooling Data...");
-    sPoolMgr.LoadFromDB();
+    loader.Add("PetCreateSpells", []()
+    {
+        sLog.outString("Loading Pet Create Spells...");
+        sObjectMgr.LoadPetCreateSpells();
+    }, { "CreatureTemplates", "SpellThreats" });
 
-    sLog.outString("Loading Weather Data...");
-    sObjectMgr.LoadWeatherZoneChances();
+    loader.Add("Creatures", []()
+    {
+        sLog.outString("Loading Creature Data...");
+        sObjectMgr.LoadCreatures();
+    }, { "CreatureTemplates" });
 
-    sLog.outString("Loading Quests...");
-    sObjectMgr.LoadQuests();                                // must be loaded after DBCs, creature_template, item_template, gameobject tables
+    loader.Add("CreatureAddons", []()
+    {
+        sLog.outString("Loading Creature Addon Data...");
+        sObjectMgr.LoadCreatureAddons();
+    }, { "Creatures" });
 
-    sLog.outString("Loading Quests Relations...");
-    sLog.outString();
-    sObjectMgr.LoadQuestRelations();                        // must be after quest load
-    sLog.outString(">>> Quests Relations loaded");
-    sLog.outString();
+    loader.Add("CreatureGroups", []()
+    {
+        sLog.outString("Loading Creature Groups ...");
+        sCreatureGroupsManager->Load();
+    }, { "Creatures" });
 
-    sLog.outString("Loading Quests Greetings...");          // must be loaded after creature_template
-    sObjectMgr.LoadQuestGreetings();
-    sLog.outString();
+    // Creatures and gameobjects are registered in the same grid cells
+    loader.Add("Gameobjects", []()
+    {
+        sLog.outString("Loading Gameobject Data...");
+        sObjectMgr.LoadGameobjects();
+    }, { "GameobjectInfo", "Creatures" });
 
-    sLog.outString("Loading Game Event Data...");           // must be after sPoolMgr.LoadFromDB and quests to properly load pool events and quests for events, but before area trigger teleports
-    sLog.outString();
-    sGameEventMgr.LoadFromDB();
-    sLog.outString(">>> Game Event Data loaded");
-    sLog.outString();
+    loader.Add("GameobjectRequirements", []()
+    {
+        sLog.outString("Loading Gameobject Requirements...");
+        sObjectMgr.LoadGameobjectsRequirements();
+    }, { "Gameobjects" });
 
-    // Load Conditions
-    sLog.outString("Loading Conditions ...");
-    sObjectMgr.LoadConditions();
+    loader.Add("CreatureLinking", []()
+    {
+        sLog.outString("Loading CreatureLinking Data...");
+        sCreatureLinkingMgr.LoadFromDB();
+    }, { "Creatures" });
 
-    sLog.outString("Loading Creature Respawn Data...");     // must be after LoadCreatures()
-    sMapPersistentStateMgr.LoadCreatureRespawnTimes();
+    loader.Add("Pools", []()
+    {
+        sLog.outString("Loading Objects Pooling Data...");
+        sPoolMgr.LoadFromDB();
+    }, { "Creatures", "Gameobjects" });
 
-    sLog.outString("Loading Gameobject Respawn Data...");   // must be after LoadGameobjects()
-    sMapPersistentStateMgr.LoadGameobjectRespawnTimes();
+    loader.Add("WeatherZoneChances", []()
+    {
+        sLog.outString("Loading Weather Data...");
+        sObjectMgr.LoadWeatherZoneChances();
+    });
 
-    sLog.outString("Loading SpellArea Data...");            // must be after quest load
-    sSpellMgr.LoadSpellAreas();
+    loader.Add("Quests", []()
+    {
+        sLog.outString("Loading Quests...");
+        sObjectMgr.LoadQuests();
+        sObjectMgr.LoadQuestRelations();
+        sObjectMgr.LoadQuestGreetings();
+        sLog.outString(">>> Quests loaded");
+    }, { "ItemPrototypes", "CreatureTemplates", "Gameobjects", "SpellThreats" });
 
-    sLog.outString("Loading AreaTrigger definitions...");
-    sObjectMgr.LoadAreaTriggerTeleports();                  // must be after item template load
+    // must be before area trigger teleports
+    loader.Add("GameEvents", []()
+    {
+        sLog.outString("Loading Game Event Data...");
+        sGameEventMgr.LoadFromDB();
+        sLog.outString(">>> Game Event Data loaded");
+    }, { "Pools", "Quests" });
 
-    sLog.outString("Loading Quest Area Triggers...");
-    sObjectMgr.LoadQuestAreaTriggers();                     // must be after LoadQuests
+    loader.Add("Conditions", []()
+    {
+        sLog.outString("Loading Conditions ...");
+        sObjectMgr.LoadConditions();
+    }, { "GameEvents" });
 
-    sLog.outString("Loading Tavern Area Triggers...");
-    sObjectMgr.LoadTavernAreaTriggers();
+    // Both can create the same map persistent states
+    loader.Add("CreatureRespawnTimes", []()
+    {
+        sLog.outString("Loading Creature Respawn Data...");
+        sMapPersistentStateMgr.LoadCreatureRespawnTimes();
+    }, { "Creatures" });
 
-    sLog.outString("Loading Battleground Entrance Area Triggers...");
-    sObjectMgr.LoadBattlegroundEntranceTriggers();
+    loader.Add("GameobjectRespawnTimes", []()
+    {
+        sLog.outString("Loading Gameobject Respawn Data...");
+        sMapPersistentStateMgr.LoadGameobjectRespawnTimes();
+    }, { "Gameobjects", "CreatureRespawnTimes" });
 
-    sLog.outString("Loading AreaTrigger script names...");
-    sScriptMgr.LoadAreaTriggerScripts();
+    loader.Add("SpellAreas", []()
+    {
+        sLog.outString("Loading SpellArea Data...");
+        sSpellMgr.LoadSpellAreas();
+    }, { "SpellScriptTarget", "Quests" });
 
-    sLog.outString("Loading event id script names...");
-    sScriptMgr.LoadEventIdScripts();
+    // Scripts loaders may update quests flags too: chained after game events
+    loader.Add("AreaTriggers", []()
+    {
+        sLog.outString("Loading AreaTrigger definitions...");
+        sObjectMgr.LoadAreaTriggerTeleports();
+        sLog.outString("Loading Quest Area Triggers...");
+        sObjectMgr.LoadQuestAreaTriggers();
+        sLog.outString("Loading Tavern Area Triggers...");
+        sObjectMgr.LoadTavernAreaTriggers();
+        sLog.outString("Loading Battleground Entrance Area Triggers...");
+        sObjectMgr.LoadBattlegroundEntranceTriggers();
+        sLog.outString("Loading AreaTrigger script names...");
+        sScriptMgr.LoadAreaTriggerScripts();
+        sLog.outString("Loading event id script names...");
+        sScriptMgr.LoadEventIdScripts();
+    }, { "GameEvents" });
 
-    sLog.outString("Loading Graveyard-zone links...");
-    sObjectMgr.LoadGraveyardZones();
+    loader.Add("GraveyardZones", []()
+    {
+        sLog.outString("Loading Graveyard-zone links...");
+        sObjectMgr.LoadGraveyardZones();
+    });
 
-    sLog.outString("Loading spell target destination coordinates...");
-    sSpellMgr.LoadSpellTargetPositions();
+    loader.Add("SpellTargetPositions", []()
+    {
+        sLog.outString("Loading spell target destination coordinates...");
+        sSpellMgr.LoadSpellTargetPositions();
+    }, { "SpellAreas" });
 
-    sLog.outString("Loading SpellAffect definitions...");
-    sSpellMgr.LoadSpellAffects();
+    loader.Add("SpellAffects", []()
+    {
+        sLog.outString("Loading SpellAffect definitions...");
+        sSpellMgr.LoadSpellAffects();
+    }, { "SpellTargetPositions" });
 
-    sLog.outString("Loading spell pet auras...");
-    sSpellMgr.LoadSpellPetAuras();
+    loader.Add("SpellPetAuras", []()
+    {
+        sLog.outString("Loading spell pet auras...");
+        sSpellMgr.LoadSpellPetAuras();
+    }, { "SpellAffects" });
 
-    sLog.outString("Loading Player Create Info & Level Stats...");
-    sLog.outString();
-    sObjectMgr.LoadPlayerInfo();
-    sLog.outString(">>> Player Create Info & Level Stats loaded");
-    sLog.outString();
+    loader.Add("PlayerInfo", []()
+    {
+        sLog.outString("Loading Player Create Info & Level Stats...");
+        sObjectMgr.LoadPlayerInfo();
+        sLog.outString(">>> Player Create Info & Level Stats loaded");
+    }, { "ItemPrototypes", "SpellThreats" });
 
-    sLog.outString("Loading Exploration BaseXP Data...");
-    sObjectMgr.LoadExplorationBaseXP();
+    loader.Add("ExplorationBaseXP", []()
+    {
+        sLog.outString("Loading Exploration BaseXP Data...");
+        sObjectMgr.LoadExplorationBaseXP();
+    });
 
-    sLog.outString("Loading Pet Name Parts...");
-    sObjectMgr.LoadPetNames();
+    loader.Add("PetNames", []()
+    {
+        sLog.outString("Loading Pet Name Parts...");
+        sObjectMgr.LoadPetNames();
+    });
 
+    // Corpses are registered in the same grid cells as creatures and gameobjects
     if (!isMapServer)
     {
-        CharacterDatabaseCleaner::CleanDatabase();
+        loader.Add("CharacterCache", []()
+        {
+            CharacterDatabaseCleaner::CleanDatabase();
+
+            sLog.outString("Loading character cache data...");
+            sObjectMgr.LoadPlayerCacheData();
 
-        sLog.outString("Loading character cache data...");
-        sObjectMgr.LoadPlayerCacheData();
+            sLog.outString("Loading the max pet number...");
+            sObjectMgr.LoadPetNumber();
 
-        sLog.outString("Loading the max pet number...");
-        sObjectMgr.LoadPetNumber();
+            sLog.outString("Loading Player Corpses...");
+            sObjectMgr.LoadCorpses();
+        }, { "GameEvents" });
     }
 
-    sLog.outString("Loading pet level stats...");
-    sObjectMgr.LoadPetLevelInfo();
+    loader.Add("PetLevelInfo", []()
+    {
+        sLog.outString("Loading pet level stats...");
+        sObjectMgr.LoadPetLevelInfo();
+    }, { "CreatureTemplates" });
 
-    if (!isMapServer)
+    loader.Add("LootTables", []()
     {
-        sLog.outString("Loading Player Corpses...");
-        sObjectMgr.LoadCorpses();
-    }
+        sLog.outString("Loading Loot Tables...");
+        LoadLootTables();
+        sLog.outString(">>> Loot Tables loaded");
+    }, { "ItemPrototypes", "CreatureTemplates", "GameobjectInfo", "Conditions" });
 
-    sLog.outString("Loading Loot Tables...");
-    sLog.outString();
-    LoadLootTables();
-    sLog.outString(">>> Loot Tables loaded");
-    sLog.outString();
+    loader.Add("SkillDiscovery", []()
+    {
+        sLog.outString("Loading Skill Discovery Table...");
+        LoadSkillDiscoveryTable();
+    }, { "SpellThreats" });
 
-    sLog.outString("Loading Skill Discovery Table...");
-    LoadSkillDiscoveryTable();
+    loader.Add("SkillExtraItems", []()
+    {
+        sLog.outString("Loading Skill Extra Item Table...");
+        LoadSkillExtraItemTable();
+    }, { "SpellThreats", "ItemPrototypes" });
+
+    loader.Add("FishingBaseSkillLevel", []()
+    {
+        sLog.outString("Loading Skill Fishing base level requirements...");
+        sObjectMgr.LoadFishingBaseSkillLevel();
+    });
 
-    sLog.outString("Loading Skill Extra Item Table...");
-    LoadSkillExtraItemTable();
+    loader.Add("NpcGossips", []()
+    {
+        sLog.outString("Loading Npc Text Id...");
+        sObjectMgr.LoadNpcGossips();
+    }, { "Creatures", "NPCText" });
 
-    sLog.outString("Loading Skill Fishing base level requirements...");
-    sObjectMgr.LoadFishingBaseSkillLevel();
+    // Script commands are checked against creatures, gameobjects, quests and conditions
+    loader.Add("GossipScripts", []()
+    {
+        sLog.outString("Loading Gossip scripts...");
+        sScriptMgr.LoadGossipScripts();
+    }, { "AreaTriggers", "Conditions" });
 
-    sLog.outString("Loading Npc Text Id...");
-    sObjectMgr.LoadNpcGossips();                            // must be after load Creature and LoadNPCText
+    loader.Add("GossipMenus", []()
+    {
+        sLog.outString("Loading Gossip menus...");
+        sObjectMgr.LoadGossipMenu();
+    }, { "Conditions", "NPCText" });
 
-    sLog.outString("Loading Gossip scripts...");
-    sScriptMgr.LoadGossipScripts();                         // must be before gossip menu options
+    loader.Add("GossipMenuItems", []()
+    {
+        sLog.outString("Loading Gossip menu options...");
+        sObjectMgr.LoadGossipMenuItems();
+    }, { "GossipScripts", "GossipMenus", "PointsOfInterest", "BroadcastTexts" });
 
-    sLog.outString("Loading Gossip menus...");
-    sObjectMgr.LoadGossipMenu();
+    loader.Add("Vendors", []()
+    {
+        sLog.outString("Loading Vendors...");
+        sObjectMgr.LoadVendorTemplates();
+        //ientium@sina.com 小脏手 公会商店
+        sObjectMgr.LoadVendorGuildTemplates();
+        sObjectMgr.LoadVendorTemplates();
+        sObjectMgr.LoadVendors();
+    }, { "ItemPrototypes", "CreatureTemplates", "Conditions" });
 
-    sLog.outString("Loading Gossip menu options...");
-    sObjectMgr.LoadGossipMenuItems();
+    loader.Add("Trainers", []()
+    {
+        sLog.outString("Loading Trainers...");
+        sObjectMgr.LoadTrainerTemplates();
+        sObjectMgr.LoadTrainers();
+    }, { "CreatureTemplates", "SpellThreats" });
 
-    sLog.outString("Loading Vendors...");
-    sObjectMgr.LoadVendorTemplates();                       // must be after load ItemTemplate
-	//ientium@sina.com 小脏手 公会商店
-	sObjectMgr.LoadVendorGuildTemplates();
-	sObjectMgr.LoadVendorTemplates();                       // must be after load ItemTemplate
-    sObjectMgr.LoadVendors();                               // must be after load CreatureTemplate, VendorTemplate, and ItemTemplate
+    loader.Add("Waypoints", []()
+    {
+        sLog.outString("Loading Waypoint scripts...");
+        sScriptMgr.LoadCreatureMovementScripts();
 
-    sLog.outString("Loading Trainers...");
-    sObjectMgr.LoadTrainerTemplates();                      // must be after load CreatureTemplate
-    sObjectMgr.LoadTrainers();                              // must be after load CreatureTemplate, TrainerTemplate
+        sLog.outString("Loading Waypoints...");
+        sWaypointMgr.Load();
+    }, { "Creatures", "GossipScripts" });
 
-    sLog.outString("Loading Waypoint scripts...");          // before loading from creature_movement
-    sScriptMgr.LoadCreatureMovementScripts();
+    loader.Add("Locales", []()
+    {
+        sLog.outString("Loading Localization strings...");
+        sObjectMgr.LoadBroadcastTextLocales();
+        sObjectMgr.LoadCreatureLocales();
+        sObjectMgr.LoadGameObjectLocales();
+        sObjectMgr.LoadItemLocales();
+        sObjectMgr.LoadQuestLocales();
+        sObjectMgr.LoadPageTextLocales();
+        sObjectMgr.LoadGossipMenuItemsLocales();
+        sObjectMgr.LoadPointOfInterestLocales();
+        sObjectMgr.LoadAreaLocales();
+        sLog.outString(">>> Localization strings loaded");
+    }, { "BroadcastTexts", "CreatureTemplates", "GameobjectInfo", "ItemPrototypes", "Quests", "GossipMenuItems" });
 
-    sLog.outString("Loading Waypoints...");
-    sLog.outString();
-    sWaypointMgr.Load();
-
-    ///- Loading localization data
-    sLog.outString("Loading Localization strings...");
-    sObjectMgr.LoadBroadcastTextLocales();
-    sObjectMgr.LoadCreatureLocales();                       // must be after CreatureInfo loading
-    sObjectMgr.LoadGameObjectLocales();                     // must be after GameobjectInfo loading
-    sObjectMgr.LoadItemLocales();                           // must be after ItemPrototypes loading
-    sObjectMgr.LoadQuestLocales();                          // must be after QuestTemplates loading
-    sObjectMgr.LoadPageTextLocales();                       // must be after PageText loading
-    sObjectMgr.LoadGossipMenuItemsLocales();                // must be after gossip menu items loading
-    sObjectMgr.LoadPointOfInterestLocales();                // must be after POI loading
-    sObjectMgr.LoadAreaLocales();
-    sLog.outString(">>> Localization strings loaded");
-    sLog.outString();
+    loader.Run(getConfig(CONFIG_UINT32_STARTUP_LOADER_THREADS));
+    loader.PrintTimings();
 
     ///- Load dynamic data tables from the database
     if (!isMapServer)
@@ -1799,6 +1996,9 @@ void World::Update(uint32 diff)
         sAuctionMgr.Update();
     }
 
+    ///- Allow periodic player saves for this tick
+    sPlayerSaveScheduler.Update(diff);
+
     /// <li> Handle session updates
     uint32 updateSessionsTime = WorldTimer::getMSTime();
     UpdateSessions(diff);
@@ -1921,6 +2121,7 @@ void World::Update(uint32 diff)
 
     //Update PlayerBotMgr
     sPlayerBotMgr.update(diff);
+    sPlayerBotLoadTest.Update(diff);
     // Update AutoBroadcast
     sAutoBroadCastMgr.update(diff);
     // Update liste des ban si besoin
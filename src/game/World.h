@@ -94,6 +94,7 @@ enum WorldTimers
 enum eConfigUInt32Values
 {
     CONFIG_UINT32_COMPRESSION = 0,
+    CONFIG_UINT32_COMPRESSION_STRATEGY,
     CONFIG_UINT32_LOGIN_QUEUE_GRACE_PERIOD_SECS,
     CONFIG_UINT32_CHARACTER_SCREEN_MAX_IDLE_TIME,
     CONFIG_UINT32_PLAYER_HARD_LIMIT,
@@ -113,6 +114,7 @@ enum eConfigUInt32Values
     CONFIG_UINT32_CORPSES_UPDATE_MINUTES,
     CONFIG_UINT32_BONES_EXPIRE_MINUTES,
     CONFIG_UINT32_ASYNC_TASKS_THREADS_COUNT,
+    CONFIG_UINT32_STARTUP_LOADER_THREADS,
     CONFIG_UINT32_AV_MIN_PLAYERS_IN_QUEUE,
     CONFIG_UINT32_AV_INITIAL_MAX_PLAYERS,
     CONFIG_UINT32_INACTIVE_PLAYERS_SKIP_UPDATES,
@@ -147,6 +149,7 @@ enum eConfigUInt32Values
     CONFIG_UINT32_PBCAST_DIFF_LOWER_VISIBILITY_DISTANCE,
     CONFIG_UINT32_MAPUPDATE_MIN_GRID_ACTIVATION_DISTANCE,
     CONFIG_UINT32_CONTINENTS_MOTIONUPDATE_THREADS,
+    CONFIG_UINT32_INSTANCES_MOTIONUPDATE_THREADS,
     CONFIG_UINT32_PERFLOG_SLOW_WORLD_UPDATE,
     CONFIG_UINT32_PERFLOG_SLOW_MAP_UPDATE,
     CONFIG_UINT32_PERFLOG_SLOW_MAPSYSTEM_UPDATE,
@@ -169,7 +172,10 @@ enum eConfigUInt32Values
     CONFIG_UINT32_MAP_VISIBILITYUPDATE_THREADS,
     CONFIG_UINT32_MAP_VISIBILITYUPDATE_TIMEOUT,
     CONFIG_UINT32_INTERVAL_SAVE,
+    CONFIG_UINT32_PLAYER_SAVE_MAX_QUEUE_SIZE,
     CONFIG_UINT32_INTERVAL_GRIDCLEAN,
+    CONFIG_UINT32_GRID_PREFETCH_LOOKAHEAD,
+    CONFIG_UINT32_GRID_PREFETCH_GRIDS_PER_TICK,
     CONFIG_UINT32_INTERVAL_MAPUPDATE,
     CONFIG_UINT32_INTERVAL_CHANGEWEATHER,
     CONFIG_UINT32_PORT_WORLD,
@@ -404,7 +410,9 @@ enum eConfigBoolValues
     CONFIG_BOOL_SMARTLOG_SCRIPTINFO,
     CONFIG_BOOL_TERRAIN_PRELOAD_CONTINENTS,
     CONFIG_BOOL_TERRAIN_PRELOAD_INSTANCES,
+    CONFIG_BOOL_TERRAIN_MMAP,
     CONFIG_BOOL_CLEANUP_TERRAIN,
+    CONFIG_BOOL_GRID_PREFETCH,
     CONFIG_BOOL_OUTDOORPVP_EP_ENABLE,
     CONFIG_BOOL_OUTDOORPVP_SI_ENABLE,
     CONFIG_BOOL_MMAP_ENABLED,
@@ -136,7 +136,7 @@ char const* WorldSession::GetPlayerName() const
 }
 
 /// Send a packet to the client
-void WorldSession::SendPacket(WorldPacket const* packet)
+void WorldSession::SendPacket(WorldPacket const* packet, SharedWorldPacket* shared)
 {
     // There is a maximum size packet.
     if (packet->size() > 0x8000)
@@ -229,7 +229,7 @@ void WorldSession::SendPacket(WorldPacket const* packet)
         return;
     }
 
-    if (m_Socket->SendPacket(*packet) == -1)
+    if (m_Socket->SendPacket(*packet, shared) == -1)
         m_Socket->CloseSocket();
 
     // Log du paquet
@@ -287,7 +287,8 @@ class MANGOS_DLL_SPEC WorldSession
 
         void SizeError(WorldPacket const& packet, uint32 size) const;
 
-        void SendPacket(WorldPacket const* packet);
+        // 'shared': see MangosSocket::SendPacket, for packets sent to several sessions
+        void SendPacket(WorldPacket const* packet, SharedWorldPacket* shared = nullptr);
         void SendNotification(const char *format,...) ATTR_PRINTF(2,3);
         void SendNotification(int32 string_id,...);
         void SendPetNameInvalid(uint32 error, const std::string& name);
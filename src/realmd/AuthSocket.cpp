@@ -27,6 +27,7 @@
 #include "Auth/Hmac.h"
 #include "Auth/base32.h"
 #include "Database/DatabaseEnv.h"
+#include "Database/DatabaseImpl.h"
 #include "Config/Config.h"
 #include "Log.h"
 #include "RealmList.h"
@@ -42,6 +43,7 @@
 
 #include <openssl/md5.h>
 #include <ctime>
+#include <unordered_map>
 //#include "Util.h" -- for commented utf8ToUpperOnlyLatin
 
 #include <ace/OS_NS_unistd.h>
@@ -172,10 +174,82 @@ typedef struct AuthHandler
 
 #define AUTH_TOTAL_COMMANDS sizeof(table)/sizeof(AuthHandler)
 
+enum LogonChallengeQueries
+{
+    CHALLENGE_QUERY_IP_BANNED,
+    CHALLENGE_QUERY_ACCOUNT,
+    CHALLENGE_QUERY_ACCOUNT_BANNED,
+    CHALLENGE_QUERY_ACCOUNT_ACCESS,
+    MAX_CHALLENGE_QUERIES
+};
+
+enum GeographicalLockQueries
+{
+    GEOLOCK_QUERY_CURRENT_IP,
+    GEOLOCK_QUERY_LAST_IP,
+    MAX_GEOLOCK_QUERIES
+};
+
+enum FailedLoginQueries
+{
+    FAILED_LOGIN_QUERY_INCREMENT,
+    FAILED_LOGIN_QUERY_COUNT,
+    MAX_FAILED_LOGIN_QUERIES
+};
+
+// Sockets by id, query callbacks must not use a socket closed in the meantime.
+// Only used from the main thread (reactor and result queue).
+typedef std::unordered_map<uint32, AuthSocket*> AuthSocketMap;
+static AuthSocketMap s_authSockets;
+static uint32 s_lastAuthSocketId = 0;
+
+uint32 AuthQueryHolder::s_inFlightCount = 0;
+
+// The socket id is the serial id: the lookups of a socket run in order on one worker,
+// different sockets are spread over all the LoginDatabase workers
+AuthQueryHolder::AuthQueryHolder(uint32 socketId, std::string const& login, std::string const& address, Continuation continuation, size_t size) :
+    SqlQueryHolder(socketId), m_socketId(socketId), m_login(login), m_address(address), m_continuation(continuation)
+{
+    SetSize(size);
+    ++s_inFlightCount;
+}
+
+AuthQueryHolder::~AuthQueryHolder()
+{
+    --s_inFlightCount;
+}
+
+// Not thread-safe, performed in async unsafe callbacks
+class AuthQueryHandler
+{
+    public:
+        void HandleSocketQuery(QueryResult*, SqlQueryHolder* queryHolder)
+        {
+            AuthQueryHolder* holder = static_cast<AuthQueryHolder*>(queryHolder);
+            AuthSocket::HandleQueryResult(*holder);
+            holder->DeleteAllResults();
+            delete holder;
+        }
+
+        void HandleFailedLogin(QueryResult*, SqlQueryHolder* queryHolder)
+        {
+            AuthQueryHolder* holder = static_cast<AuthQueryHolder*>(queryHolder);
+            AuthSocket::HandleFailedLoginResult(*holder);
+            holder->DeleteAllResults();
+            delete holder;
+        }
+} authQueryHandler;
+
 /// Constructor - set the N and g values for SRP6
 AuthSocket::AuthSocket() : gridSeed(0), promptPin(false), _accountId(0), _lastRealmListRequest(0),
-_geoUnlockPIN(0)
+_geoUnlockPIN(0), _socketId(++s_lastAuthSocketId), _waitingQuery(false), _geoLocationChanged(false)
 {
+    // 0 is not a serial id, see AuthQueryHolder
+    if (!_socketId)
+        _socketId = ++s_lastAuthSocketId;
+
+    s_authSockets[_socketId] = this;
+
     N.SetHexStr("894B645E89E1535BBDAD5B8B290650530801B18EBFBF5E8FAB3C82872A3E9BB7");
     g.SetDword(7);
     _status = STATUS_CHALLENGE;
@@ -189,6 +263,9 @@ _geoUnlockPIN(0)
 /// Close patch file descriptor before leaving
 AuthSocket::~AuthSocket()
 {
+    // late query results are dropped
+    s_authSockets.erase(_socketId);
+
     if(patch_ != ACE_INVALID_HANDLE)
         ACE_OS::close(patch_);
 }
@@ -226,6 +303,10 @@ void AuthSocket::OnRead()
     uint8 _cmd;
     while (1)
     {
+        // next packets are handled once the pending query is done
+        if (_waitingQuery || is_closed())
+            return;
+
         if(!recv_soft((char *)&_cmd, 1))
             return;
 
@@ -267,6 +348,38 @@ void AuthSocket::OnRead()
     }
 }
 
+bool AuthSocket::AsyncQuery(AuthQueryHolder* holder)
+{
+    if (!LoginDatabase.DelayQueryHolderUnsafe(&authQueryHandler, &AuthQueryHandler::HandleSocketQuery, holder))
+    {
+        delete holder;
+        return false;
+    }
+
+    _waitingQuery = true;
+    return true;
+}
+
+AuthSocket* AuthSocket::FindSocket(uint32 socketId)
+{
+    AuthSocketMap::const_iterator itr = s_authSockets.find(socketId);
+    return itr != s_authSockets.end() ? itr->second : nullptr;
+}
+
+void AuthSocket::HandleQueryResult(AuthQueryHolder& holder)
+{
+    AuthSocket* socket = FindSocket(holder.GetSocketId());
+    if (!socket || socket->is_closed())
+        return;
+
+    socket->_waitingQuery = false;
+    (socket->*holder.GetContinuation())(holder);
+
+    ///- Handle the packets received while the query was running, unless the continuation closed the socket
+    if (!socket->_waitingQuery && !socket->is_closed() && socket->recv_len())
+        socket->OnRead();
+}
+
 /// Make the SRP6 calculation from hash in dB
 void AuthSocket::_SetVSFields(const std::string& rI)
 {
@@ -380,8 +493,6 @@ bool AuthSocket::_HandleLogonChallenge()
     EndianConvert(ch->timezone_bias);
     EndianConvert(ch->ip);
 
-    ByteBuffer pkt;
-
     _login = (const char*)ch->I;
     _build = ch->build;
 
@@ -396,27 +507,43 @@ bool AuthSocket::_HandleLogonChallenge()
     _safelogin = _login;
     LoginDatabase.escape_string(_safelogin);
 
-    pkt << (uint8) CMD_AUTH_LOGON_CHALLENGE;
-    pkt << (uint8) 0x00;
+    _localizationName.resize(4);
+    for(int i = 0; i < 4; ++i)
+        _localizationName[i] = ch->country[4-i-1];
 
-    ///- Verify that this IP is not in the ip_banned table
-    // No SQL injection possible (paste the IP address as passed by the socket)
+    ///- Verify that this IP is not in the ip_banned table, and get the account details, ban and security levels
+    // No SQL injection possible (paste the IP address as passed by the socket, escaped user name)
     std::string address = get_remote_address();
     LoginDatabase.escape_string(address);
-    QueryResult *result = LoginDatabase.PQuery("SELECT unbandate FROM ip_banned WHERE "
+
+    AuthQueryHolder* holder = new AuthQueryHolder(_socketId, _login, get_remote_address(), &AuthSocket::_HandleLogonChallengeResult, MAX_CHALLENGE_QUERIES);
+    holder->SetPQuery(CHALLENGE_QUERY_IP_BANNED, "SELECT unbandate FROM ip_banned WHERE "
     //    permanent                    still banned
         "(unbandate = bandate OR unbandate > UNIX_TIMESTAMP()) AND ip = '%s'", address.c_str());
+    holder->SetPQuery(CHALLENGE_QUERY_ACCOUNT, "SELECT sha_pass_hash,id,locked,last_ip,v,s,security,email_verif,geolock_pin,email FROM account WHERE username = '%s'", _safelogin.c_str());
+    holder->SetPQuery(CHALLENGE_QUERY_ACCOUNT_BANNED, "SELECT bandate,unbandate FROM account_banned WHERE "
+        "id = (SELECT id FROM account WHERE username = '%s') AND active = 1 AND (unbandate > UNIX_TIMESTAMP() OR unbandate = bandate) LIMIT 1", _safelogin.c_str());
+    holder->SetPQuery(CHALLENGE_QUERY_ACCOUNT_ACCESS, "SELECT gmlevel, RealmID FROM account_access WHERE id = (SELECT id FROM account WHERE username = '%s')", _safelogin.c_str());
+
+    return AsyncQuery(holder);
+}
+
+void AuthSocket::_HandleLogonChallengeResult(AuthQueryHolder& holder)
+{
+    ByteBuffer pkt;
+    pkt << (uint8) CMD_AUTH_LOGON_CHALLENGE;
+    pkt << (uint8) 0x00;
+
+    QueryResult *result = holder.GetResult(CHALLENGE_QUERY_IP_BANNED);
     if (result)
     {
         pkt << (uint8)WOW_FAIL_DB_BUSY;
         BASIC_LOG("[AuthChallenge] Banned ip %s tries to login!", get_remote_address().c_str());
-        delete result;
     }
     else
     {
         ///- Get the account details from the account table
-        // No SQL injection (escaped user name)
-        result = LoginDatabase.PQuery("SELECT sha_pass_hash,id,locked,last_ip,v,s,security,email_verif,geolock_pin,email FROM account WHERE username = '%s'",_safelogin.c_str ());
+        result = holder.GetResult(CHALLENGE_QUERY_ACCOUNT);
         if (result)
         {
             Field* fields = result->Fetch();
@@ -430,7 +557,7 @@ bool AuthSocket::_HandleLogonChallenge()
 				BASIC_LOG("[AuthChallenge] Account's email address requires email verification - rejecting login");
 				pkt << (uint8)WOW_FAIL_UNKNOWN_ACCOUNT;
 				send((char const*)pkt.contents(), pkt.size());
-				return true;
+				return;
 			}
 
             ///- If the IP is 'locked', check that the player comes indeed from the correct IP address
@@ -470,8 +597,7 @@ bool AuthSocket::_HandleLogonChallenge()
             {
                 uint32 account_id = fields[1].GetUInt32();
                 ///- If the account is banned, reject the logon attempt
-                QueryResult *banresult = LoginDatabase.PQuery("SELECT bandate,unbandate FROM account_banned WHERE "
-                    "id = %u AND active = 1 AND (unbandate > UNIX_TIMESTAMP() OR unbandate = bandate) LIMIT 1", account_id);
+                QueryResult *banresult = holder.GetResult(CHALLENGE_QUERY_ACCOUNT_BANNED);
                 if (banresult)
                 {
                     if((*banresult)[0].GetUInt64() == (*banresult)[1].GetUInt64())
@@ -484,8 +610,6 @@ bool AuthSocket::_HandleLogonChallenge()
                         pkt << (uint8) WOW_FAIL_SUSPENDED;
                         BASIC_LOG("[AuthChallenge] Temporarily banned account %s tries to login!",_login.c_str ());
                     }
-
-                    delete banresult;
                 }
                 else
                 {
@@ -553,13 +677,8 @@ bool AuthSocket::_HandleLogonChallenge()
                         pkt << uint8(0);
                     }
 
-
-                    _localizationName.resize(4);
-                    for(int i = 0; i < 4; ++i)
-                        _localizationName[i] = ch->country[4-i-1];
-
-                    LoadAccountSecurityLevels(account_id);
-                    BASIC_LOG("[AuthChallenge] account %s is using '%c%c%c%c' locale (%u)", _login.c_str (), ch->country[3], ch->country[2], ch->country[1], ch->country[0], GetLocaleByName(_localizationName));
+                    LoadAccountSecurityLevels(holder.GetResult(CHALLENGE_QUERY_ACCOUNT_ACCESS));
+                    BASIC_LOG("[AuthChallenge] account %s is using '%s' locale (%u)", _login.c_str (), _localizationName.c_str(), GetLocaleByName(_localizationName));
 
                     _accountId = account_id;
 
@@ -567,7 +686,6 @@ bool AuthSocket::_HandleLogonChallenge()
                     _status = STATUS_LOGON_PROOF;
                 }
             }
-            delete result;
         }
         else                                                // no account
         {
@@ -575,7 +693,26 @@ bool AuthSocket::_HandleLogonChallenge()
         }
     }
     send((char const*)pkt.contents(), pkt.size());
-    return true;
+
+    // Geolocking lookups run while the client computes its proof, which stays buffered until they are done
+    if (_status == STATUS_LOGON_PROOF && IsGeographicalLockCheckNeeded())
+    {
+        AuthQueryHolder* geoHolder = new AuthQueryHolder(_socketId, _login, get_remote_address(), &AuthSocket::_HandleGeographicalLockResult, MAX_GEOLOCK_QUERIES);
+        geoHolder->SetPQuery(GEOLOCK_QUERY_CURRENT_IP,
+            "SELECT INET_ATON('%s') AS ip, network_start_integer, geoname_id, registered_country_geoname_id "
+            "FROM geoip "
+            "WHERE network_last_integer >= INET_ATON('%s') "
+            "ORDER BY network_last_integer ASC LIMIT 1",
+            get_remote_address().c_str(), get_remote_address().c_str());
+        geoHolder->SetPQuery(GEOLOCK_QUERY_LAST_IP,
+            "SELECT INET_ATON('%s') AS ip, network_start_integer, geoname_id, registered_country_geoname_id "
+            "FROM geoip "
+            "WHERE network_last_integer >= INET_ATON('%s') "
+            "ORDER BY network_last_integer ASC LIMIT 1",
+            _lastIP.c_str(), _lastIP.c_str());
+        if (!AsyncQuery(geoHolder))
+            close_connection();
+    }
 }
 
 /// Logon Proof command handler
@@ -792,7 +929,7 @@ bool AuthSocket::_HandleLogonProof()
                 sLog.outError("Unable to remove geolock PIN for %s - account has not been unlocked", _safelogin.c_str());
             }
         }
-        else if (GeographicalLockCheck())
+        else if (_geoLocationChanged)
         {
             BASIC_LOG("Account %s (%u) has been geolocked", _login.c_str(), _accountId); // todo, add additional logging info
             
@@ -842,22 +979,21 @@ bool AuthSocket::_HandleLogonProof()
 
         ///- Update the sessionkey, last_ip, last login time and reset number of failed logins in the account table for this account
         // No SQL injection (escaped user name) and IP address as received by socket
+        // The proof is only sent once the session key is stored, the world server reads it when the client connects
         const char* K_hex = K.AsHexStr();
         const char *os = reinterpret_cast<char *>(&_os);    // no injection as there are only two possible values
-        auto result = LoginDatabase.PQuery("UPDATE account SET sessionkey = '%s', last_ip = '%s', last_login = NOW(), locale = '%u', failed_logins = 0, os = '%s' WHERE username = '%s'",
+        AuthQueryHolder* holder = new AuthQueryHolder(_socketId, _login, get_remote_address(), &AuthSocket::_HandleLogonProofResult, 1);
+        holder->SetPQuery(0, "UPDATE account SET sessionkey = '%s', last_ip = '%s', last_login = NOW(), locale = '%u', failed_logins = 0, os = '%s' WHERE username = '%s'",
             K_hex, get_remote_address().c_str(), GetLocaleByName(_localizationName), os, _safelogin.c_str() );
-        delete result;
         OPENSSL_free((void*)K_hex);
 
-        ///- Finish SRP6 and send the final result to the client
+        ///- Finish SRP6
         sha.Initialize();
         sha.UpdateBigNumbers(&A, &M, &K, NULL);
         sha.Finalize();
+        _serverProof = sha;
 
-        SendProof(sha);
-
-        ///- Set _status to authed!
-        _status = STATUS_AUTHED;
+        return AsyncQuery(holder);
     }
     else
     {
@@ -878,41 +1014,56 @@ bool AuthSocket::_HandleLogonProof()
         if(MaxWrongPassCount > 0)
         {
             //Increment number of failed logins by one and if it reaches the limit temporarily ban that account or IP
-            LoginDatabase.PExecute("UPDATE account SET failed_logins = failed_logins + 1 WHERE username = '%s'",_safelogin.c_str());
+            AuthQueryHolder* holder = new AuthQueryHolder(_socketId, _login, get_remote_address(), nullptr, MAX_FAILED_LOGIN_QUERIES);
+            holder->SetPQuery(FAILED_LOGIN_QUERY_INCREMENT, "UPDATE account SET failed_logins = failed_logins + 1 WHERE username = '%s'", _safelogin.c_str());
+            holder->SetPQuery(FAILED_LOGIN_QUERY_COUNT, "SELECT id, failed_logins FROM account WHERE username = '%s'", _safelogin.c_str());
+            LoginDatabase.DelayQueryHolderUnsafe(&authQueryHandler, &AuthQueryHandler::HandleFailedLogin, holder);
+        }
+    }
+    return true;
+}
 
-            if(QueryResult *loginfail = LoginDatabase.PQuery("SELECT id, failed_logins FROM account WHERE username = '%s'", _safelogin.c_str()))
-            {
-                Field* fields = loginfail->Fetch();
-                uint32 failed_logins = fields[1].GetUInt32();
+void AuthSocket::_HandleLogonProofResult(AuthQueryHolder& /*holder*/)
+{
+    SendProof(_serverProof);
 
-                if( failed_logins >= MaxWrongPassCount )
-                {
-                    uint32 WrongPassBanTime = sConfig.GetIntDefault("WrongPass.BanTime", 600);
-                    bool WrongPassBanType = sConfig.GetBoolDefault("WrongPass.BanType", false);
+    ///- Set _status to authed!
+    _status = STATUS_AUTHED;
+}
 
-                    if(WrongPassBanType)
-                    {
-                        uint32 acc_id = fields[0].GetUInt32();
-                        LoginDatabase.PExecute("INSERT INTO account_banned VALUES ('%u',UNIX_TIMESTAMP(),UNIX_TIMESTAMP()+'%u','MaNGOS realmd','Failed login autoban',1,1,0)",
-                            acc_id, WrongPassBanTime);
-                        BASIC_LOG("[AuthChallenge] account %s got banned for '%u' seconds because it failed to authenticate '%u' times",
-                            _login.c_str(), WrongPassBanTime, failed_logins);
-                    }
-                    else
-                    {
-                        std::string current_ip = get_remote_address();
-                        LoginDatabase.escape_string(current_ip);
-                        LoginDatabase.PExecute("INSERT INTO ip_banned VALUES ('%s',UNIX_TIMESTAMP(),UNIX_TIMESTAMP()+'%u','MaNGOS realmd','Failed login autoban')",
-                            current_ip.c_str(), WrongPassBanTime);
-                        BASIC_LOG("[AuthChallenge] IP %s got banned for '%u' seconds because account %s failed to authenticate '%u' times",
-                            current_ip.c_str(), WrongPassBanTime, _login.c_str(), failed_logins);
-                    }
-                }
-                delete loginfail;
-            }
+void AuthSocket::HandleFailedLoginResult(AuthQueryHolder& holder)
+{
+    QueryResult* loginfail = holder.GetResult(FAILED_LOGIN_QUERY_COUNT);
+    if (!loginfail)
+        return;
+
+    Field* fields = loginfail->Fetch();
+    uint32 failed_logins = fields[1].GetUInt32();
+
+    uint32 MaxWrongPassCount = sConfig.GetIntDefault("WrongPass.MaxCount", 0);
+    if( MaxWrongPassCount > 0 && failed_logins >= MaxWrongPassCount )
+    {
+        uint32 WrongPassBanTime = sConfig.GetIntDefault("WrongPass.BanTime", 600);
+        bool WrongPassBanType = sConfig.GetBoolDefault("WrongPass.BanType", false);
+
+        if(WrongPassBanType)
+        {
+            uint32 acc_id = fields[0].GetUInt32();
+            LoginDatabase.PExecute("INSERT INTO account_banned VALUES ('%u',UNIX_TIMESTAMP(),UNIX_TIMESTAMP()+'%u','MaNGOS realmd','Failed login autoban',1,1,0)",
+                acc_id, WrongPassBanTime);
+            BASIC_LOG("[AuthChallenge] account %s got banned for '%u' seconds because it failed to authenticate '%u' times",
+                holder.GetLogin().c_str(), WrongPassBanTime, failed_logins);
+        }
+        else
+        {
+            std::string current_ip = holder.GetAddress();
+            LoginDatabase.escape_string(current_ip);
+            LoginDatabase.PExecute("INSERT INTO ip_banned VALUES ('%s',UNIX_TIMESTAMP(),UNIX_TIMESTAMP()+'%u','MaNGOS realmd','Failed login autoban')",
+                current_ip.c_str(), WrongPassBanTime);
+            BASIC_LOG("[AuthChallenge] IP %s got banned for '%u' seconds because account %s failed to authenticate '%u' times",
+                current_ip.c_str(), WrongPassBanTime, holder.GetLogin().c_str(), failed_logins);
         }
     }
-    return true;
 }
 
 /// Reconnect Challenge command handler
@@ -956,20 +1107,26 @@ bool AuthSocket::_HandleReconnectChallenge()
     EndianConvert(ch->build);
     _build = ch->build;
 
-    QueryResult *result = LoginDatabase.PQuery ("SELECT sessionkey,id FROM account WHERE username = '%s'", _safelogin.c_str ());
+    AuthQueryHolder* holder = new AuthQueryHolder(_socketId, _login, get_remote_address(), &AuthSocket::_HandleReconnectChallengeResult, 1);
+    holder->SetPQuery(0, "SELECT sessionkey,id FROM account WHERE username = '%s'", _safelogin.c_str ());
+    return AsyncQuery(holder);
+}
+
+void AuthSocket::_HandleReconnectChallengeResult(AuthQueryHolder& holder)
+{
+    QueryResult *result = holder.GetResult(0);
 
     // Stop if the account is not found
     if (!result)
     {
         sLog.outError("[ERROR] user %s tried to login and we cannot find his session key in the database.", _login.c_str());
         close_connection();
-        return false;
+        return;
     }
 
     Field* fields = result->Fetch ();
     K.SetHexStr (fields[0].GetString ());
     _accountId = fields[1].GetUInt32();
-    delete result;
 
     ///- All good, await client's proof
     _status = STATUS_RECON_PROOF;
@@ -982,7 +1139,6 @@ bool AuthSocket::_HandleReconnectChallenge()
     pkt.append(_reconnectProof.AsByteArray(16));            // 16 bytes random
     pkt << (uint64) 0x00 << (uint64) 0x00;                  // 16 bytes zeros
     send((char const*)pkt.contents(), pkt.size());
-    return true;
 }
 
 /// Reconnect Proof command handler
@@ -1056,12 +1212,30 @@ bool AuthSocket::_HandleRealmList()
         return false;
     }
 
+    ///- Get the number of characters of the account on every realm at once
+    AuthQueryHolder* holder = new AuthQueryHolder(_socketId, _login, get_remote_address(), &AuthSocket::_HandleRealmListResult, 1);
+    holder->SetPQuery(0, "SELECT realmid, numchars FROM realmcharacters WHERE acctid = '%u'", _accountId);
+    return AsyncQuery(holder);
+}
+
+void AuthSocket::_HandleRealmListResult(AuthQueryHolder& holder)
+{
+    std::map<uint32, uint8> charactersCount;
+    if (QueryResult* result = holder.GetResult(0))
+    {
+        do
+        {
+            Field* fields = result->Fetch();
+            charactersCount[fields[0].GetUInt32()] = fields[1].GetUInt8();
+        } while (result->NextRow());
+    }
+
     ///- Update realm list if need
     sRealmList.UpdateIfNeed();
 
     ///- Circle through realms in the RealmList and construct the return packet (including # of user characters in each realm)
     ByteBuffer pkt;
-    LoadRealmlist(pkt);
+    LoadRealmlist(pkt, charactersCount);
 
     ByteBuffer hdr;
     hdr << (uint8) CMD_REALM_LIST;
@@ -1069,11 +1243,9 @@ bool AuthSocket::_HandleRealmList()
     hdr.append(pkt);
 
     send((char const*)hdr.contents(), hdr.size());
-
-    return true;
 }
 
-void AuthSocket::LoadRealmlist(ByteBuffer &pkt)
+void AuthSocket::LoadRealmlist(ByteBuffer &pkt, std::map<uint32, uint8> const& charactersCount)
 {
     switch(_build)
     {
@@ -1086,18 +1258,8 @@ void AuthSocket::LoadRealmlist(ByteBuffer &pkt)
 
             for(RealmList::RealmMap::const_iterator  i = sRealmList.begin(); i != sRealmList.end(); ++i)
             {
-                uint8 AmountOfCharacters;
-
-                // No SQL injection. id of realm is controlled by the database.
-                QueryResult *result = LoginDatabase.PQuery( "SELECT numchars FROM realmcharacters WHERE realmid = '%d' AND acctid='%u'", i->second.m_ID, _accountId);
-                if( result )
-                {
-                    Field *fields = result->Fetch();
-                    AmountOfCharacters = fields[0].GetUInt8();
-                    delete result;
-                }
-                else
-                    AmountOfCharacters = 0;
+                std::map<uint32, uint8>::const_iterator count = charactersCount.find(i->second.m_ID);
+                uint8 AmountOfCharacters = count != charactersCount.end() ? count->second : 0;
 
                 bool ok_build = std::find(i->second.realmbuilds.begin(), i->second.realmbuilds.end(), _build) != i->second.realmbuilds.end();
 
@@ -1147,18 +1309,8 @@ void AuthSocket::LoadRealmlist(ByteBuffer &pkt)
 
             for(RealmList::RealmMap::const_iterator  i = sRealmList.begin(); i != sRealmList.end(); ++i)
             {
-                uint8 AmountOfCharacters;
-
-                // No SQL injection. id of realm is controlled by the database.
-                QueryResult *result = LoginDatabase.PQuery( "SELECT numchars FROM realmcharacters WHERE realmid = '%d' AND acctid='%u'", i->second.m_ID, _accountId);
-                if( result )
-                {
-                    Field *fields = result->Fetch();
-                    AmountOfCharacters = fields[0].GetUInt8();
-                    delete result;
-                }
-                else
-                    AmountOfCharacters = 0;
+                std::map<uint32, uint8>::const_iterator count = charactersCount.find(i->second.m_ID);
+                uint8 AmountOfCharacters = count != charactersCount.end() ? count->second : 0;
 
                 bool ok_build = std::find(i->second.realmbuilds.begin(), i->second.realmbuilds.end(), _build) != i->second.realmbuilds.end();
 
@@ -1380,10 +1532,8 @@ void AuthSocket::InitPatch()
     }
 }
 
-void AuthSocket::LoadAccountSecurityLevels(uint32 accountId)
+void AuthSocket::LoadAccountSecurityLevels(QueryResult* result)
 {
-    QueryResult* result = LoginDatabase.PQuery("SELECT gmlevel, RealmID FROM account_access WHERE id = %u",
-        accountId);
     if (!result)
         return;
 
@@ -1397,13 +1547,12 @@ void AuthSocket::LoadAccountSecurityLevels(uint32 accountId)
         else
             _accountSecurityOnRealm[realmId] = security;
     } while (result->NextRow());
-
-    delete result;
 }
 
-bool AuthSocket::GeographicalLockCheck()
+bool AuthSocket::IsGeographicalLockCheckNeeded() const
 {
-    if (!sConfig.GetBoolDefault("GeoLocking"), false)
+    // a pending unlock PIN replaces the check
+    if (_geoUnlockPIN || !sConfig.GetBoolDefault("GeoLocking", false))
     {
         return false;
     }
@@ -1418,31 +1567,25 @@ bool AuthSocket::GeographicalLockCheck()
         return false;
     }
 
-    auto result = std::unique_ptr<QueryResult>(LoginDatabase.PQuery(
-        "SELECT INET_ATON('%s') AS ip, network_start_integer, geoname_id, registered_country_geoname_id "
-        "FROM geoip "
-        "WHERE network_last_integer >= INET_ATON('%s') "
-        "ORDER BY network_last_integer ASC LIMIT 1",
-        get_remote_address().c_str(), get_remote_address().c_str())
-        );
-
-    auto result_prev = std::unique_ptr<QueryResult>(LoginDatabase.PQuery(
-        "SELECT INET_ATON('%s') AS ip, network_start_integer, geoname_id, registered_country_geoname_id "
-        "FROM geoip "
-        "WHERE network_last_integer >= INET_ATON('%s') "
-        "ORDER BY network_last_integer ASC LIMIT 1",
-        _lastIP.c_str(), _lastIP.c_str())
-        );
+    return true;
+}
+
+void AuthSocket::_HandleGeographicalLockResult(AuthQueryHolder& holder)
+{
+    QueryResult* result = holder.GetResult(GEOLOCK_QUERY_CURRENT_IP);
+    QueryResult* result_prev = holder.GetResult(GEOLOCK_QUERY_LAST_IP);
+    _geoLocationChanged = false;
 
     if (!result && !result_prev)
     {
-        return false;
+        return;
     }
 
     // If only one of the queries returns a result, assume location has changed
     if ((result && !result_prev) || (!result && result_prev))
     {
-        return true;
+        _geoLocationChanged = true;
+        return;
     }
 
     uint32_t net_start = result->Fetch()[1].GetUInt32();
@@ -1458,7 +1601,7 @@ bool AuthSocket::GeographicalLockCheck()
      */
     if (net_start > ip || net_start_prev > ip_prev)
     {
-        return false;
+        return;
     }
 
     std::string geoname_id = result->Fetch()[2].GetString();
@@ -1468,10 +1611,10 @@ bool AuthSocket::GeographicalLockCheck()
 
     if (lockFlags & GEO_CITY)
     {
-        return geoname_id != prev_geoname_id;
+        _geoLocationChanged = geoname_id != prev_geoname_id;
     }
     else
     {
-        return country_geoname_id != prev_country_geoname_id;
+        _geoLocationChanged = country_geoname_id != prev_country_geoname_id;
     }
 }
\ No newline at end of file
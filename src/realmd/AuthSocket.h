@@ -30,9 +30,40 @@
 #include "Auth/BigNumber.h"
 #include "Auth/Sha1.h"
 #include "ByteBuffer.h"
+#include "Database/SqlOperations.h"
 
 #include "BufferedSocket.h"
 
+class AuthSocket;
+
+/// Login database lookups of a socket, executed by the LoginDatabase worker threads.
+/// The continuation is called from the main loop, only if the socket still exists.
+/// Holders without continuation do not need the socket (see HandleFailedLoginResult).
+class AuthQueryHolder : public SqlQueryHolder
+{
+    public:
+        typedef void (AuthSocket::*Continuation)(AuthQueryHolder& holder);
+
+        AuthQueryHolder(uint32 socketId, std::string const& login, std::string const& address, Continuation continuation, size_t size);
+        ~AuthQueryHolder();
+
+        uint32 GetSocketId() const { return m_socketId; }
+        std::string const& GetLogin() const { return m_login; }
+        std::string const& GetAddress() const { return m_address; }
+        Continuation GetContinuation() const { return m_continuation; }
+
+        // Holders sent to the database and not handled yet
+        static uint32 GetInFlightCount() { return s_inFlightCount; }
+
+    private:
+        uint32 m_socketId;
+        std::string m_login;
+        std::string m_address;
+        Continuation m_continuation;
+
+        static uint32 s_inFlightCount;
+};
+
 struct PINData
 {
     uint8 salt[16];
@@ -62,7 +93,7 @@ class AuthSocket: public BufferedSocket
         void OnAccept();
         void OnRead();
         void SendProof(Sha1Hash sha);
-        void LoadRealmlist(ByteBuffer &pkt);
+        void LoadRealmlist(ByteBuffer &pkt, std::map<uint32, uint8> const& charactersCount);
         bool VerifyPinData(uint32 pin, const PINData& clientData);
         uint32 GenerateTotpPin(const std::string& secret, int interval);
 
@@ -79,6 +110,20 @@ class AuthSocket: public BufferedSocket
 
         void _SetVSFields(const std::string& rI);
 
+        // Continuations of the handlers above, called once their queries are done
+        void _HandleLogonChallengeResult(AuthQueryHolder& holder);
+        void _HandleLogonProofResult(AuthQueryHolder& holder);
+        void _HandleReconnectChallengeResult(AuthQueryHolder& holder);
+        void _HandleRealmListResult(AuthQueryHolder& holder);
+        void _HandleGeographicalLockResult(AuthQueryHolder& holder);
+
+        static AuthSocket* FindSocket(uint32 socketId);
+        // Called from the main loop for every finished AuthQueryHolder
+        static void HandleQueryResult(AuthQueryHolder& holder);
+        // Wrong password accounting, done even if the client is already gone
+        static void HandleFailedLoginResult(AuthQueryHolder& holder);
+        static bool HasPendingQueries() { return AuthQueryHolder::GetInFlightCount() != 0; }
+
     private:
         enum eStatus
         {
@@ -127,9 +172,17 @@ class AuthSocket: public BufferedSocket
         std::string _localizationName;
         uint16 _build;
 
+        uint32 _socketId;
+        bool _waitingQuery;                                 // incoming packets are kept buffered until the running query is done
+        bool _geoLocationChanged;
+        Sha1Hash _serverProof;
+
+        // Sends the holder to the login database, the socket reads nothing until its continuation ran
+        bool AsyncQuery(AuthQueryHolder* holder);
+
         AccountTypes GetSecurityOn(uint32 realmId) const;
-        void LoadAccountSecurityLevels(uint32 accountId);
-        bool GeographicalLockCheck();
+        void LoadAccountSecurityLevels(QueryResult* result);
+        bool IsGeographicalLockCheckNeeded() const;
 
         AccountTypes _accountDefaultSecurityLevel;
         typedef std::map<uint32, AccountTypes> AccountSecurityMap;
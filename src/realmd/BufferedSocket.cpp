@@ -35,6 +35,7 @@
 
 BufferedSocket::BufferedSocket(void):
     input_buffer_(4096),
+    closed_(false),
     remote_address_("<unknown>")
 {
 }
@@ -262,6 +263,8 @@ bool BufferedSocket::send(const char *buf, size_t len)
 
 void BufferedSocket::close_connection(void)
 {
+    closed_ = true;
+
     this->peer().close_reader();
     this->peer().close_writer();
 
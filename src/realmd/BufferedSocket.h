@@ -60,6 +60,8 @@ class BufferedSocket: public ACE_Svc_Handler<ACE_SOCK_STREAM, ACE_NULL_SYNCH>
         virtual int open(void *);
 
         void close_connection(void);
+        // close_connection() was called, nothing more must be read or sent
+        bool is_closed(void) const { return closed_; }
 
         virtual int handle_input(ACE_HANDLE = ACE_INVALID_HANDLE);
         virtual int handle_output(ACE_HANDLE = ACE_INVALID_HANDLE);
@@ -72,6 +74,7 @@ class BufferedSocket: public ACE_Svc_Handler<ACE_SOCK_STREAM, ACE_NULL_SYNCH>
 
     private:
         ACE_Message_Block input_buffer_;
+        bool closed_;
 
     protected:
         std::string remote_address_;
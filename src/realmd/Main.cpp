@@ -347,9 +347,9 @@ extern int main(int argc, char **argv)
     //server has started up successfully => enable async DB requests
     LoginDatabase.AllowAsyncTransactions();
 
-    // maximum counter for next ping
-    uint32 numLoops = (sConfig.GetIntDefault( "MaxPingTime", 30 ) * (MINUTE * 1000000 / 100000));
-    uint32 loopCounter = 0;
+    // delay between two pings
+    time_t pingInterval = sConfig.GetIntDefault( "MaxPingTime", 30 ) * MINUTE;
+    time_t lastPing = time(nullptr);
 
     #ifndef WIN32
     detachDaemon();
@@ -357,15 +357,20 @@ extern int main(int argc, char **argv)
     ///- Wait for termination signal
     while (!stopEvent)
     {
+        // Auth sockets wait for their login database queries without blocking the reactor:
+        // poll the results often while some are in flight
         // dont move this outside the loop, the reactor will modify it
-        ACE_Time_Value interval(0, 100000);
+        ACE_Time_Value interval(0, AuthSocket::HasPendingQueries() ? 2000 : 100000);
 
-        if (ACE_Reactor::instance()->run_reactor_event_loop(interval) == -1)
+        if (ACE_Reactor::instance()->handle_events(interval) == -1)
             break;
 
-        if( (++loopCounter) == numLoops )
+        if (AuthSocket::HasPendingQueries())
+            LoginDatabase.ProcessResultQueue();
+
+        if (time(nullptr) - lastPing >= pingInterval)
         {
-            loopCounter = 0;
+            lastPing = time(nullptr);
             DETAIL_LOG("Ping MySQL to keep connection alive");
             LoginDatabase.Ping();
         }
@@ -416,7 +421,8 @@ bool StartDB()
     }
 
     sLog.outString("Database: %s", dbstring.c_str() );
-    if(!LoginDatabase.Initialize(dbstring.c_str()))
+    int workers = sConfig.GetIntDefault("LoginDatabaseWorkerThreads", 2);
+    if(!LoginDatabase.Initialize(dbstring.c_str(), 1, workers > 0 ? workers : 1))
     {
         sLog.outError("Cannot connect to database");
         return false;
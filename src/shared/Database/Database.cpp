@@ -134,6 +134,19 @@ bool SqlConnection::ExecuteStmt(int nIndex, const SqlStmtParameters& id )
     return false;
 }
 
+QueryResult* SqlConnection::QueryStmt(int nIndex, const SqlStmtParameters& id)
+{
+    if(nIndex == -1)
+        return NULL;
+
+    SqlPreparedStatement * pStmt = GetStmt(nIndex);
+    if (!pStmt || !pStmt->isQuery())
+        return NULL;
+
+    pStmt->bind(id);
+    return pStmt->query();
+}
+
 //////////////////////////////////////////////////////////////////////////
 Database::~Database()
 {
@@ -152,7 +165,11 @@ bool Database::Initialize(const char * infoString, int nConns /*= 1*/, int nWork
             m_logsDir.append("/");
     }
 
+    m_infoString = infoString;
     m_pingIntervallms = sConfig.GetIntDefault ("MaxPingTime", 30) * (MINUTE * 1000);
+    m_asyncBatchSize = sConfig.GetIntDefault("AsyncBatchSize", 1);
+    if (m_asyncBatchSize < 1)
+        m_asyncBatchSize = 1;
 
     //create DB connections
 
@@ -227,12 +244,13 @@ bool Database::InitDelayThread(int i, std::string const& infoString)
     SqlConnection* threadConnection = CreateConnection();
     if(!threadConnection->Initialize(infoString.c_str()))
         return false;
+    // Created before the thread, which starts waiting on it right away
+    m_serialDelayQueue[i] = new SqlQueue();
+
     m_threadsBodies[i] = new SqlDelayThread(this, threadConnection, i);
     m_threadsBodies[i]->incReference();
     m_delayThreads[i] = new ACE_Based::Thread(m_threadsBodies[i]);
 
-    m_serialDelayQueue[i] = new SqlQueue();
-
     return true;
 }
 
@@ -242,8 +260,15 @@ void Database::HaltDelayThread()
         return;
 
     for (uint32 i = 0; i < m_numAsyncWorkers; ++i)
-    {
         m_threadsBodies[i]->Stop();
+    {
+        std::lock_guard<std::mutex> guard(m_delayWakeupLock);
+        m_stopDelayThreads = true;
+    }
+    m_delayWakeup.notify_all();
+
+    for (uint32 i = 0; i < m_numAsyncWorkers; ++i)
+    {
         m_delayThreads[i]->wait();
         delete m_delayThreads[i];
         m_threadsBodies[i]->decReference();
@@ -256,6 +281,7 @@ void Database::HaltDelayThread()
     m_threadsBodies = NULL;
     m_serialDelayQueue = NULL;
     m_numAsyncWorkers = 0;
+    m_stopDelayThreads = false;
 }
 
 void Database::ThreadStart()
@@ -288,6 +314,9 @@ void Database::escape_string(std::string& str)
 
 SqlConnection * Database::getQueryConnection()
 {
+    if (SqlConnection * pConn = m_threadConnection->m_pConn)
+        return pConn;
+
     int nCount = 0;
 
     if(m_nQueryCounter == long(1 << 31))
@@ -298,6 +327,28 @@ SqlConnection * Database::getQueryConnection()
     return m_pQueryConnections[nCount % m_nQueryConnPoolSize];
 }
 
+bool Database::OpenThreadConnection()
+{
+    if (m_threadConnection->m_pConn)
+        return true;
+
+    SqlConnection * pConn = CreateConnection();
+    if (!pConn->Initialize(m_infoString.c_str()))
+    {
+        delete pConn;
+        return false;
+    }
+
+    m_threadConnection->m_pConn = pConn;
+    return true;
+}
+
+void Database::CloseThreadConnection()
+{
+    delete m_threadConnection->m_pConn;
+    m_threadConnection->m_pConn = NULL;
+}
+
 void Database::Ping()
 {
     const char * sql = "SELECT 1";
@@ -552,7 +603,7 @@ void Database::AddToSerialDelayQueue(SqlOperation *op)
     // TODO: Load balance, must maintain mapping of serial ID so queries are
     // executed sequentially, however
     int worker = op->GetSerialId() % m_numAsyncWorkers;
-    m_serialDelayQueue[worker]->add(op);
+    AddToSerialDelayQueue(worker, op);
 }
 
 bool Database::NextSerialDelayedOperation(int workerId, SqlOperation*& op)
@@ -563,6 +614,45 @@ bool Database::NextSerialDelayedOperation(int workerId, SqlOperation*& op)
     return m_serialDelayQueue[workerId]->next(op);
 }
 
+void Database::NotifyDelayThreads(bool serial)
+{
+    {
+        // Taken so a worker can not miss the notification between its queue check and its wait
+        std::lock_guard<std::mutex> guard(m_delayWakeupLock);
+    }
+    // Serial operations can only be executed by their own worker, so wake them all
+    if (serial)
+        m_delayWakeup.notify_all();
+    else
+        m_delayWakeup.notify_one();
+}
+
+void Database::WaitForDelayedOperations(int workerId, uint32 timeoutMs)
+{
+    std::unique_lock<std::mutex> guard(m_delayWakeupLock);
+    m_delayWakeup.wait_for(guard, std::chrono::milliseconds(timeoutMs), [this, workerId]()
+    {
+        return m_stopDelayThreads || !m_delayQueue->empty() ||
+            (uint32(workerId) < m_numAsyncWorkers && !m_serialDelayQueue[workerId]->empty());
+    });
+}
+
+uint32 Database::GetDelayQueueSize()
+{
+    uint32 size = m_delayQueue->size();
+    for (uint32 i = 0; i < m_numAsyncWorkers && m_serialDelayQueue; ++i)
+        size += GetSerialDelayQueueSize(i);
+    return size;
+}
+
+uint32 Database::GetSerialDelayQueueSize(int workerId)
+{
+    if (uint32(workerId) >= m_numAsyncWorkers || !m_serialDelayQueue)
+        return 0;
+
+    return m_serialDelayQueue[workerId]->size();
+}
+
 bool Database::HasAsyncQuery()
 {
     bool hasQuery = !m_delayQueue->empty_unsafe();
@@ -664,6 +754,15 @@ bool Database::DirectExecuteStmt( const SqlStatementID& id, SqlStmtParameters *
     return _guard->ExecuteStmt(id.ID(), *params);
 }
 
+QueryResult* Database::QueryStmt(const SqlStatementID& id, SqlStmtParameters * params)
+{
+    MANGOS_ASSERT(params);
+    std::unique_ptr<SqlStmtParameters> p(params);
+    //statements are prepared per connection, the query one gets its own copy
+    SqlConnection::Lock _guard(getQueryConnection());
+    return _guard->QueryStmt(id.ID(), *params);
+}
+
 SqlStatement Database::CreateStatement(SqlStatementID& index, const char * fmt )
 {
     int nId = -1;
@@ -30,6 +30,8 @@
 #include <ace/TSS_T.h>
 #include <ace/Atomic_Op.h>
 #include "SqlPreparedStatement.h"
+#include <condition_variable>
+#include <mutex>
 
 class SqlTransaction;
 class SqlResultQueue;
@@ -67,9 +69,12 @@ class MANGOS_DLL_SPEC SqlConnection
         virtual bool CommitTransaction() { return true; }
         // can't rollback without transaction support
         virtual bool RollbackTransaction() { return true; }
+        // true if the server dropped the open transaction (deadlock, lock wait timeout, lost connection)
+        virtual bool IsTransactionAborted() const { return false; }
 
         //methods to work with prepared statements
         bool ExecuteStmt(int nIndex, const SqlStmtParameters& id);
+        QueryResult* QueryStmt(int nIndex, const SqlStmtParameters& id);
 
         //SqlConnection object lock
         class Lock
@@ -248,6 +253,10 @@ class MANGOS_DLL_SPEC Database
         // must be called before finish thread run (one time for thread using one from existing Database objects)
         virtual void ThreadEnd();
 
+        // Gives the calling thread its own connection for sync queries, instead of sharing the pool (eg. parallel startup loaders)
+        bool OpenThreadConnection();
+        void CloseThreadConnection();
+
         // set database-wide result queue. also we should use object-bases and not thread-based result queues
         void ProcessResultQueue(uint32 maxTime = 0);
 
@@ -261,12 +270,24 @@ class MANGOS_DLL_SPEC Database
         //you should call it explicitly after your server successfully started up
         //NO ASYNC TRANSACTIONS DURING SERVER STARTUP - ONLY DURING RUNTIME!!!
         void AllowAsyncTransactions() { m_bAllowAsyncTransactions = true; }
-        inline void AddToDelayQueue(SqlOperation* op) { m_delayQueue->add(op); }
+        inline void AddToDelayQueue(SqlOperation* op) { m_delayQueue->add(op); NotifyDelayThreads(false); }
         inline bool NextDelayedOperation(SqlOperation*& op) { return m_delayQueue->next(op); }
+        template<class Checker>
+        inline bool NextDelayedOperation(SqlOperation*& op, Checker& check) { return m_delayQueue->next(op, check); }
 
-        inline void AddToSerialDelayQueue(int workerId, SqlOperation *op) { m_serialDelayQueue[workerId]->add(op); }
+        inline void AddToSerialDelayQueue(int workerId, SqlOperation *op) { m_serialDelayQueue[workerId]->add(op); NotifyDelayThreads(true); }
         bool NextSerialDelayedOperation(int workerId, SqlOperation*& op);
 
+        // Blocks a delay thread until an operation is queued for it, the threads are halted, or 'timeoutMs' elapsed
+        void WaitForDelayedOperations(int workerId, uint32 timeoutMs);
+        // Operations waiting in the shared and serial delay queues
+        uint32 GetDelayQueueSize();
+        uint32 GetSerialDelayQueueSize(int workerId);
+        uint32 GetAsyncWorkersCount() const { return m_numAsyncWorkers; }
+        SqlDelayThread::Stats GetAsyncWorkerStats(int workerId) const { return m_threadsBodies[workerId]->GetStats(); }
+        // Max number of consecutive plain requests executed in one transaction by a delay thread
+        uint32 GetAsyncBatchSize() const { return m_asyncBatchSize; }
+
         bool HasAsyncQuery();
 
         void AddToSerialDelayQueue(SqlOperation *op);
@@ -275,8 +296,8 @@ class MANGOS_DLL_SPEC Database
         void StopServer();
     protected:
         Database() : m_pAsyncConn(NULL), m_pResultQueue(NULL), m_threadsBodies(NULL), m_delayThreads(NULL), m_numAsyncWorkers(0),
-            m_serialDelayQueue(NULL), m_delayQueue(new SqlQueue()), m_logSQL(false), m_pingIntervallms(0), m_nQueryConnPoolSize(1),
-            m_bAllowAsyncTransactions(false), m_iStmtIndex(-1)
+            m_serialDelayQueue(NULL), m_delayQueue(new SqlQueue()), m_stopDelayThreads(false), m_asyncBatchSize(1), m_logSQL(false),
+            m_pingIntervallms(0), m_nQueryConnPoolSize(1), m_bAllowAsyncTransactions(false), m_iStmtIndex(-1)
         {
             m_nQueryCounter = -1;
         }
@@ -309,9 +330,17 @@ class MANGOS_DLL_SPEC Database
         typedef ACE_TSS<Database::TransHelper> DBTransHelperTSS;
         Database::DBTransHelperTSS m_TransStorage;
 
+        //per-thread connection opened by OpenThreadConnection()
+        struct ThreadConnection
+        {
+            ThreadConnection() : m_pConn(NULL) {}
+            SqlConnection * m_pConn;
+        };
+        ACE_TSS<ThreadConnection> m_threadConnection;
+
         ///< DB connections
 
-        //round-robin connection selection
+        //thread connection if any, else round-robin connection selection
         SqlConnection * getQueryConnection();
         //for now return one single connection for async requests
         SqlConnection * getAsyncConnection() const { return m_pAsyncConn; }
@@ -321,6 +350,7 @@ class MANGOS_DLL_SPEC Database
         //query function for prepared statements
         bool ExecuteStmt(const SqlStatementID& id, SqlStmtParameters * params);
         bool DirectExecuteStmt(const SqlStatementID& id, SqlStmtParameters * params);
+        QueryResult* QueryStmt(const SqlStatementID& id, SqlStmtParameters * params);
 
         //connection helper counters
         int m_nQueryConnPoolSize;                               //current size of query connection pool
@@ -333,6 +363,14 @@ class MANGOS_DLL_SPEC Database
         SqlQueue* m_delayQueue;
         SqlQueue** m_serialDelayQueue; // simple mapping for worker ID -> serialized queue (only executed in set worker thread)
 
+        void NotifyDelayThreads(bool serial);
+
+        // Delay threads sleep on this until an operation is queued
+        std::mutex m_delayWakeupLock;
+        std::condition_variable m_delayWakeup;
+        bool m_stopDelayThreads;
+        uint32 m_asyncBatchSize;
+
         SqlConnection * m_pAsyncConn;
 
         SqlResultQueue *    m_pResultQueue;                  ///< Transaction queues from diff. threads
@@ -357,6 +395,7 @@ class MANGOS_DLL_SPEC Database
 
         bool m_logSQL;
         std::string m_logsDir;
+        std::string m_infoString;
         uint32 m_pingIntervallms;
 };
 #endif
@@ -285,6 +285,15 @@ bool MySQLConnection::Execute(const char* sql)
         sLog.outErrorDb( "SQL: %s", sql);
         sLog.outErrorDb("[%u] %s", lErrno, mysql_error(mMysql));
 
+        // The open transaction is gone: retrying alone would commit this statement
+        // without the ones before it, so let the caller decide
+        if (m_inTransaction && IsTransactionAbortError(lErrno))
+        {
+            m_transactionAborted = true;
+            HandleMySQLError(lErrno);
+            return false;
+        }
+
         if (HandleMySQLError(lErrno)) // If error is handled, just try again
             return Execute(sql);
         return false;
@@ -312,18 +321,38 @@ bool MySQLConnection::_TransactionCmd(const char *sql)
     return true;
 }
 
+bool MySQLConnection::IsTransactionAbortError(uint32 errNo)
+{
+    switch (errNo)
+    {
+        case CR_SERVER_GONE_ERROR:
+        case CR_SERVER_LOST:
+        case CR_INVALID_CONN_HANDLE:
+        case CR_SERVER_LOST_EXTENDED:
+        case ER_LOCK_DEADLOCK:
+        case ER_LOCK_WAIT_TIMEOUT:                          // the caller rolls back the rest of the transaction
+            return true;
+        default:
+            return false;
+    }
+}
+
 bool MySQLConnection::BeginTransaction()
 {
-    return _TransactionCmd("START TRANSACTION");
+    m_transactionAborted = false;
+    m_inTransaction = _TransactionCmd("START TRANSACTION");
+    return m_inTransaction;
 }
 
 bool MySQLConnection::CommitTransaction()
 {
+    m_inTransaction = false;
     return _TransactionCmd("COMMIT");
 }
 
 bool MySQLConnection::RollbackTransaction()
 {
+    m_inTransaction = false;
     return _TransactionCmd("ROLLBACK");
 }
 
@@ -405,7 +434,9 @@ bool MySqlPreparedStatement::prepare()
         /* Get total columns in the query */
         m_nColumns = mysql_num_fields(m_pResultMetadata);
 
-        //bind output buffers
+        //output buffers are bound per result set, string buffers are sized from max_length
+        my_bool updateMaxLength = 1;
+        mysql_stmt_attr_set(m_stmt, STMT_ATTR_UPDATE_MAX_LENGTH, &updateMaxLength);
     }
 
     m_bPrepared = true;
@@ -501,6 +532,32 @@ bool MySqlPreparedStatement::execute()
     return true;
 }
 
+QueryResult* MySqlPreparedStatement::query()
+{
+    if(!isPrepared() || !isQuery())
+        return NULL;
+
+    if(!execute())
+        return NULL;
+
+    if(mysql_stmt_store_result(m_stmt))
+    {
+        sLog.outError("SQL: cannot store result of '%s'", m_szFmt.c_str());
+        sLog.outError("SQL ERROR: %s", mysql_stmt_error(m_stmt));
+        return NULL;
+    }
+
+    if(!mysql_stmt_num_rows(m_stmt))
+    {
+        mysql_stmt_free_result(m_stmt);
+        return NULL;
+    }
+
+    QueryResultMysqlStmt* queryResult = new QueryResultMysqlStmt(m_stmt, m_pResultMetadata, m_nColumns);
+    queryResult->NextRow();
+    return queryResult;
+}
+
 enum_field_types MySqlPreparedStatement::ToMySQLType( const SqlStmtFieldData &data, my_bool &bUnsigned )
 {
     bUnsigned = 0;
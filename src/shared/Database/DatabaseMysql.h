@@ -53,6 +53,9 @@ public:
     //execute DML statement
     virtual bool execute();
 
+    //execute SELECT statement, result set is fetched with the binary protocol
+    virtual QueryResult* query();
+
 protected:
     //bind parameters
     void addParam(int nIndex, const SqlStmtFieldData& data);
@@ -72,7 +75,7 @@ private:
 class MANGOS_DLL_SPEC MySQLConnection : public SqlConnection
 {
     public:
-        MySQLConnection(Database& db) : SqlConnection(db), mMysql(NULL) {}
+        MySQLConnection(Database& db) : SqlConnection(db), mMysql(NULL), m_inTransaction(false), m_transactionAborted(false) {}
         ~MySQLConnection();
 
         bool OpenConnection(bool reconnect);
@@ -88,15 +91,19 @@ class MANGOS_DLL_SPEC MySQLConnection : public SqlConnection
         bool BeginTransaction();
         bool CommitTransaction();
         bool RollbackTransaction();
+        bool IsTransactionAborted() const { return m_transactionAborted; }
 
     protected:
         SqlPreparedStatement * CreateStatement(const std::string& fmt);
 
     private:
         bool _TransactionCmd(const char *sql);
+        static bool IsTransactionAbortError(uint32 errNo);
         bool _Query(const char *sql, MYSQL_RES **pResult, MYSQL_FIELD **pFields, uint64* pRowCount, uint32* pFieldCount);
 
         MYSQL *mMysql;
+        bool m_inTransaction;
+        bool m_transactionAborted;
 };
 
 class MANGOS_DLL_SPEC DatabaseMysql : public Database
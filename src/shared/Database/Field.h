@@ -23,6 +23,7 @@
 #define FIELD_H
 
 #include "Common.h"
+#include <cfloat>
 
 class Field
 {
@@ -37,28 +38,39 @@ class Field
             DB_TYPE_BOOL    = 0x04
         };
 
-        Field() : mValue(NULL), mType(DB_TYPE_UNKNOWN) {}
-        Field(const char* value, enum DataTypes type) : mValue(value), mType(type) {}
+        Field() : mValue(NULL), mInt(0), mType(DB_TYPE_UNKNOWN), mBinary(false), mUnsigned(false), mDigits(DBL_DIG) {}
+        Field(const char* value, enum DataTypes type) : mValue(value), mInt(0), mType(type), mBinary(false), mUnsigned(false), mDigits(DBL_DIG) {}
 
         ~Field() {}
 
         enum DataTypes GetType() const { return mType; }
-        bool IsNULL() const { return mValue == NULL; }
+        bool IsNULL() const { return !mBinary && mValue == NULL; }
 
-        const char *GetString() const { return mValue; }
+        // binary numeric fields (prepared statement results) are formatted on demand, valid until the next row
+        const char *GetString() const { return mBinary ? FormatBinary() : mValue; }
         std::string GetCppString() const
         {
+            if (mBinary)
+                return FormatBinary();
             return mValue ? mValue : "";                    // std::string s = 0 have undefine result in C++
         }
-        float GetFloat() const { return mValue ? static_cast<float>(atof(mValue)) : 0.0f; }
-        bool GetBool() const { return mValue ? atoi(mValue) > 0 : false; }
-        int32 GetInt32() const { return mValue ? static_cast<int32>(atol(mValue)) : int32(0); }
-        uint8 GetUInt8() const { return mValue ? static_cast<uint8>(atol(mValue)) : uint8(0); }
-        uint16 GetUInt16() const { return mValue ? static_cast<uint16>(atol(mValue)) : uint16(0); }
-        int16 GetInt16() const { return mValue ? static_cast<int16>(atol(mValue)) : int16(0); }
-        uint32 GetUInt32() const { return mValue ? static_cast<uint32>(atol(mValue)) : uint32(0); }
+        float GetFloat() const
+        {
+            if (mBinary)
+                return mType == DB_TYPE_FLOAT ? static_cast<float>(mFloat) : static_cast<float>(mInt);
+            return mValue ? static_cast<float>(atof(mValue)) : 0.0f;
+        }
+        bool GetBool() const { return mBinary ? GetBinaryInt() > 0 : (mValue ? atoi(mValue) > 0 : false); }
+        int32 GetInt32() const { return mBinary ? static_cast<int32>(GetBinaryInt()) : (mValue ? static_cast<int32>(atol(mValue)) : int32(0)); }
+        uint8 GetUInt8() const { return mBinary ? static_cast<uint8>(GetBinaryInt()) : (mValue ? static_cast<uint8>(atol(mValue)) : uint8(0)); }
+        uint16 GetUInt16() const { return mBinary ? static_cast<uint16>(GetBinaryInt()) : (mValue ? static_cast<uint16>(atol(mValue)) : uint16(0)); }
+        int16 GetInt16() const { return mBinary ? static_cast<int16>(GetBinaryInt()) : (mValue ? static_cast<int16>(atol(mValue)) : int16(0)); }
+        uint32 GetUInt32() const { return mBinary ? static_cast<uint32>(GetBinaryInt()) : (mValue ? static_cast<uint32>(atol(mValue)) : uint32(0)); }
         uint64 GetUInt64() const
         {
+            if (mBinary)
+                return static_cast<uint64>(GetBinaryInt());
+
             uint64 value = 0;
             if(!mValue || sscanf(mValue,UI64FMTD,&value) == -1)
                 return 0;
@@ -69,13 +81,41 @@ class Field
         void SetType(enum DataTypes type) { mType = type; }
         //no need for memory allocations to store resultset field strings
         //all we need is to cache pointers returned by different DBMS APIs
-        void SetValue(const char* value) { mValue = value; };
+        void SetValue(const char* value) { mValue = value; mBinary = false; }
+        //typed values from binary protocol result sets, read back without any conversion
+        //unsigned 64 bits columns are stored with the same bit pattern
+        void SetInt64(int64 value) { mInt = value; mValue = NULL; mBinary = true; }
+        void SetDouble(double value) { mFloat = value; mValue = NULL; mBinary = true; }
+        //how GetString() prints binary values of this column, as the text protocol does
+        void SetBinaryFormat(bool isUnsigned, uint8 digits) { mUnsigned = isUnsigned; mDigits = digits; }
 
     private:
         Field(Field const&);
         Field& operator=(Field const&);
 
+        int64 GetBinaryInt() const { return mType == DB_TYPE_FLOAT ? static_cast<int64>(mFloat) : mInt; }
+
+        const char* FormatBinary() const
+        {
+            if (mType == DB_TYPE_FLOAT)
+                snprintf(mText, sizeof(mText), "%.*g", int(mDigits), mFloat);
+            else if (mUnsigned)
+                snprintf(mText, sizeof(mText), UI64FMTD, static_cast<uint64>(mInt));
+            else
+                snprintf(mText, sizeof(mText), SI64FMTD, mInt);
+            return mText;
+        }
+
         const char* mValue;
+        union
+        {
+            int64 mInt;
+            double mFloat;
+        };
         enum DataTypes mType;
+        bool mBinary;
+        bool mUnsigned;
+        uint8 mDigits;
+        mutable char mText[32];
 };
 #endif
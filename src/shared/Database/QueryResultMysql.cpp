@@ -24,6 +24,8 @@
 #include "DatabaseEnv.h"
 #include "Errors.h"
 
+#include <memory>
+
 QueryResultMysql::QueryResultMysql(MYSQL_RES *result, MYSQL_FIELD *fields, uint64 rowCount, uint32 fieldCount) :
     QueryResult(rowCount, fieldCount), mResult(result)
 {
@@ -75,7 +77,7 @@ void QueryResultMysql::EndQuery()
     }
 }
 
-enum Field::DataTypes QueryResultMysql::ConvertNativeType(enum_field_types mysqlType) const
+enum Field::DataTypes QueryResultMysql::ConvertNativeType(enum_field_types mysqlType)
 {
     switch (mysqlType)
     {
@@ -105,4 +107,155 @@ enum Field::DataTypes QueryResultMysql::ConvertNativeType(enum_field_types mysql
             return Field::DB_TYPE_UNKNOWN;
     }
 }
+
+//////////////////////////////////////////////////////////////////////////
+QueryResultMysqlStmt::QueryResultMysqlStmt(MYSQL_STMT *stmt, MYSQL_RES *metadata, uint32 fieldCount) :
+    QueryResult(mysql_stmt_num_rows(stmt), fieldCount), mNextRow(0)
+{
+    mCurrentRow = new Field[mFieldCount];
+    MANGOS_ASSERT(mCurrentRow);
+
+    //max_length is filled by mysql_stmt_store_result() (STMT_ATTR_UPDATE_MAX_LENGTH)
+    MYSQL_FIELD *fields = mysql_fetch_fields(metadata);
+
+    std::vector<MYSQL_BIND> binds(mFieldCount);
+    std::vector<int64> intBuffers(mFieldCount);
+    std::vector<double> floatBuffers(mFieldCount);
+    std::vector<std::vector<char> > strBuffers(mFieldCount);
+    std::vector<unsigned long> lengths(mFieldCount);
+    std::unique_ptr<my_bool[]> nulls(new my_bool[mFieldCount]);
+    memset(&binds[0], 0, sizeof(MYSQL_BIND) * mFieldCount);
+
+    for (uint32 i = 0; i < mFieldCount; ++i)
+    {
+        //enum values are bound as their name, integers would be the index
+        Field::DataTypes type = ConvertNativeType(fields[i].type);
+        if (fields[i].type == FIELD_TYPE_ENUM || (fields[i].flags & ENUM_FLAG))
+            type = Field::DB_TYPE_STRING;
+        mCurrentRow[i].SetType(type);
+        mCurrentRow[i].SetBinaryFormat((fields[i].flags & UNSIGNED_FLAG) != 0, fields[i].type == FIELD_TYPE_FLOAT ? FLT_DIG : DBL_DIG);
+
+        MYSQL_BIND& bind = binds[i];
+        bind.is_null = &nulls[i];
+        bind.length = &lengths[i];
+
+        //let the client library convert to the widest type, so any column width fits
+        switch (type)
+        {
+            case Field::DB_TYPE_INTEGER:
+                bind.buffer_type = MYSQL_TYPE_LONGLONG;
+                bind.buffer = &intBuffers[i];
+                bind.is_unsigned = (fields[i].flags & UNSIGNED_FLAG) ? 1 : 0;
+                break;
+            case Field::DB_TYPE_FLOAT:
+                bind.buffer_type = MYSQL_TYPE_DOUBLE;
+                bind.buffer = &floatBuffers[i];
+                break;
+            default:
+                strBuffers[i].resize(fields[i].max_length + 1);
+                bind.buffer_type = MYSQL_TYPE_STRING;
+                bind.buffer = &strBuffers[i][0];
+                bind.buffer_length = strBuffers[i].size();
+                break;
+        }
+    }
+
+    if (mysql_stmt_bind_result(stmt, &binds[0]))
+    {
+        sLog.outError("SQL ERROR: mysql_stmt_bind_result() failed");
+        sLog.outError("SQL ERROR: %s", mysql_stmt_error(stmt));
+        mRowCount = 0;
+    }
+
+    mCells.reserve(mRowCount * mFieldCount);
+    for (uint64 row = 0; row < mRowCount; ++row)
+    {
+        int res = mysql_stmt_fetch(stmt);
+        if (res == MYSQL_NO_DATA || res == 1)
+        {
+            if (res == 1)
+                sLog.outError("SQL ERROR: mysql_stmt_fetch() failed: %s", mysql_stmt_error(stmt));
+            mRowCount = row;
+            break;
+        }
+
+        for (uint32 i = 0; i < mFieldCount; ++i)
+        {
+            Cell cell;
+            cell.intValue = 0;
+            cell.isNull = nulls[i] != 0;
+
+            if (!cell.isNull)
+            {
+                switch (mCurrentRow[i].GetType())
+                {
+                    case Field::DB_TYPE_INTEGER:
+                        cell.intValue = intBuffers[i];
+                        break;
+                    case Field::DB_TYPE_FLOAT:
+                        cell.floatValue = floatBuffers[i];
+                        break;
+                    default:
+                    {
+                        unsigned long length = std::min<unsigned long>(lengths[i], strBuffers[i].size() - 1);
+                        cell.strOffset = mStrings.size();
+                        mStrings.insert(mStrings.end(), strBuffers[i].begin(), strBuffers[i].begin() + length);
+                        mStrings.push_back('\0');
+                        break;
+                    }
+                }
+            }
+
+            mCells.push_back(cell);
+        }
+    }
+
+    mysql_stmt_free_result(stmt);
+}
+
+QueryResultMysqlStmt::~QueryResultMysqlStmt()
+{
+    EndQuery();
+}
+
+bool QueryResultMysqlStmt::NextRow()
+{
+    if (!mCurrentRow)
+        return false;
+
+    if (mNextRow >= mRowCount)
+    {
+        EndQuery();
+        return false;
+    }
+
+    Cell const* row = &mCells[mNextRow * mFieldCount];
+    for (uint32 i = 0; i < mFieldCount; ++i)
+    {
+        Field& field = mCurrentRow[i];
+        if (row[i].isNull)
+            field.SetValue(NULL);
+        else if (field.GetType() == Field::DB_TYPE_INTEGER)
+            field.SetInt64(row[i].intValue);
+        else if (field.GetType() == Field::DB_TYPE_FLOAT)
+            field.SetDouble(row[i].floatValue);
+        else
+            field.SetValue(&mStrings[row[i].strOffset]);
+    }
+
+    ++mNextRow;
+    return true;
+}
+
+void QueryResultMysqlStmt::EndQuery()
+{
+    if (mCurrentRow)
+    {
+        delete [] mCurrentRow;
+        mCurrentRow = 0;
+    }
+
+    std::vector<Cell>().swap(mCells);
+    std::vector<char>().swap(mStrings);
+}
 #endif
@@ -42,11 +42,43 @@ class QueryResultMysql : public QueryResult
 
         bool NextRow();
 
+        static enum Field::DataTypes ConvertNativeType(enum_field_types mysqlType);
+
     private:
-        enum Field::DataTypes ConvertNativeType(enum_field_types mysqlType) const;
         void EndQuery();
 
         MYSQL_RES *mResult;
 };
+
+//result set of a prepared statement, fetched with the binary protocol
+//numeric columns are stored typed, so Field getters do not parse any text
+//all rows are copied out of the statement: it can be reused as soon as the connection is released
+class QueryResultMysqlStmt : public QueryResult
+{
+    public:
+        QueryResultMysqlStmt(MYSQL_STMT *stmt, MYSQL_RES *metadata, uint32 fieldCount);
+
+        ~QueryResultMysqlStmt();
+
+        bool NextRow();
+
+    private:
+        struct Cell
+        {
+            union
+            {
+                int64 intValue;
+                double floatValue;
+                uint32 strOffset;
+            };
+            bool isNull;
+        };
+
+        void EndQuery();
+
+        std::vector<Cell> mCells;
+        std::vector<char> mStrings;
+        uint64 mNextRow;
+};
 #endif
 #endif
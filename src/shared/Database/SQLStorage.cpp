@@ -120,6 +120,387 @@ void SQLStorageBase::Free()
     m_recordCount = 0;
 }
 
+// -----------------------------------  Snapshots  -------------------------------------------- //
+
+std::string SQLStorageBase::m_snapshotDirectory;
+SQLSnapshotKeyMode SQLStorageBase::m_snapshotKeyMode = SNAPSHOT_KEY_VERSION;
+
+#define SNAPSHOT_MAGIC      0x534C5153                      // 'SQLS'
+#define SNAPSHOT_VERSION    2
+
+struct SQLStorageSnapshotHeader
+{
+    uint32 magic;
+    uint32 version;
+    uint32 pointerSize;                                     // records layout depends on it
+    uint32 formatHash;                                      // storage formats, or query for rows snapshots
+    uint64 content;
+    uint32 variant;
+    uint32 salt;
+    uint32 keyMode;
+    uint32 recordSize;
+    uint32 maxEntry;
+    uint32 recordCount;
+    uint32 stringsSize;
+};
+// followed by record ids, records, and null terminated strings of every string field in record order.
+// Rows snapshots only have the records.
+
+// FNV-1a
+static uint32 HashSnapshotText(uint32 hash, char const* text)
+{
+    for (char const* c = text; *c; ++c)
+        hash = (hash ^ uint8(*c)) * 16777619u;
+    return hash;
+}
+
+static void AddSnapshotKeyValue(uint64& hash, std::string const& value)
+{
+    // FNV-1a, values separated by a 0
+    for (char c : value)
+        hash = (hash ^ uint8(c)) * 1099511628211ull;
+    hash *= 1099511628211ull;
+}
+
+static void InitSnapshotHeader(SQLStorageSnapshotHeader& header, uint32 formatHash, SQLStorageSnapshotKey const& key, SQLSnapshotKeyMode keyMode)
+{
+    memset(&header, 0, sizeof(header));
+    header.magic = SNAPSHOT_MAGIC;
+    header.version = SNAPSHOT_VERSION;
+    header.pointerSize = sizeof(char*);
+    header.formatHash = formatHash;
+    header.content = key.content;
+    header.variant = key.variant;
+    header.salt = key.salt;
+    header.keyMode = keyMode;
+}
+
+// Reads the whole file, and its header if it was built with 'formatHash' from the 'key' content
+static bool ReadSnapshotFile(std::string const& fileName, uint32 formatHash, SQLStorageSnapshotKey const& key, SQLSnapshotKeyMode keyMode,
+                             SQLStorageSnapshotHeader& header, std::vector<char>& buffer)
+{
+    FILE* file = fopen(fileName.c_str(), "rb");
+    if (!file)
+        return false;
+
+    if (!fseek(file, 0, SEEK_END))
+    {
+        long size = ftell(file);
+        if (size > 0 && !fseek(file, 0, SEEK_SET))
+        {
+            buffer.resize(size);
+            if (fread(buffer.data(), size, 1, file) != 1)
+                buffer.clear();
+        }
+    }
+    fclose(file);
+
+    if (buffer.size() < sizeof(SQLStorageSnapshotHeader))
+        return false;
+
+    SQLStorageSnapshotHeader expected;
+    InitSnapshotHeader(expected, formatHash, key, keyMode);
+    memcpy(&header, buffer.data(), sizeof(header));
+    return header.magic == expected.magic && header.version == expected.version && header.pointerSize == expected.pointerSize &&
+           header.formatHash == expected.formatHash && header.content == expected.content && header.variant == expected.variant &&
+           header.salt == expected.salt && header.keyMode == expected.keyMode;
+}
+
+// Written aside then renamed, a crash never leaves a partial snapshot
+static void WriteSnapshotFile(char const* name, std::string const& fileName, SQLStorageSnapshotHeader const& header,
+                              std::initializer_list<std::pair<void const*, size_t> > parts)
+{
+    std::string tmpFileName = fileName + ".tmp";
+    FILE* file = fopen(tmpFileName.c_str(), "wb");
+    if (!file)
+    {
+        sLog.outError("Can not write %s snapshot to '%s'.", name, tmpFileName.c_str());
+        return;
+    }
+
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1;
+    for (auto const& part : parts)
+        if (part.second)
+            written = written && fwrite(part.first, part.second, 1, file) == 1;
+    written = (fclose(file) == 0) && written;
+
+    remove(fileName.c_str());
+    if (!written || rename(tmpFileName.c_str(), fileName.c_str()) != 0)
+    {
+        sLog.outError("Can not write %s snapshot to '%s'.", name, fileName.c_str());
+        remove(tmpFileName.c_str());
+    }
+}
+
+void SQLStorageBase::SetSnapshotDirectory(std::string const& directory, SQLSnapshotKeyMode keyMode)
+{
+    m_snapshotDirectory = directory;
+    if (!m_snapshotDirectory.empty() && m_snapshotDirectory.back() != '/' && m_snapshotDirectory.back() != '\\')
+        m_snapshotDirectory.append("/");
+    m_snapshotKeyMode = keyMode;
+}
+
+std::string SQLStorageBase::GetSnapshotFileName() const
+{
+    return m_snapshotDirectory + m_tableName + ".snapshot";
+}
+
+uint32 SQLStorageBase::GetFormatHash() const
+{
+    return HashSnapshotText(HashSnapshotText(HashSnapshotText(2166136261u, m_src_format), "|"), m_dst_format);
+}
+
+void SQLStorageBase::GetStringFieldOffsets(std::vector<uint32>& offsets) const
+{
+    uint32 offset = 0;
+    for (uint32 x = 0; x < m_dstFieldCount; ++x)
+    {
+        switch (m_dst_format[x])
+        {
+            case FT_LOGIC:
+                offset += sizeof(bool);
+                break;
+            case FT_STRING:
+            case FT_NA_POINTER:
+                offsets.push_back(offset);
+                offset += sizeof(char*);
+                break;
+            case FT_NA:
+            case FT_INT:
+                offset += sizeof(uint32);
+                break;
+            case FT_BYTE:
+            case FT_NA_BYTE:
+                offset += sizeof(char);
+                break;
+            case FT_FLOAT:
+            case FT_NA_FLOAT:
+                offset += sizeof(float);
+                break;
+            case FT_64BITINT:
+                offset += sizeof(uint64);
+                break;
+            default:
+                assert(false && "unknown format character");
+                break;
+        }
+    }
+}
+
+bool SQLStorageBase::PrepareTablesSnapshotKey(SQLStorageSnapshotKey& key, std::vector<char const*> const& tables, uint32 variant, uint32 salt)
+{
+    if (m_snapshotDirectory.empty())
+        return false;
+
+    std::string tableList;
+    for (char const* table : tables)
+    {
+        if (!tableList.empty())
+            tableList.append(m_snapshotKeyMode == SNAPSHOT_KEY_CHECKSUM ? ", " : "', '");
+        tableList.append(table);
+    }
+
+    uint64 content = 14695981039346656037ull;
+    uint32 found = 0;
+    if (m_snapshotKeyMode == SNAPSHOT_KEY_CHECKSUM)
+    {
+        QueryResult* result = WorldDatabase.PQuery("CHECKSUM TABLE %s", tableList.c_str());
+        if (!result)
+            return false;
+
+        do
+        {
+            Field* fields = result->Fetch();
+            if (fields[1].IsNULL())                         // missing table
+                break;
+            AddSnapshotKeyValue(content, fields[1].GetCppString());
+            ++found;
+        }
+        while (result->NextRow());
+        delete result;
+    }
+    else
+    {
+        // Any migration changes the key. Creation time and row count also catch tables reimported or
+        // edited by hand: InnoDB does not keep the update time over a MySQL restart.
+        QueryResult* result = WorldDatabase.Query("SELECT COUNT(*), MAX(id) FROM migrations");
+        if (!result)
+            return false;
+        AddSnapshotKeyValue(content, (*result)[0].GetCppString());
+        AddSnapshotKeyValue(content, (*result)[1].GetCppString());
+        delete result;
+
+        result = WorldDatabase.PQuery("SELECT CREATE_TIME, UPDATE_TIME, TABLE_ROWS FROM information_schema.TABLES "
+                                      "WHERE TABLE_SCHEMA = DATABASE() AND TABLE_NAME IN ('%s') ORDER BY TABLE_NAME", tableList.c_str());
+        if (!result)
+            return false;
+
+        do
+        {
+            Field* fields = result->Fetch();
+            for (uint32 i = 0; i < 3; ++i)
+                AddSnapshotKeyValue(content, fields[i].GetCppString());
+            ++found;
+        }
+        while (result->NextRow());
+        delete result;
+    }
+
+    key.content = content;
+    key.variant = variant;
+    key.salt = salt;
+    return found == tables.size();
+}
+
+bool SQLStorageBase::PrepareSnapshotKey(SQLStorageSnapshotKey& key, uint32 variant, uint32 salt) const
+{
+    return PrepareTablesSnapshotKey(key, { m_tableName }, variant, salt);
+}
+
+bool SQLStorageBase::LoadSnapshot(SQLStorageSnapshotKey const& key)
+{
+    SQLStorageSnapshotHeader header;
+    std::vector<char> buffer;
+    if (!ReadSnapshotFile(GetSnapshotFileName(), GetFormatHash(), key, m_snapshotKeyMode, header, buffer))
+        return false;
+
+    uint64 idsSize = uint64(header.recordCount) * sizeof(uint32);
+    uint64 recordsSize = uint64(header.recordCount) * header.recordSize;
+    if (buffer.size() != sizeof(header) + idsSize + recordsSize + header.stringsSize)
+        return false;
+
+    char const* ids = buffer.data() + sizeof(header);
+    char const* records = ids + idsSize;
+    char const* strings = records + recordsSize;
+    char const* stringsEnd = strings + header.stringsSize;
+
+    for (uint32 i = 0; i < header.recordCount; ++i)
+    {
+        uint32 recordId;
+        memcpy(&recordId, ids + i * sizeof(uint32), sizeof(uint32));
+        if (recordId >= header.maxEntry)
+            return false;
+    }
+
+    std::vector<uint32> stringOffsets;
+    GetStringFieldOffsets(stringOffsets);
+
+    prepareToLoad(header.maxEntry, header.recordCount, header.recordSize);
+    if (header.recordCount)
+        memcpy(m_data, records, recordsSize);
+
+    // Strings are owned by the records, and freed one by one
+    char const* nextString = strings;
+    for (uint32 i = 0; i < header.recordCount; ++i)
+    {
+        uint32 recordId;
+        memcpy(&recordId, ids + i * sizeof(uint32), sizeof(uint32));
+        char* record = createRecord(recordId);
+
+        for (uint32 offset : stringOffsets)
+        {
+            char const* end = nextString < stringsEnd ? (char const*)memchr(nextString, 0, stringsEnd - nextString) : nullptr;
+            char* value = end ? new char[end - nextString + 1] : nullptr;
+            if (value)
+                memcpy(value, nextString, end - nextString + 1);
+            memcpy(record + offset, &value, sizeof(char*));
+            nextString = end ? end + 1 : stringsEnd;
+        }
+    }
+
+    // Truncated strings (records with null strings), drop everything
+    bool valid = nextString == stringsEnd;
+    for (uint32 i = 0; valid && i < m_recordCount; ++i)
+        for (uint32 offset : stringOffsets)
+            if (!*(char**)(m_data + i * m_recordSize + offset))
+                valid = false;
+
+    if (!valid)
+    {
+        sLog.outError("Snapshot of %s table is corrupted, loading from database.", m_tableName);
+        Free();
+        return false;
+    }
+
+    sLog.outString("%s: %u records loaded from snapshot", m_tableName, m_recordCount);
+    return true;
+}
+
+void SQLStorageBase::SaveSnapshot(SQLStorageSnapshotKey const& key, std::vector<uint32> const& recordIds) const
+{
+    MANGOS_ASSERT(recordIds.size() == m_recordCount);
+
+    std::vector<uint32> stringOffsets;
+    GetStringFieldOffsets(stringOffsets);
+
+    std::string strings;
+    for (uint32 i = 0; i < m_recordCount; ++i)
+    {
+        for (uint32 offset : stringOffsets)
+        {
+            char const* value = *(char**)(m_data + i * m_recordSize + offset);
+            strings.append(value ? value : "");
+            strings.push_back('\0');
+        }
+    }
+
+    SQLStorageSnapshotHeader header;
+    InitSnapshotHeader(header, GetFormatHash(), key, m_snapshotKeyMode);
+    header.recordSize = m_recordSize;
+    header.maxEntry = m_maxEntry;
+    header.recordCount = m_recordCount;
+    header.stringsSize = strings.size();
+
+    WriteSnapshotFile(m_tableName, GetSnapshotFileName(), header,
+    {
+        { recordIds.data(), size_t(m_recordCount) * sizeof(uint32) },
+        { m_data, size_t(m_recordCount) * m_recordSize },
+        { strings.data(), strings.size() }
+    });
+}
+
+// -----------------------------------  SQLRowsSnapshot  --------------------------------------- //
+
+SQLRowsSnapshot::SQLRowsSnapshot(char const* name, std::vector<char const*> const& tables, char const* query) :
+    m_name(name), m_queryHash(HashSnapshotText(2166136261u, query))
+{
+    m_enabled = SQLStorageBase::PrepareTablesSnapshotKey(m_key, tables, 0, 0);
+}
+
+bool SQLRowsSnapshot::LoadRows(uint32 rowSize, std::vector<char>& rows) const
+{
+    if (!m_enabled)
+        return false;
+
+    SQLStorageSnapshotHeader header;
+    std::vector<char> buffer;
+    if (!ReadSnapshotFile(SQLStorageBase::m_snapshotDirectory + m_name + ".snapshot", m_queryHash, m_key, SQLStorageBase::m_snapshotKeyMode, header, buffer))
+        return false;
+
+    if (header.recordSize != rowSize || buffer.size() != sizeof(header) + uint64(header.recordCount) * rowSize)
+        return false;
+
+    rows.assign(buffer.begin() + sizeof(header), buffer.end());
+    sLog.outString("%s: %u rows loaded from snapshot", m_name.c_str(), header.recordCount);
+    return true;
+}
+
+void SQLRowsSnapshot::SaveRows(void const* rows, uint32 rowSize, uint32 rowCount) const
+{
+    if (!m_enabled)
+        return;
+
+    SQLStorageSnapshotHeader header;
+    InitSnapshotHeader(header, m_queryHash, m_key, SQLStorageBase::m_snapshotKeyMode);
+    header.recordSize = rowSize;
+    header.recordCount = rowCount;
+
+    WriteSnapshotFile(m_name.c_str(), SQLStorageBase::m_snapshotDirectory + m_name + ".snapshot", header,
+    {
+        { rows, size_t(rowCount) * rowSize }
+    });
+}
+
 // -----------------------------------  SQLStorage  -------------------------------------------- //
 
 void SQLStorage::EraseEntry(uint32 id)
@@ -23,9 +23,25 @@
 #include "Database/DatabaseEnv.h"
 #include "DBCFileLoader.h"
 
+// How a snapshot is known to match its source tables (WorldDatabase.SnapshotKey)
+enum SQLSnapshotKeyMode
+{
+    SNAPSHOT_KEY_VERSION    = 0,                            // applied world migrations, tables creation/update time and row count
+    SNAPSHOT_KEY_CHECKSUM   = 1,                            // CHECKSUM TABLE: exact, but reads every row of the tables
+};
+
+// Identifies the content a snapshot was built from
+struct SQLStorageSnapshotKey
+{
+    uint64 content;                                         // hash of the source tables state, see SQLSnapshotKeyMode
+    uint32 variant;                                         // 0 for Load, wow patch + 1 for LoadProgressive
+    uint32 salt;                                            // loader specific (ie. script names for script ids)
+};
+
 class SQLStorageBase
 {
         template<class DerivedLoader, class StorageClass> friend class SQLStorageLoaderBase;
+        friend class SQLRowsSnapshot;
 
     public:
         char const* GetTableName() const { return m_tableName; }
@@ -39,6 +55,10 @@ class SQLStorageBase
         uint32 GetMaxEntry() const { return m_maxEntry; };
         uint32 GetRecordCount() const { return m_recordCount; };
 
+        // Loaded records are saved in this directory, and loaded back instead of the table
+        // while the table content does not change. Empty disables snapshots.
+        static void SetSnapshotDirectory(std::string const& directory, SQLSnapshotKeyMode keyMode);
+
         template<typename T>
         class SQLSIterator
         {
@@ -80,9 +100,23 @@ class SQLStorageBase
         virtual void JustCreatedRecord(uint32 recordId, char* record) = 0;
         virtual void Free();
 
+        bool PrepareSnapshotKey(SQLStorageSnapshotKey& key, uint32 variant, uint32 salt) const;
+        bool LoadSnapshot(SQLStorageSnapshotKey const& key);
+        void SaveSnapshot(SQLStorageSnapshotKey const& key, std::vector<uint32> const& recordIds) const;
+
     private:
         char* createRecord(uint32 recordId);
 
+        std::string GetSnapshotFileName() const;
+        uint32 GetFormatHash() const;
+        void GetStringFieldOffsets(std::vector<uint32>& offsets) const;
+
+        // Fills 'key' with the current state of 'tables', false if one of them is missing
+        static bool PrepareTablesSnapshotKey(SQLStorageSnapshotKey& key, std::vector<char const*> const& tables, uint32 variant, uint32 salt);
+
+        static std::string m_snapshotDirectory;
+        static SQLSnapshotKeyMode m_snapshotKeyMode;
+
         // Information about the table
         const char* m_tableName;
         const char* m_entry_field;
@@ -247,6 +281,42 @@ class SQLMultiStorage : public SQLStorageBase
         RecordMultiMap m_indexMultiMap;
 };
 
+// Snapshot of the rows read by a loader outside of SQLStorage (ie. creature and gameobject spawns).
+// Rows are saved as read, before checks and fixes, and are flat records: no pointer.
+class SQLRowsSnapshot
+{
+    public:
+        // 'tables' are all the tables the rows are read from, 'query' the query reading them
+        SQLRowsSnapshot(char const* name, std::vector<char const*> const& tables, char const* query);
+
+        // False when snapshots are disabled or the snapshot is missing or outdated:
+        // the rows are then read from the database, and given to Save.
+        template<class T>
+        bool Load(std::vector<T>& rows) const
+        {
+            std::vector<char> buffer;
+            if (!LoadRows(sizeof(T), buffer))
+                return false;
+
+            rows.resize(buffer.size() / sizeof(T));
+            if (!rows.empty())
+                memcpy(rows.data(), buffer.data(), buffer.size());
+            return true;
+        }
+
+        template<class T>
+        void Save(std::vector<T> const& rows) const { SaveRows(rows.data(), sizeof(T), rows.size()); }
+
+    private:
+        bool LoadRows(uint32 rowSize, std::vector<char>& rows) const;
+        void SaveRows(void const* rows, uint32 rowSize, uint32 rowCount) const;
+
+        std::string m_name;
+        uint32 m_queryHash;
+        SQLStorageSnapshotKey m_key;
+        bool m_enabled;
+};
+
 template <class DerivedLoader, class StorageClass>
 class SQLStorageLoaderBase
 {
@@ -268,6 +338,9 @@ class SQLStorageLoaderBase
         void default_fill(uint32 field_pos, S src, D& dst);
         void default_fill_to_str(uint32 field_pos, char const* src, char*& dst);
 
+        // Anything else than the table content the converted records depend on
+        uint32 snapshot_salt() const { return 0; }
+
         // trap, no body
         template<class D>
         void convert_from_str(uint32 field_pos, char* src, D& dst);
@@ -189,6 +189,11 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::storeValue(char const* v
 template<class DerivedLoader, class StorageClass>
 void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store, bool error_at_empty /*= true*/)
 {
+    SQLStorageSnapshotKey snapshotKey;
+    bool useSnapshot = store.PrepareSnapshotKey(snapshotKey, 0, static_cast<DerivedLoader*>(this)->snapshot_salt());
+    if (useSnapshot && store.LoadSnapshot(snapshotKey))
+        return;
+
     Field* fields = nullptr;
     QueryResult* result  = WorldDatabase.PQuery("SELECT MAX(%s) FROM %s", store.EntryFieldName(), store.GetTableName());
     if (!result)
@@ -272,6 +277,10 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
     // Prepare data storage and lookup storage
     store.prepareToLoad(maxRecordId, recordCount, recordsize);
 
+    std::vector<uint32> recordIds;
+    if (useSnapshot)
+        recordIds.reserve(recordCount);
+
     BarGoLink bar(recordCount);
     do
     {
@@ -279,6 +288,8 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
         bar.step();
 
         char* record = store.createRecord(fields[0].GetUInt32());
+        if (useSnapshot)
+            recordIds.push_back(fields[0].GetUInt32());
         offset = 0;
 
         // dependend on dest-size
@@ -329,12 +340,20 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
     while (result->NextRow());
 
     delete result;
+
+    if (useSnapshot)
+        store.SaveSnapshot(snapshotKey, recordIds);
 }
 
 template<class DerivedLoader, class StorageClass>
 void SQLStorageLoaderBase<DerivedLoader, StorageClass>::LoadProgressive(StorageClass& store, uint8 wow_patch, bool error_at_empty /*= true*/)
 {
     // To be used on tables that need to support patch progression. Second column must be the `patch` column.
+    SQLStorageSnapshotKey snapshotKey;
+    bool useSnapshot = store.PrepareSnapshotKey(snapshotKey, wow_patch + 1, static_cast<DerivedLoader*>(this)->snapshot_salt());
+    if (useSnapshot && store.LoadSnapshot(snapshotKey))
+        return;
+
     Field* fields = nullptr;
     QueryResult* result = WorldDatabase.PQuery("SELECT MAX(%s) FROM %s t1 WHERE patch=(SELECT max(patch) FROM %s t2 WHERE t1.%s=t2.%s && patch <= %u)", store.EntryFieldName(), store.GetTableName(), store.GetTableName(), store.EntryFieldName(), store.EntryFieldName(), wow_patch);
     if (!result)
@@ -418,6 +437,10 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::LoadProgressive(StorageC
     // Prepare data storage and lookup storage
     store.prepareToLoad(maxRecordId, recordCount, recordsize);
 
+    std::vector<uint32> recordIds;
+    if (useSnapshot)
+        recordIds.reserve(recordCount);
+
     uint8 patchoffset = 0;
     BarGoLink bar(recordCount);
     do
@@ -426,6 +449,8 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::LoadProgressive(StorageC
         bar.step();
 
         char* record = store.createRecord(fields[0].GetUInt32());
+        if (useSnapshot)
+            recordIds.push_back(fields[0].GetUInt32());
         offset = 0;
         patchoffset = 0;
 
@@ -480,6 +505,9 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::LoadProgressive(StorageC
     } while (result->NextRow());
 
     delete result;
+
+    if (useSnapshot)
+        store.SaveSnapshot(snapshotKey, recordIds);
 }
 
 #endif
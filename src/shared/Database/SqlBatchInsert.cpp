@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2017 Light's Hope <https://lightshope.org>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "SqlBatchInsert.h"
+#include "Database/Database.h"
+#include "Log.h"
+
+#include <stdarg.h>
+
+SqlBatchInsert::SqlBatchInsert(Database& db, char const* head, char const* tail, uint32 maxRows) :
+    m_db(db), m_head(head), m_tail(tail), m_maxRows(maxRows ? maxRows : 1), m_pendingRows(0), m_totalRows(0)
+{
+}
+
+void SqlBatchInsert::AddRow(char const* format, ...)
+{
+    char row[MAX_QUERY_LEN];
+    va_list ap;
+    va_start(ap, format);
+    int res = vsnprintf(row, MAX_QUERY_LEN, format, ap);
+    va_end(ap);
+
+    if (res < 0 || res >= MAX_QUERY_LEN)
+    {
+        sLog.outError("SQL row longer than %d chars skipped for '%s'", MAX_QUERY_LEN, m_head.c_str());
+        return;
+    }
+
+    if (m_query.empty())
+        m_query = m_head;
+    else
+        m_query += ", ";
+    m_query += row;
+
+    ++m_totalRows;
+    if (++m_pendingRows >= m_maxRows)
+        Flush();
+}
+
+uint32 SqlBatchInsert::Flush()
+{
+    if (m_pendingRows)
+    {
+        m_query += m_tail;
+        m_db.Execute(m_query.c_str());
+        m_query.clear();
+        m_pendingRows = 0;
+    }
+    return m_totalRows;
+}
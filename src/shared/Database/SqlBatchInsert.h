@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2017 Light's Hope <https://lightshope.org>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _SQLBATCHINSERT_H
+#define _SQLBATCHINSERT_H
+
+#include "Common.h"
+
+class Database;
+
+/*
+ * Groups rows of a table in multi rows INSERT queries:
+ *   <head> (row), (row) ... <tail>
+ * eg. head "INSERT INTO t (a, b) VALUES " and tail " ON DUPLICATE KEY UPDATE b = VALUES(b)".
+ * A query is executed every 'maxRows' rows and at Flush, in the current transaction if any.
+ * Rows are formatted by the caller and are not escaped.
+ */
+class SqlBatchInsert
+{
+    public:
+        SqlBatchInsert(Database& db, char const* head, char const* tail = "", uint32 maxRows = 100);
+        ~SqlBatchInsert() { Flush(); }
+
+        void AddRow(char const* format, ...) ATTR_PRINTF(2, 3);
+
+        // Executes pending rows, returns the number of rows added since the batch creation
+        uint32 Flush();
+
+    private:
+        Database& m_db;
+        std::string m_head;
+        std::string m_tail;
+        std::string m_query;
+        uint32 m_maxRows;
+        uint32 m_pendingRows;
+        uint32 m_totalRows;
+};
+
+#endif
@@ -22,9 +22,21 @@
 #include "Database/SqlDelayThread.h"
 #include "Database/SqlOperations.h"
 #include "DatabaseEnv.h"
+#include "Timer.h"
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+    struct BatchableOperationCheck
+    {
+        bool Process(SqlOperation* op) const { return op->IsBatchable(); }
+    };
+}
 
 SqlDelayThread::SqlDelayThread(Database* db, SqlConnection* conn, int workerId)
-    : m_dbEngine(db), m_dbConnection(conn), m_running(true), m_workerId(workerId)
+    : m_dbEngine(db), m_dbConnection(conn), m_running(true), m_workerId(workerId),
+      m_executedOps(0), m_batches(0), m_batchedOps(0), m_busyTime(0)
 {
 }
 
@@ -41,22 +53,23 @@ void SqlDelayThread::run()
     mysql_thread_init();
     #endif
 
-    const uint32 loopSleepms = 10;
-
-    const uint32 pingEveryLoop = m_dbEngine->GetPingIntervall() / loopSleepms;
+    // MaxPingTime = 0 used to ping on every 10ms loop
+    const uint32 pingInterval = std::max(m_dbEngine->GetPingIntervall(), uint32(IN_MILLISECONDS));
 
-    uint32 loopCounter = 0;
+    uint32 lastPing = WorldTimer::getMSTime();
     while (m_running)
     {
-        // if the running state gets turned off while sleeping
-        // empty the queue before exiting
-        ACE_Based::Thread::Sleep(loopSleepms);
+        // Sleep until something is queued for this worker, or the next ping is due.
+        // Requests queued while stopping are processed before exiting
+        uint32 sinceLastPing = WorldTimer::getMSTimeDiffToNow(lastPing);
+        if (sinceLastPing < pingInterval)
+            m_dbEngine->WaitForDelayedOperations(m_workerId, pingInterval - sinceLastPing);
 
         ProcessRequests();
 
-        if((loopCounter++) >= pingEveryLoop)
+        if (WorldTimer::getMSTimeDiffToNow(lastPing) >= pingInterval)
         {
-            loopCounter = 0;
+            lastPing = WorldTimer::getMSTime();
             m_dbEngine->Ping();
             if (QueryResult* res = m_dbConnection->Query("SELECT 1"))
                 delete res;
@@ -73,13 +86,34 @@ void SqlDelayThread::Stop()
     m_running = false;
 }
 
+SqlDelayThread::Stats SqlDelayThread::GetStats() const
+{
+    Stats stats;
+    stats.executedOps = m_executedOps;
+    stats.batches = m_batches;
+    stats.batchedOps = m_batchedOps;
+    stats.busyTime = m_busyTime;
+    return stats;
+}
+
 void SqlDelayThread::ProcessRequests()
 {
+    uint32 beginTime = WorldTimer::getMSTime();
+    uint32 executed = 0;
+    uint32 const batchSize = m_dbEngine->GetAsyncBatchSize();
+
     SqlOperation* s = NULL;
     while (m_dbEngine->NextDelayedOperation(s))
     {
+        if (batchSize > 1 && s->IsBatchable())
+        {
+            executed += ExecuteBatch(s, batchSize);
+            continue;
+        }
+
         s->Execute(m_dbConnection);
         delete s;
+        ++executed;
     }
 
     // Process any serial operations for this worker
@@ -87,5 +121,79 @@ void SqlDelayThread::ProcessRequests()
     {
         s->Execute(m_dbConnection);
         delete s;
+        ++executed;
+    }
+
+    if (executed)
+    {
+        m_executedOps += executed;
+        m_busyTime += WorldTimer::getMSTimeDiffToNow(beginTime);
+    }
+}
+
+uint32 SqlDelayThread::ExecuteBatch(SqlOperation* first, uint32 maxSize)
+{
+    std::vector<SqlOperation*> batch;
+    batch.reserve(maxSize);
+    batch.push_back(first);
+
+    // Only consecutive requests are grouped, so the execution order is unchanged
+    BatchableOperationCheck check;
+    SqlOperation* s = NULL;
+    while (batch.size() < maxSize && m_dbEngine->NextDelayedOperation(s, check))
+        batch.push_back(s);
+
+    if (batch.size() == 1)
+    {
+        first->Execute(m_dbConnection);
+        delete first;
+        return 1;
+    }
+
+    // A failing statement (duplicate key...) is logged by the connection and only
+    // loses its own changes, as when executed alone. A deadlock, a lock wait timeout
+    // or a lost connection however drop the whole InnoDB transaction, and so do a
+    // failed COMMIT: the batch is then rolled back and every request executed again
+    // on its own. Writes already done to MyISAM tables are not transactional and are
+    // applied a second time by that replay.
+    bool committed = false;
+    {
+        SqlConnection::Lock guard(m_dbConnection);
+        if (m_dbConnection->BeginTransaction())
+        {
+            bool aborted = false;
+            for (SqlOperation* op : batch)
+            {
+                op->Execute(m_dbConnection);
+                if (m_dbConnection->IsTransactionAborted())
+                {
+                    aborted = true;
+                    break;
+                }
+            }
+
+            committed = !aborted && m_dbConnection->CommitTransaction();
+            if (!committed)
+            {
+                m_dbConnection->RollbackTransaction();
+                sLog.outError("SqlDelayThread: transaction of %u requests aborted, executing them one by one", uint32(batch.size()));
+            }
+        }
+
+        if (!committed)
+        {
+            for (SqlOperation* op : batch)
+                op->Execute(m_dbConnection);
+        }
+    }
+
+    for (SqlOperation* op : batch)
+        delete op;
+
+    if (committed)
+    {
+        ++m_batches;
+        m_batchedOps += batch.size();
     }
+    return batch.size();
 }
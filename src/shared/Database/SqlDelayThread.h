@@ -25,6 +25,7 @@
 #include "ace/Thread_Mutex.h"
 #include "LockedQueue.h"
 #include "Threading.h"
+#include <atomic>
 
 
 class Database;
@@ -43,13 +44,30 @@ class SqlDelayThread : public ACE_Based::Runnable
 
         int m_workerId;
 
+        std::atomic<uint64> m_executedOps;
+        std::atomic<uint64> m_batches;
+        std::atomic<uint64> m_batchedOps;
+        std::atomic<uint64> m_busyTime;
+
         //process all enqueued requests
         void ProcessRequests();
+        //execute 'first' and the following batchable requests in one transaction
+        uint32 ExecuteBatch(SqlOperation* first, uint32 maxSize);
 
     public:
+        struct Stats
+        {
+            uint64 executedOps;                             ///< operations executed, batched ones included
+            uint64 batches;                                 ///< transactions opened to group plain requests
+            uint64 batchedOps;                              ///< plain requests executed inside those
+            uint64 busyTime;                                ///< ms spent executing operations
+        };
+
         SqlDelayThread(Database* db, SqlConnection* conn, int workerId);
         ~SqlDelayThread();
 
+        Stats GetStats() const;
+
         ///< Put sql statement to delay queue
         bool Delay(SqlOperation* sql) { m_sqlQueue.add(sql); return true; }
 
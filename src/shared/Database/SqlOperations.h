@@ -44,6 +44,8 @@ class SqlOperation
         uint32 GetSerialId() const { return serialId; }
         virtual void OnRemove() { delete this; }
         virtual bool Execute(SqlConnection *conn) = 0;
+        // Can be grouped with other operations in a single transaction by the delay threads
+        virtual bool IsBatchable() const { return false; }
         virtual ~SqlOperation() {}
 
     protected:
@@ -60,6 +62,7 @@ class SqlPlainRequest : public SqlOperation
         SqlPlainRequest(const char *sql) : m_sql(mangos_strdup(sql)){}
         ~SqlPlainRequest() { char* tofree = const_cast<char*>(m_sql); delete [] tofree; }
         bool Execute(SqlConnection *conn);
+        bool IsBatchable() const { return true; }
 };
 
 class SqlTransaction : public SqlOperation
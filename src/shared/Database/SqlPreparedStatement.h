@@ -207,6 +207,10 @@ class MANGOS_DLL_SPEC SqlStatement
         bool Execute();
         bool DirectExecute();
 
+        //run a SELECT statement on a query connection
+        //MySQL fetches it with the binary protocol: numeric fields are read without text conversion
+        QueryResult* Query();
+
         //templates to simplify 1-4 parameter bindings
         template<typename ParamType1>
         bool PExecute(ParamType1 param1)
@@ -326,6 +330,10 @@ class MANGOS_DLL_SPEC SqlPreparedStatement
         //execute statement w/o result set
         virtual bool execute() = 0;
 
+        //execute statement and fetch its whole result set
+        //returns NULL on error or empty result, like SqlConnection::Query()
+        virtual QueryResult* query() = 0;
+
     protected:
         SqlPreparedStatement(const std::string& fmt, SqlConnection& conn) : m_szFmt(fmt), m_nParams(0), m_nColumns(0), m_bPrepared(false), m_bIsQuery(false), m_pConn(conn) {}
 
@@ -352,6 +360,8 @@ class MANGOS_DLL_SPEC SqlPlainPreparedStatement : public SqlPreparedStatement
 
         virtual bool execute();
 
+        virtual QueryResult* query();
+
     protected:
         void DataToString(const SqlStmtFieldData& data, std::ostringstream& fmt);
 
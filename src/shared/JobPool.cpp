@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2017 Light's Hope <https://lightshope.org>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "JobPool.h"
+
+JobPool::JobPool(ThreadHook onThreadStart, ThreadHook onThreadExit) :
+    m_onThreadStart(onThreadStart), m_onThreadExit(onThreadExit), m_stop(false)
+{
+}
+
+JobPool::~JobPool()
+{
+    Stop();
+}
+
+void JobPool::EnsureThreads(uint32 count)
+{
+    if (count <= m_threads.size())
+        return;
+
+    Stop();
+    m_stop = false;
+    for (uint32 i = 0; i < count; ++i)
+        m_threads.emplace_back(&JobPool::Work, this);
+}
+
+void JobPool::Stop()
+{
+    if (m_threads.empty())
+        return;
+
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_stop = true;
+    }
+    m_batchAvailable.notify_all();
+
+    for (auto& thread : m_threads)
+        if (thread.joinable())
+            thread.join();
+    m_threads.clear();
+}
+
+uint32 JobPool::ParallelFor(uint32 count, uint32 chunkSize, uint32 maxSlots, RangeFunc const& func, SlotFunc const& finish)
+{
+    if (!count)
+        return 0;
+    if (!chunkSize)
+        chunkSize = 1;
+    if (!maxSlots)
+        maxSlots = 1;
+
+    Batch batch;
+    batch.func = &func;
+    batch.finish = finish ? &finish : nullptr;
+    batch.count = count;
+    batch.chunkSize = chunkSize;
+    batch.chunks = (count + chunkSize - 1) / chunkSize;
+    batch.maxSlots = maxSlots;
+    batch.usedSlots = 1;                // slot 0 is the caller
+    batch.finishedSlots = 0;
+    batch.nextChunk = 0;
+
+    bool shared = batch.chunks > 1 && maxSlots > 1 && !m_threads.empty();
+    if (shared)
+    {
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            m_batches.push_back(&batch);
+        }
+        m_batchAvailable.notify_all();
+    }
+
+    Run(batch, 0);
+
+    if (shared)
+    {
+        // No thread can join once the batch is out of the list
+        std::unique_lock<std::mutex> guard(m_lock);
+        m_batches.remove(&batch);
+        m_slotFinished.wait(guard, [&batch]() { return batch.finishedSlots + 1 == batch.usedSlots; });
+    }
+    return batch.usedSlots;
+}
+
+void JobPool::Run(Batch& batch, uint32 slot)
+{
+    uint32 chunk;
+    while ((chunk = batch.nextChunk++) < batch.chunks)
+    {
+        uint32 begin = chunk * batch.chunkSize;
+        uint32 end = begin + batch.chunkSize;
+        if (end > batch.count)
+            end = batch.count;
+        (*batch.func)(slot, begin, end);
+    }
+
+    if (batch.finish)
+        (*batch.finish)(slot);
+}
+
+void JobPool::Work()
+{
+    if (m_onThreadStart)
+        m_onThreadStart();
+
+    while (true)
+    {
+        Batch* batch = nullptr;
+        uint32 slot = 0;
+        {
+            std::unique_lock<std::mutex> guard(m_lock);
+            m_batchAvailable.wait(guard, [this]() { return m_stop || !m_batches.empty(); });
+            if (m_stop)
+                break;
+
+            batch = m_batches.front();
+            m_batches.pop_front();
+            // Full or fully claimed batches are not offered anymore
+            if (batch->usedSlots >= batch->maxSlots || batch->nextChunk >= batch->chunks)
+                continue;
+
+            slot = batch->usedSlots++;
+            // Round robin between batches submitted concurrently
+            m_batches.push_back(batch);
+        }
+
+        Run(*batch, slot);
+
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            ++batch->finishedSlots;
+        }
+        m_slotFinished.notify_all();
+    }
+
+    if (m_onThreadExit)
+        m_onThreadExit();
+}
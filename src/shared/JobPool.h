@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2017 Light's Hope <https://lightshope.org>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _JOB_POOL_H
+#define _JOB_POOL_H
+
+#include "Platform/Define.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+ * Fork/join pool of persistent threads.
+ *
+ * ParallelFor splits an index range in chunks. Chunks are claimed through an
+ * atomic counter by the calling thread and by every pool thread that joins
+ * the batch, so the caller never waits on an idle pool and several callers
+ * (eg. one per continent) can share the same threads.
+ */
+class JobPool
+{
+    public:
+        typedef std::function<void()> ThreadHook;
+        typedef std::function<void(uint32 /*slot*/, uint32 /*begin*/, uint32 /*end*/)> RangeFunc;
+        typedef std::function<void(uint32 /*slot*/)> SlotFunc;
+
+        explicit JobPool(ThreadHook onThreadStart = nullptr, ThreadHook onThreadExit = nullptr);
+        ~JobPool();
+
+        // Restarts the pool with 'count' threads if it has less. Must not be
+        // called while a ParallelFor is running.
+        void EnsureThreads(uint32 count);
+        void Stop();
+        uint32 GetThreadCount() const { return m_threads.size(); }
+
+        // Runs func(slot, begin, end) over [0, count) in chunks of 'chunkSize'.
+        // At most 'maxSlots' threads (the caller included, always slot 0) take
+        // part, each with a distinct slot in [0, maxSlots). 'finish' is called
+        // by each of them with its slot once no chunk is left to claim.
+        // Blocks until every chunk is processed and returns the number of slots used.
+        uint32 ParallelFor(uint32 count, uint32 chunkSize, uint32 maxSlots, RangeFunc const& func, SlotFunc const& finish = nullptr);
+
+    private:
+        struct Batch
+        {
+            RangeFunc const* func;
+            SlotFunc const* finish;
+            uint32 count;
+            uint32 chunkSize;
+            uint32 chunks;
+            uint32 maxSlots;
+            uint32 usedSlots;           // protected by m_lock
+            uint32 finishedSlots;       // protected by m_lock
+            std::atomic<uint32> nextChunk;
+        };
+
+        void Work();
+        static void Run(Batch& batch, uint32 slot);
+
+        ThreadHook m_onThreadStart;
+        ThreadHook m_onThreadExit;
+
+        std::vector<std::thread> m_threads;
+        std::list<Batch*> m_batches;
+        std::mutex m_lock;
+        std::condition_variable m_batchAvailable;
+        std::condition_variable m_slotFinished;
+        bool m_stop;
+};
+
+#endif
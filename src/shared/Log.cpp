@@ -30,6 +30,12 @@
 #include <stdarg.h>
 #include <fstream>
 #include <iostream>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <algorithm>
+#include <condition_variable>
+#include <set>
 
 #include "ace/OS_NS_unistd.h"
 
@@ -55,6 +61,228 @@ LogFilterData logFilterData[LOG_FILTER_COUNT] =
     { "honor",               "LogFilter_Honor",              true  },
 };
 
+/*
+ * Log.Async backend.
+ * Each logging thread owns a single producer / single consumer ring, so queuing
+ * a line takes no lock: the text is formatted in place in the ring slot (arguments
+ * may not outlive the call), the timestamp is only formatted by the writer thread.
+ * The writer drains every ring, then flushes each file touched once per batch,
+ * and sleeps until a line is queued. The ring of an exited thread is reused by
+ * the next thread logging. A full ring drops the line instead of blocking the caller.
+ */
+class AsyncLogWriter
+{
+    public:
+        explicit AsyncLogWriter(uint32 ringSize) : m_ringSize(ringSize), m_generation(++s_generations), m_stop(false),
+            m_writerWaiting(false), m_queued(0), m_written(0), m_dropped(0)
+        {
+            m_thread = std::thread(&AsyncLogWriter::Run, this);
+        }
+
+        ~AsyncLogWriter()
+        {
+            {
+                std::lock_guard<std::mutex> guard(m_wakeupLock);
+                m_stop = true;
+            }
+            m_wakeup.notify_one();
+            m_thread.join();
+            // lines queued after the last pass
+            Drain();
+        }
+
+        void Push(FILE* file, bool timestamp, const char* str, va_list ap)
+        {
+            Ring& ring = GetThreadRing();
+            uint32 head = ring.head.load(std::memory_order_relaxed);
+            if (head - ring.tail.load(std::memory_order_acquire) >= m_ringSize)
+            {
+                ++m_dropped;
+                return;
+            }
+
+            Line& line = ring.lines[head % m_ringSize];
+            line.file = file;
+            line.time = timestamp ? time(nullptr) : 0;
+            int length = vsnprintf(line.text, sizeof(line.text), str, ap);
+            // truncated lines are kept
+            line.length = length < 0 ? 0 : std::min<uint32>(length, sizeof(line.text) - 1);
+            ring.head.store(head + 1, std::memory_order_release);
+            ++m_queued;
+
+            // m_queued and m_writerWaiting are seq_cst: either the writer sees the line before sleeping, or we see it waiting
+            if (m_writerWaiting)
+            {
+                std::lock_guard<std::mutex> guard(m_wakeupLock);
+                m_wakeup.notify_one();
+            }
+        }
+
+        void GetStats(AsyncLogStats& stats) const
+        {
+            stats.queued = m_queued;
+            stats.written = m_written;
+            stats.dropped = m_dropped;
+        }
+
+    private:
+        struct Line
+        {
+            FILE* file;
+            time_t time;                                    // 0 for no timestamp prefix
+            uint32 length;
+            char text[1024];
+        };
+
+        struct Ring
+        {
+            explicit Ring(uint32 size) : lines(new Line[size]), head(0), tail(0), released(false) {}
+
+            std::unique_ptr<Line[]> lines;
+            std::atomic<uint32> head;                       // written by the owner thread only
+            std::atomic<uint32> tail;                       // written by the writer thread only
+            std::atomic<bool> released;                     // the owner thread exited
+        };
+
+        // Thread local reference to the ring of the thread, releases it at thread exit.
+        // Shared with the writer: the ring stays valid whichever is destroyed first.
+        struct RingOwner
+        {
+            RingOwner() : generation(0) {}
+            ~RingOwner() { Release(); }
+
+            void Release()
+            {
+                if (ring)
+                    ring->released.store(true, std::memory_order_release);
+                ring.reset();
+            }
+
+            std::shared_ptr<Ring> ring;
+            uint32 generation;
+        };
+
+        Ring& GetThreadRing()
+        {
+            // only one writer exists at a time, a new one (Log::Initialize) gets a new generation
+            static thread_local RingOwner t_owner;
+            if (t_owner.generation != m_generation)
+            {
+                t_owner.Release();
+
+                std::lock_guard<std::mutex> guard(m_ringsLock);
+                if (m_freeRings.empty())
+                    t_owner.ring = std::make_shared<Ring>(m_ringSize);
+                else
+                {
+                    t_owner.ring = std::move(m_freeRings.back());
+                    m_freeRings.pop_back();
+                    t_owner.ring->released.store(false, std::memory_order_relaxed);
+                }
+                m_rings.push_back(t_owner.ring);
+                t_owner.generation = m_generation;
+            }
+            return *t_owner.ring;
+        }
+
+        void Run()
+        {
+            while (!m_stop)
+            {
+                if (Drain())
+                    continue;
+
+                std::unique_lock<std::mutex> lock(m_wakeupLock);
+                m_writerWaiting = true;
+                m_wakeup.wait(lock, [this]() { return m_stop || m_queued != m_written; });
+                m_writerWaiting = false;
+            }
+        }
+
+        // Returns false if nothing was queued
+        bool Drain()
+        {
+            std::vector<Ring*> rings;
+            {
+                std::lock_guard<std::mutex> guard(m_ringsLock);
+                rings.reserve(m_rings.size());
+                for (auto& ring : m_rings)
+                    rings.push_back(ring.get());
+            }
+
+            std::set<FILE*> touched;
+            std::vector<Ring*> released;
+            uint64 written = 0;
+            time_t lastTime = 0;
+            char timestamp[64] = "";
+            for (Ring* ring : rings)
+            {
+                // read before head: all the lines of an exited thread are seen below
+                if (ring->released.load(std::memory_order_acquire))
+                    released.push_back(ring);
+
+                uint32 tail = ring->tail.load(std::memory_order_relaxed);
+                uint32 head = ring->head.load(std::memory_order_acquire);
+                for (; tail != head; ++tail)
+                {
+                    Line const& line = ring->lines[tail % m_ringSize];
+                    if (line.time)
+                    {
+                        if (line.time != lastTime)
+                        {
+                            lastTime = line.time;
+                            tm* aTm = localtime(&lastTime);
+                            snprintf(timestamp, sizeof(timestamp), "%-4d-%02d-%02d %02d:%02d:%02d ",
+                                     aTm->tm_year + 1900, aTm->tm_mon + 1, aTm->tm_mday, aTm->tm_hour, aTm->tm_min, aTm->tm_sec);
+                        }
+                        fputs(timestamp, line.file);
+                    }
+                    fwrite(line.text, 1, line.length, line.file);
+                    fputc('\n', line.file);
+                    touched.insert(line.file);
+                    ++written;
+                }
+                ring->tail.store(tail, std::memory_order_release);
+            }
+
+            for (FILE* file : touched)
+                fflush(file);
+
+            // empty rings of exited threads go to the free list
+            if (!released.empty())
+            {
+                std::lock_guard<std::mutex> guard(m_ringsLock);
+                for (Ring* ring : released)
+                {
+                    auto itr = std::find_if(m_rings.begin(), m_rings.end(), [ring](std::shared_ptr<Ring> const& r) { return r.get() == ring; });
+                    m_freeRings.push_back(std::move(*itr));
+                    m_rings.erase(itr);
+                }
+            }
+
+            m_written += written;
+            return written != 0;
+        }
+
+        static std::atomic<uint32> s_generations;
+
+        uint32 const m_ringSize;
+        uint32 const m_generation;
+        std::mutex m_ringsLock;
+        std::vector<std::shared_ptr<Ring> > m_rings;        // rings of running threads
+        std::vector<std::shared_ptr<Ring> > m_freeRings;    // rings of exited threads, for the next ones
+        std::thread m_thread;
+        std::mutex m_wakeupLock;
+        std::condition_variable m_wakeup;
+        std::atomic<bool> m_stop;
+        std::atomic<bool> m_writerWaiting;
+        std::atomic<uint64> m_queued;
+        std::atomic<uint64> m_written;
+        std::atomic<uint64> m_dropped;
+};
+
+std::atomic<uint32> AsyncLogWriter::s_generations(0);
+
 Log::Log() :
     logfile(nullptr), gmLogfile(nullptr), dberLogfile(nullptr),
     wardenLogfile(nullptr), honorLogfile(nullptr), m_colored(false), m_includeTime(false), m_gmlog_per_account(false)
@@ -67,6 +295,43 @@ Log::Log() :
     Initialize();
 }
 
+Log::~Log()
+{
+    // writes the lines still queued, files are closed below
+    StopAsyncWriter();
+
+    if( logfile != nullptr )
+        fclose(logfile);
+    logfile = nullptr;
+
+    if( gmLogfile != nullptr )
+        fclose(gmLogfile);
+    gmLogfile = nullptr;
+
+    if( dberLogfile != nullptr )
+        fclose(dberLogfile);
+    dberLogfile = nullptr;
+
+    if (worldLogfile != nullptr)
+        fclose(worldLogfile);
+    worldLogfile = nullptr;
+
+    if (nostalriusLogFile != nullptr)
+        fclose(nostalriusLogFile);
+    nostalriusLogFile = nullptr;
+
+    if (honorLogfile != nullptr)
+        fclose(honorLogfile);
+    honorLogfile = nullptr;
+
+    for (int i = 0; i < LOG_MAX_FILES; ++i)
+        if (logFiles[i] != nullptr)
+        {
+            fclose(logFiles[i]);
+            logFiles[i] = nullptr;
+        }
+}
+
 void Log::InitColors(const std::string& str)
 {
     if (str.empty())
@@ -246,6 +511,8 @@ void Log::SetLogFileLevel(char* level)
 
 void Log::Initialize()
 {
+    StopAsyncWriter();
+
     /// Common log files data
     m_logsDir = sConfig.GetStringDefault("LogsDir","");
     if (!m_logsDir.empty())
@@ -332,6 +599,41 @@ void Log::Initialize()
 
     // Char log settings
     m_charLog_Dump = sConfig.GetBoolDefault("CharLogDump", false);
+
+    if (sConfig.GetBoolDefault("Log.Async", false))
+    {
+        uint32 ringSize = sConfig.GetIntDefault("Log.Async.QueueSize", 1024);
+        m_asyncWriter.reset(new AsyncLogWriter(ringSize ? ringSize : 1024));
+    }
+}
+
+void Log::StopAsyncWriter()
+{
+    m_asyncWriter.reset();
+}
+
+bool Log::GetAsyncStats(AsyncLogStats& stats) const
+{
+    if (!m_asyncWriter)
+        return false;
+
+    m_asyncWriter->GetStats(stats);
+    return true;
+}
+
+void Log::outFile(FILE* file, bool timestamp, const char* str, va_list ap)
+{
+    if (m_asyncWriter)
+    {
+        m_asyncWriter->Push(file, timestamp, str, ap);
+        return;
+    }
+
+    if (timestamp)
+        outTimestamp(file);
+    vfprintf(file, str, ap);
+    fprintf(file, "\n");
+    fflush(file);
 }
 
 FILE* Log::openLogFile(char const* configFileName,char const* configTimeStampFlag, char const* mode)
@@ -530,17 +832,10 @@ void Log::out(LogFile type, const char* str, ...)
 
     if (logFiles[type])
     {
-        if (timestampPrefix[type])
-            outTimestamp(logFiles[type]);
-
         va_list ap;
         va_start(ap, str);
-        vfprintf(logFiles[type], str, ap);
-        fprintf(logFiles[type], "\n");
-        fflush(logFiles[type]);
+        outFile(logFiles[type], timestampPrefix[type], str, ap);
         va_end(ap);
-
-        fflush(logFiles[type]);
     }
     fflush(stdout);
 }
@@ -865,12 +1160,9 @@ void Log::outCommand( uint32 account, const char * str, ... )
     else if (gmLogfile)
     {
         va_list ap;
-        outTimestamp(gmLogfile);
         va_start(ap, str);
-        vfprintf(gmLogfile, str, ap);
-        fprintf(gmLogfile, "\n" );
+        outFile(gmLogfile, true, str, ap);
         va_end(ap);
-        fflush(gmLogfile);
     }
 
     fflush(stdout);
@@ -25,8 +25,12 @@
 #include "Common.h"
 #include "Policies/Singleton.h"
 
+#include <memory>
+#include <stdarg.h>
+
 class Config;
 class ByteBuffer;
+class AsyncLogWriter;
 
 enum LogLevel
 {
@@ -118,44 +122,20 @@ enum LogType
 
 const int Color_count = int(WHITE)+1;
 
+struct AsyncLogStats
+{
+    uint64 queued;                                          // lines accepted since start
+    uint64 written;                                         // lines written to their file
+    uint64 dropped;                                         // lines lost because the thread ring was full
+};
+
 class Log : public MaNGOS::Singleton<Log, MaNGOS::ClassLevelLockable<Log, ACE_Thread_Mutex> >
 {
     friend class MaNGOS::OperatorNew<Log>;
     Log();
 
-    ~Log()
-    {
-        if( logfile != nullptr )
-            fclose(logfile);
-        logfile = nullptr;
-
-        if( gmLogfile != nullptr )
-            fclose(gmLogfile);
-        gmLogfile = nullptr;
-
-        if( dberLogfile != nullptr )
-            fclose(dberLogfile);
-        dberLogfile = nullptr;
-
-        if (worldLogfile != nullptr)
-            fclose(worldLogfile);
-        worldLogfile = nullptr;
-
-        if (nostalriusLogFile != nullptr)
-            fclose(nostalriusLogFile);
-        nostalriusLogFile = nullptr;
-
-        if (honorLogfile != nullptr)
-            fclose(honorLogfile);
-        honorLogfile = nullptr;
-
-        for (int i = 0; i < LOG_MAX_FILES; ++i)
-            if (logFiles[i] != nullptr)
-            {
-                fclose(logFiles[i]);
-                logFiles[i] = nullptr;
-            }
-    }
+    ~Log();
+
     public:
         void Initialize();
         void InitColors(const std::string& init_str);
@@ -203,12 +183,19 @@ class Log : public MaNGOS::Singleton<Log, MaNGOS::ClassLevelLockable<Log, ACE_Th
 
         static void WaitBeforeContinueIfNeed();
 
+        // Log.Async: file only lines (out(), GM commands log) are queued in per thread rings
+        // and written by a dedicated thread
+        bool IsAsync() const { return m_asyncWriter != nullptr; }
+        bool GetAsyncStats(AsyncLogStats& stats) const;
+        void StopAsyncWriter();
+
         std::list<uint32> m_smartlogExtraEntries;
         std::list<uint32> m_smartlogExtraGuids;
 
     private:
         FILE* openLogFile(char const* configFileName,char const* configTimeStampFlag, char const* mode);
         FILE* openGmlogPerAccount(uint32 account);
+        void outFile(FILE* file, bool timestamp, const char* str, va_list ap);
 
         FILE* logfile;
         FILE* gmLogfile;
@@ -240,6 +227,8 @@ class Log : public MaNGOS::Singleton<Log, MaNGOS::ClassLevelLockable<Log, ACE_Th
         // gm log control
         bool m_gmlog_per_account;
         std::string m_gmlog_filename_format;
+
+        std::unique_ptr<AsyncLogWriter> m_asyncWriter;
 };
 
 #define sLog MaNGOS::Singleton<Log>::Instance()
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2017 Light's Hope <https://lightshope.org>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "MappedFile.h"
+
+#if PLATFORM != PLATFORM_WINDOWS
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile() : m_data(nullptr), m_size(0)
+#if PLATFORM == PLATFORM_WINDOWS
+    , m_mapping(NULL)
+#endif
+{
+}
+
+#if PLATFORM == PLATFORM_WINDOWS
+bool MappedFile::Open(char const* filename, bool copyOnWrite)
+{
+    Close();
+
+    HANDLE file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || !size.QuadPart)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    // the mapping keeps the file open
+    m_mapping = CreateFileMappingA(file, NULL, copyOnWrite ? PAGE_WRITECOPY : PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+    if (!m_mapping)
+        return false;
+
+    m_data = (uint8*)MapViewOfFile(m_mapping, copyOnWrite ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0);
+    if (!m_data)
+    {
+        CloseHandle(m_mapping);
+        m_mapping = NULL;
+        return false;
+    }
+
+    m_size = size_t(size.QuadPart);
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (m_data)
+        UnmapViewOfFile(m_data);
+    if (m_mapping)
+        CloseHandle(m_mapping);
+
+    m_data = nullptr;
+    m_mapping = NULL;
+    m_size = 0;
+}
+#else
+bool MappedFile::Open(char const* filename, bool copyOnWrite)
+{
+    Close();
+
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !st.st_size)
+    {
+        close(fd);
+        return false;
+    }
+
+    // the mapping keeps the file open
+    void* data = mmap(nullptr, st.st_size, copyOnWrite ? PROT_READ | PROT_WRITE : PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+        return false;
+
+    m_data = (uint8*)data;
+    m_size = st.st_size;
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (m_data)
+        munmap(m_data, m_size);
+
+    m_data = nullptr;
+    m_size = 0;
+}
+#endif
@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2017 Light's Hope <https://lightshope.org>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_MAPPEDFILE_H
+#define MANGOS_MAPPEDFILE_H
+
+#include "Common.h"
+
+/*
+ * Whole file mapped in memory, for read only data files (terrain, navmesh tiles).
+ * Pages come from the system page cache: they are loaded on first access and
+ * shared by every process mapping the same file.
+ * A copy on write mapping can be modified in place, only the modified pages
+ * become private to the process. The file itself is never written.
+ */
+class MappedFile
+{
+    public:
+        MappedFile();
+        ~MappedFile() { Close(); }
+
+        bool Open(char const* filename, bool copyOnWrite = false);
+        void Close();
+
+        bool IsOpen() const { return m_data != nullptr; }
+        uint8* GetData() const { return m_data; }
+        size_t GetSize() const { return m_size; }
+
+    private:
+        MappedFile(MappedFile const&);
+        MappedFile& operator=(MappedFile const&);
+
+        uint8* m_data;
+        size_t m_size;
+#if PLATFORM == PLATFORM_WINDOWS
+        HANDLE m_mapping;
+#endif
+};
+
+#endif
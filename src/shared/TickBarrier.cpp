@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2017 Light's Hope <https://lightshope.org>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "TickBarrier.h"
+
+void TickBarrier::Reset(uint32 participants)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_expected = participants;
+    m_arrived = 0;
+}
+
+uint32 TickBarrier::ArriveAndWait(IdleTask const& idle)
+{
+    std::unique_lock<std::mutex> guard(m_lock);
+    if (++m_arrived >= m_expected)
+    {
+        guard.unlock();
+        m_open.notify_all();
+        return 0;
+    }
+
+    uint32 idleCalls = 0;
+    while (m_arrived < m_expected)
+    {
+        if (!idle)
+        {
+            m_open.wait(guard);
+            continue;
+        }
+
+        guard.unlock();
+        uint32 delay = idle();
+        ++idleCalls;
+        guard.lock();
+
+        if (delay && m_arrived < m_expected)
+            m_open.wait_for(guard, std::chrono::milliseconds(delay));
+    }
+    return idleCalls;
+}
+
+bool TickBarrier::IsOpen()
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    return m_arrived >= m_expected;
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2017 Light's Hope <https://lightshope.org>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _TICK_BARRIER_H
+#define _TICK_BARRIER_H
+
+#include "Platform/Define.h"
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+
+/*
+ * Barrier for threads that must all finish their part of a tick before any
+ * of them can go on. Waiting threads sleep on a condition variable and are
+ * woken as soon as the last participant arrives. An optional idle task lets
+ * a waiting thread do useful work in the meantime.
+ */
+class TickBarrier
+{
+    public:
+        // Runs while waiting. Returns the delay in ms before it wants to be called again.
+        typedef std::function<uint32()> IdleTask;
+
+        TickBarrier() : m_expected(0), m_arrived(0) {}
+
+        // Must not be called while a thread is waiting on the barrier
+        void Reset(uint32 participants);
+
+        // Blocks until every participant arrived. Returns the number of idle task calls.
+        uint32 ArriveAndWait(IdleTask const& idle = nullptr);
+
+        bool IsOpen();
+
+    private:
+        std::mutex m_lock;
+        std::condition_variable m_open;
+        uint32 m_expected;
+        uint32 m_arrived;
+};
+
+#endif
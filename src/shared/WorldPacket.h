@@ -24,6 +24,7 @@
 
 #include "Common.h"
 #include "ByteBuffer.h"
+#include <memory>
 
 // Note: m_opcode and size stored in platfom dependent format
 // ignore endianess until send, and converted at receive
@@ -69,4 +70,9 @@ class WorldPacket : public ByteBuffer
         uint16 m_opcode;
         uint32 m_recvdTime;
 };
+
+// Immutable packet shared by every socket it is queued on (big broadcasts).
+// Each socket writes its own encrypted header before it, then sends the data
+// from this single buffer.
+typedef std::shared_ptr<WorldPacket const> SharedWorldPacket;
 #endif